@@ -30,6 +30,9 @@
   (single-step-button
    (sdl:keyboard-button (key "S")))
 
+  (rewind-button
+   (sdl:keyboard-button (key "Backspace")))
+
   (armageddon-button
    (sdl:keyboard-button (key "A")))
 
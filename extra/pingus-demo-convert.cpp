@@ -0,0 +1,85 @@
+#include <iostream>
+
+#include <argpp/argpp.hpp>
+
+#include "pingus/demo_writer.hpp"
+#include "pingus/pingus_demo.hpp"
+#include "util/pathname.hpp"
+
+using namespace pingus;
+
+int main(int argc, char** argv)
+{
+  argpp::Parser argp;
+  argp.add_usage(argv[0], "[OPTION]... INFILE OUTFILE")
+    .add_text("Convert a demo between the binary and the s-expression format.\n"
+              "The input format is detected automatically, by default the\n"
+              "output is written in the other format.\n")
+    .add_option('h', "help", "", "Show help text")
+    .add_option('b', "binary", "", "Write the binary format")
+    .add_option('t', "text", "", "Write the s-expression format");
+
+  enum { AUTO, BINARY, TEXT } format = AUTO;
+  std::vector<std::string> files;
+
+  for(auto const& opt : argp.parse_args(argc, argv))
+  {
+    switch(opt.key)
+    {
+      case 'h':
+        argp.print_help();
+        return 0;
+
+      case 'b':
+        format = BINARY;
+        break;
+
+      case 't':
+        format = TEXT;
+        break;
+
+      case argpp::ArgumentType::REST:
+        files.push_back(opt.argument);
+        break;
+    }
+  }
+
+  if (files.size() != 2)
+  {
+    argp.print_help();
+    return 1;
+  }
+
+  try
+  {
+    PingusDemo demo(Pathname(files[0], Pathname::SYSTEM_PATH));
+
+    DemoWriter::Format out_format;
+    if (format == AUTO)
+      out_format = demo.is_binary() ? DemoWriter::TEXT : DemoWriter::BINARY;
+    else
+      out_format = (format == BINARY) ? DemoWriter::BINARY : DemoWriter::TEXT;
+
+    DemoWriter writer(files[1], out_format, demo.get_levelname(), demo.get_checksum(), demo.get_seed());
+    if (!writer.is_open())
+    {
+      std::cerr << files[1] << ": couldn't open for writing" << std::endl;
+      return 1;
+    }
+
+    ServerEvent event;
+    while (demo.read_event(event))
+    {
+      writer.write(event);
+    }
+  }
+  catch(std::exception const& err)
+  {
+    std::cerr << files[0] << ": " << err.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
+
+/* EOF */
@@ -0,0 +1,110 @@
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+
+#include <argpp/argpp.hpp>
+
+#include "pingus/path_manager.hpp"
+#include "util/archive.hpp"
+
+using namespace pingus;
+
+int main(int argc, char** argv)
+{
+  argpp::Parser argp;
+  argp.add_usage(argv[0], "[OPTION]... DATADIR [DIRECTORY]...")
+    .add_text("Pack the images, sprite and font descriptions below the given\n"
+              "directories of DATADIR, 'images' by default, into a resource\n"
+              "archive, which is used instead of the loose files at runtime.\n")
+    .add_option('h', "help", "", "Show help text")
+    .add_option('o', "output", "FILE", "Write the archive to FILE instead of DATADIR/resources.pack")
+    .add_option('v', "verbose", "", "Print the packed files");
+
+  std::vector<std::string> args;
+  std::string output;
+  bool verbose = false;
+
+  for(auto const& opt : argp.parse_args(argc, argv))
+  {
+    switch(opt.key)
+    {
+      case 'h':
+        argp.print_help();
+        return 0;
+
+      case 'o':
+        output = opt.argument;
+        break;
+
+      case 'v':
+        verbose = true;
+        break;
+
+      case argpp::ArgumentType::REST:
+        args.push_back(opt.argument);
+        break;
+    }
+  }
+
+  if (args.empty())
+  {
+    argp.print_help();
+    return 1;
+  }
+
+  std::filesystem::path const datadir(args[0]);
+  std::vector<std::string> directories(args.begin() + 1, args.end());
+  if (directories.empty())
+  {
+    directories.push_back("images");
+  }
+
+  if (output.empty())
+  {
+    output = (datadir / PathManager::archive_name).string();
+  }
+
+  std::vector<Archive::File> files;
+  try
+  {
+    for (std::string const& directory : directories)
+    {
+      for (auto const& entry : std::filesystem::recursive_directory_iterator(datadir / directory))
+      {
+        std::string const ext = entry.path().extension().string();
+        if (entry.is_regular_file() &&
+            (ext == ".png" || ext == ".jpg" || ext == ".sprite" || ext == ".font"))
+        {
+          files.push_back(Archive::File{ entry.path().lexically_relative(datadir).generic_string(),
+                                         entry.path().string() });
+        }
+      }
+    }
+
+    std::sort(files.begin(), files.end(),
+              [](Archive::File const& lhs, Archive::File const& rhs) {
+                return lhs.path < rhs.path;
+              });
+
+    if (verbose)
+    {
+      for (Archive::File const& file : files)
+      {
+        std::cout << file.path << std::endl;
+      }
+    }
+
+    Archive::write(output, files);
+  }
+  catch(std::exception const& err)
+  {
+    std::cerr << err.what() << std::endl;
+    return 1;
+  }
+
+  std::cout << output << ": packed " << files.size() << " files" << std::endl;
+
+  return 0;
+}
+
+/* EOF */
@@ -0,0 +1,333 @@
+#include <iostream>
+#include <iomanip>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <thread>
+
+#include <argpp/argpp.hpp>
+#include <logmich/log.hpp>
+
+#include "engine/display/display.hpp"
+#include "engine/display/framebuffer_surface_cache.hpp"
+#include "engine/sound/sound.hpp"
+#include "engine/sound/sound_dummy.hpp"
+#include "pingus/action_name.hpp"
+#include "pingus/globals.hpp"
+#include "pingus/path_manager.hpp"
+#include "pingus/pingu_holder.hpp"
+#include "pingus/pingus_demo.hpp"
+#include "pingus/pingus_level.hpp"
+#include "pingus/resource.hpp"
+#include "pingus/server.hpp"
+#include "pingus/world.hpp"
+#include "pingus/worldobj_factory.hpp"
+#include "util/pathname.hpp"
+#include "util/system.hpp"
+
+using namespace pingus;
+
+namespace {
+
+struct SimResult
+{
+  int ticks = 0;
+  int saved = 0;
+  int killed = 0;
+  int released = 0;
+  int desync = -1;
+  double seconds = 0.0;
+  PinguHolder::ActionProfiles profiles = {};
+  std::string error = {};
+};
+
+/** Run the given level as fast as possible, replaying the events of
+    demo if one is given, stops when the Server is finished, the demo
+    reached its end or max_ticks got exhausted. */
+SimResult simulate(PingusLevel const& plf, PingusDemo* demo, int max_ticks, bool profile)
+{
+  ServerEvent event;
+  bool has_event = false;
+  if (demo)
+  {
+    demo->reset();
+    has_event = demo->read_event(event);
+  }
+
+  auto start = std::chrono::steady_clock::now();
+
+  // plain level runs use a fixed seed so that they are reproducible
+  Server server(plf, false, demo ? demo->get_seed() : 0);
+  SimResult result;
+  bool demo_ended = false;
+
+  server.get_world()->get_pingus()->set_profiling(profile);
+
+  auto send_events = [&]{
+    while (has_event && event.time_stamp <= server.get_time())
+    {
+      if (event.time_stamp < server.get_time())
+      {
+        log_warn("demo event missed its timestamp: {}", event.time_stamp);
+      }
+
+      if (event.type == ServerEvent::END_EVENT)
+      {
+        demo_ended = true;
+      }
+
+      event.send(&server);
+      has_event = demo->read_event(event);
+    }
+  };
+
+  send_events();
+  while (!server.is_finished() && !demo_ended &&
+         (max_ticks <= 0 || result.ticks < max_ticks))
+  {
+    server.update();
+    result.ticks += 1;
+    send_events();
+  }
+
+  PinguHolder* pingus = server.get_world()->get_pingus();
+  result.saved    = pingus->get_number_of_exited();
+  result.killed   = pingus->get_number_of_killed();
+  result.released = pingus->get_number_of_released();
+  result.desync   = server.get_first_desync();
+  result.profiles = pingus->get_action_profiles();
+  result.seconds  = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  return result;
+}
+
+SimResult simulate_file(Pathname const& path, int max_ticks, bool profile)
+{
+  try
+  {
+    if (System::get_file_extension(path.get_raw_path()) == "pingus-demo")
+    {
+      PingusDemo demo(path);
+      PingusLevel plf(Pathname("levels/" + demo.get_levelname() + ".pingus", Pathname::DATA_PATH));
+
+      if (plf.get_checksum() != demo.get_checksum())
+      {
+        log_warn("checksum missmatch between demo ({}) and level ({})",
+                 demo.get_checksum(), plf.get_checksum());
+      }
+
+      return simulate(plf, &demo, max_ticks, profile);
+    }
+    else
+    {
+      PingusLevel plf(path);
+      return simulate(plf, nullptr, max_ticks, profile);
+    }
+  }
+  catch(std::exception const& err)
+  {
+    SimResult result;
+    result.error = err.what();
+    return result;
+  }
+}
+
+/** Simulate all files on a pool of num_jobs threads, each thread
+    picks the next unprocessed file until none are left */
+std::vector<SimResult> simulate_files(std::vector<Pathname> const& files, int max_ticks, int num_jobs, bool profile)
+{
+  std::vector<SimResult> results(files.size());
+  std::atomic<size_t> next_file(0);
+
+  auto worker = [&]{
+    for (size_t i = next_file++; i < files.size(); i = next_file++)
+    {
+      results[i] = simulate_file(files[i], max_ticks, profile);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (int i = 1; i < num_jobs; ++i)
+  {
+    threads.emplace_back(worker);
+  }
+  worker();
+
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  return results;
+}
+
+void print_profiles(PinguHolder::ActionProfiles const& profiles)
+{
+  std::cout << "action        updates     total ms   ns/update" << std::endl;
+  for (size_t i = 0; i < profiles.size(); ++i)
+  {
+    PinguHolder::ActionProfile const& profile = profiles[i];
+    if (profile.updates == 0)
+      continue;
+
+    double const ns = static_cast<double>(profile.time.count());
+    std::cout << std::left << std::setw(12) << ActionName::to_string(static_cast<ActionName::Enum>(i))
+              << std::right << std::setw(9) << profile.updates
+              << std::fixed << std::setprecision(2)
+              << std::setw(13) << ns / 1e6
+              << std::setw(12) << ns / profile.updates
+              << std::defaultfloat << std::endl;
+  }
+}
+
+} // namespace
+
+/** Load levels or demos and simulate them headless on top of the
+    NullFramebuffer, printing tick throughput and the final result,
+    used for regression testing and benchmarking of the game logic */
+int main(int argc, char** argv)
+{
+  std::vector<Pathname> files;
+  int max_ticks = 0;
+  int num_jobs = 1;
+  bool quiet = false;
+  bool profile = false;
+
+  argpp::Parser argp;
+  argp.add_usage(argv[0], "[OPTIONS]... [LEVELFILE|DEMOFILE]...")
+    .add_option('h', "help",    "", "Displays this help")
+    .add_option('t', "max-ticks", "NUM", "Stop the simulation after NUM ticks (default: unlimited)")
+    .add_option('j', "jobs", "NUM", "Simulate NUM files in parallel, 0 uses all cores (default: 1)")
+    .add_option('q', "quiet", "", "Only print the summary line for each file")
+    .add_option('p', "profile", "", "Print the time spent per pingu action");
+
+  for(auto const& opt : argp.parse_args(argc, argv))
+  {
+    switch (opt.key)
+    {
+      case 'h':
+        argp.print_help();
+        exit(EXIT_SUCCESS);
+        break;
+
+      case 't':
+        max_ticks = std::stoi(opt.argument);
+        break;
+
+      case 'j':
+        num_jobs = std::stoi(opt.argument);
+        if (num_jobs <= 0)
+        {
+          num_jobs = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        }
+        break;
+
+      case 'q':
+        quiet = true;
+        break;
+
+      case 'p':
+        profile = true;
+        break;
+
+      case argpp::ArgumentType::REST:
+        files.push_back(Pathname(opt.argument, Pathname::SYSTEM_PATH));
+        break;
+    }
+  }
+
+  if (files.empty())
+  {
+    argp.print_help();
+    exit(EXIT_SUCCESS);
+  }
+
+  globals::sound_enabled = false;
+  globals::music_enabled = false;
+
+  g_path_manager.set_path("data");
+  Resource::init();
+
+  Display::create_window(FramebufferType::NULL_FRAMEBUFFER, geom::isize(640, 480), false, false);
+  pingus::sound::PingusSound::init(std::make_unique<pingus::sound::PingusSoundDummy>());
+
+  // create the factory before the worker threads need it
+  WorldObjFactory::instance();
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<SimResult> results = simulate_files(files, max_ticks, std::min(num_jobs, static_cast<int>(files.size())), profile);
+  double wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  int ret = EXIT_SUCCESS;
+  int total_ticks = 0;
+  PinguHolder::ActionProfiles total_profiles = {};
+
+  for(size_t i = 0; i < files.size(); ++i)
+  {
+    Pathname const& path = files[i];
+    SimResult const& result = results[i];
+
+    if (!result.error.empty())
+    {
+      log_error("{}: exception catched: {}", path.str(), result.error);
+      ret = EXIT_FAILURE;
+      continue;
+    }
+
+    if (result.desync != -1)
+    {
+      log_error("{}: replay diverged from the demo at tick {}", path.str(), result.desync);
+      ret = EXIT_FAILURE;
+    }
+
+    total_ticks += result.ticks;
+    for (size_t j = 0; j < total_profiles.size(); ++j)
+    {
+      total_profiles[j].updates += result.profiles[j].updates;
+      total_profiles[j].time    += result.profiles[j].time;
+    }
+
+    double tps = result.seconds > 0.0 ? result.ticks / result.seconds : 0.0;
+    if (quiet)
+    {
+      std::cout << path << " " << result.ticks << " " << result.saved << " " << result.killed
+                << " " << result.seconds << " " << tps << std::endl;
+    }
+    else
+    {
+      std::cout << "filename      : " << path << std::endl;
+      std::cout << "ticks         : " << result.ticks << std::endl;
+      std::cout << "released      : " << result.released << std::endl;
+      std::cout << "saved         : " << result.saved << std::endl;
+      std::cout << "killed        : " << result.killed << std::endl;
+      std::cout << "wall time     : " << result.seconds << "s" << std::endl;
+      std::cout << "ticks/second  : " << tps << std::endl;
+      std::cout << std::endl;
+    }
+  }
+
+  if (files.size() > 1 && wall_seconds > 0.0)
+  {
+    std::cout << "total: " << total_ticks << " ticks in " << wall_seconds << "s with "
+              << num_jobs << " jobs, " << (total_ticks / wall_seconds) << " ticks/second" << std::endl;
+  }
+
+  if (profile)
+  {
+    print_profiles(total_profiles);
+  }
+
+  if (!quiet)
+  {
+    FramebufferSurfaceCache::Stats stats = Display::get_surface_cache()->get_stats();
+    std::cout << "surface cache: " << stats.hits << " hits, " << stats.misses << " misses, "
+              << stats.evictions << " evictions, " << stats.size << " entries" << std::endl;
+  }
+
+  pingus::sound::PingusSound::deinit();
+  Resource::deinit();
+
+  return ret;
+}
+
+/* EOF */
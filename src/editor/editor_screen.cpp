@@ -37,6 +37,7 @@
 #include "editor/message_box.hpp"
 #include "pingus/fonts.hpp"
 #include "pingus/gettext.h"
+#include "pingus/path_manager.hpp"
 #include "pingus/screens/game_session.hpp"
 
 namespace pingus::editor {
@@ -171,6 +172,9 @@ EditorScreen::save(Pathname const& file)
       log_info("Save to: {}", file.str());
       plf->save_level(filename);
     }
+
+    // the file might be new in the datadir
+    g_path_manager.refresh();
   }
   catch(std::exception const& err)
   {
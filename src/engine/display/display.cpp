@@ -23,6 +23,7 @@
 #include <geom/io.hpp>
 #include <logmich/log.hpp>
 
+#include "engine/display/framebuffer_surface_cache.hpp"
 #include "engine/display/sdl_framebuffer.hpp"
 #include "engine/screen/screen_manager.hpp"
 #include "engine/display/opengl/opengl_framebuffer.hpp"
@@ -31,6 +32,7 @@
 namespace pingus {
 
 std::unique_ptr<Framebuffer> Display::s_framebuffer;
+std::unique_ptr<FramebufferSurfaceCache> Display::s_surface_cache;
 
 void
 Display::flip_display()
@@ -115,6 +117,8 @@ Display::create_window(FramebufferType framebuffer_type, geom::isize const& size
       assert(false && "Unknown framebuffer_type");
       break;
   }
+
+  s_surface_cache = std::make_unique<FramebufferSurfaceCache>();
 }
 
 void
@@ -142,6 +146,12 @@ Display::get_framebuffer()
   return s_framebuffer.get();
 }
 
+FramebufferSurfaceCache*
+Display::get_surface_cache()
+{
+  return s_surface_cache.get();
+}
+
 geom::isize
 Display::find_closest_fullscreen_video_mode(geom::isize const& size)
 {
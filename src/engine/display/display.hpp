@@ -30,12 +30,17 @@ namespace pingus {
 
 class Color;
 class Framebuffer;
+class FramebufferSurfaceCache;
 
 class Display
 {
 private:
   static std::unique_ptr<Framebuffer> s_framebuffer;
 
+  /** Declared after s_framebuffer, so the cached surfaces are
+      released before the framebuffer goes away */
+  static std::unique_ptr<FramebufferSurfaceCache> s_surface_cache;
+
 public:
   static void flip_display();
 
@@ -53,6 +58,9 @@ public:
 
   static Framebuffer* get_framebuffer();
 
+  /** @return the cache for surfaces loaded from image files */
+  static FramebufferSurfaceCache* get_surface_cache();
+
   static geom::isize find_closest_fullscreen_video_mode(geom::isize const& size);
   static std::vector<SDL_DisplayMode> get_fullscreen_video_modes();
 
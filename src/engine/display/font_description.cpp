@@ -59,7 +59,7 @@ FontDescription::FontDescription(Pathname const& pathname_) :
   char_spacing     = 1.0f;
   vertical_spacing = 1.0f;
 
-  auto doc = prio::ReaderDocument::from_file(pathname.get_sys_path());
+  auto doc = read_document(pathname);
 
   if (doc.get_root().get_name() != "pingus-font")
   {
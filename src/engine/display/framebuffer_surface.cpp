@@ -59,6 +59,13 @@ FramebufferSurface::get_size() const
     return geom::isize(0, 0);
 }
 
+void
+FramebufferSurface::update(Surface const& surface, geom::irect const& rect)
+{
+  if (impl.get())
+    impl->update(surface, rect);
+}
+
 FramebufferSurfaceImpl*
 FramebufferSurface::get_impl() const
 {
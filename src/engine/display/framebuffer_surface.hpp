@@ -29,6 +29,10 @@ public:
 
   virtual int get_width()  const =0;
   virtual int get_height() const =0;
+
+  /** Copy rect of surface into the same area of this surface,
+      surface must have the size this surface was created with */
+  virtual void update(Surface const& surface, geom::irect const& rect) =0;
 };
 
 class FramebufferSurface
@@ -42,6 +46,10 @@ public:
   int  get_height() const;
   geom::isize get_size()   const;
 
+  /** Upload rect of surface again, used to update parts of a surface
+      in place instead of creating a new one */
+  void update(Surface const& surface, geom::irect const& rect);
+
   FramebufferSurfaceImpl* get_impl() const;
 
   bool operator==(FramebufferSurface const& other) const;
@@ -0,0 +1,155 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "engine/display/framebuffer_surface_cache.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include <logmich/log.hpp>
+
+#include "engine/display/display.hpp"
+#include "engine/display/framebuffer.hpp"
+
+namespace pingus {
+
+FramebufferSurfaceCache::FramebufferSurfaceCache(size_t max_unused) :
+  m_mutex(),
+  m_entries(),
+  m_max_unused(max_unused),
+  m_clock(0),
+  m_hits(0),
+  m_misses(0),
+  m_evictions(0)
+{
+}
+
+FramebufferSurfaceCache::~FramebufferSurfaceCache()
+{
+  log_debug("surface cache: {} hits, {} misses, {} evictions, {} entries",
+            m_hits, m_misses, m_evictions, m_entries.size());
+}
+
+FramebufferSurface
+FramebufferSurfaceCache::get(Pathname const& filename, ResourceModifier::Enum modifier)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  m_clock += 1;
+
+  auto it = m_entries.find(Key(filename, modifier));
+  if (it != m_entries.end())
+  {
+    m_hits += 1;
+    it->second.last_use = m_clock;
+    return it->second.surface;
+  }
+  else
+  {
+    m_misses += 1;
+    FramebufferSurface surface = load(filename, modifier);
+    m_entries[Key(filename, modifier)] = Entry{surface, m_clock};
+    evict();
+    return surface;
+  }
+}
+
+void
+FramebufferSurfaceCache::cleanup()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  for (auto it = m_entries.begin(); it != m_entries.end();)
+  {
+    if (it->second.surface.use_count() == 1)
+    {
+      m_evictions += 1;
+      it = m_entries.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+}
+
+void
+FramebufferSurfaceCache::clear()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_entries.clear();
+}
+
+FramebufferSurfaceCache::Stats
+FramebufferSurfaceCache::get_stats() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return Stats{m_hits, m_misses, m_evictions, m_entries.size()};
+}
+
+FramebufferSurface
+FramebufferSurfaceCache::load(Pathname const& filename, ResourceModifier::Enum modifier)
+{
+  try
+  {
+    Surface surface(filename);
+    if (modifier != ResourceModifier::ROT0)
+    {
+      surface = surface.mod(modifier);
+    }
+    return Display::get_framebuffer()->create_surface(surface);
+  }
+  catch(std::exception const& err)
+  {
+    // return a dummy surface for cases where the image file can't be found
+    log_error("{}: exception on load: {}", fmt::streamed(filename), err.what());
+    Surface surface(Pathname("images/core/misc/404.png", Pathname::DATA_PATH));
+    return Display::get_framebuffer()->create_surface(surface);
+  }
+}
+
+void
+FramebufferSurfaceCache::evict()
+{
+  // the cache itself holds one reference, so use_count() == 1 means
+  // that no Sprite is using the surface anymore
+  std::vector<std::map<Key, Entry>::iterator> unused;
+  for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+  {
+    if (it->second.surface.use_count() == 1)
+    {
+      unused.push_back(it);
+    }
+  }
+
+  if (unused.size() > m_max_unused)
+  {
+    size_t const count = unused.size() - m_max_unused;
+    std::partial_sort(unused.begin(), unused.begin() + static_cast<std::ptrdiff_t>(count), unused.end(),
+                      [](auto const& lhs, auto const& rhs) {
+                        return lhs->second.last_use < rhs->second.last_use;
+                      });
+    for (size_t i = 0; i < count; ++i)
+    {
+      m_entries.erase(unused[i]);
+      m_evictions += 1;
+    }
+  }
+}
+
+} // namespace pingus
+
+/* EOF */
@@ -0,0 +1,97 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_PINGUS_ENGINE_DISPLAY_FRAMEBUFFER_SURFACE_CACHE_HPP
+#define HEADER_PINGUS_ENGINE_DISPLAY_FRAMEBUFFER_SURFACE_CACHE_HPP
+
+#include <map>
+#include <mutex>
+#include <stdint.h>
+#include <utility>
+
+#include "engine/display/framebuffer_surface.hpp"
+#include "engine/display/resource_modifier.hpp"
+#include "util/pathname.hpp"
+
+namespace pingus {
+
+/** Shares the FramebufferSurfaces created from image files, so that
+    each image gets decoded and uploaded only once, no matter how many
+    Sprites use it. Surfaces that are no longer used by any Sprite are
+    kept around up to max_unused, the least recently used one gets
+    evicted first. */
+class FramebufferSurfaceCache
+{
+public:
+  struct Stats
+  {
+    int hits;
+    int misses;
+    int evictions;
+    size_t size;
+  };
+
+private:
+  struct Entry
+  {
+    FramebufferSurface surface;
+    uint64_t last_use;
+  };
+
+  using Key = std::pair<Pathname, ResourceModifier::Enum>;
+
+  mutable std::mutex m_mutex;
+  std::map<Key, Entry> m_entries;
+  size_t m_max_unused;
+  uint64_t m_clock;
+
+  int m_hits;
+  int m_misses;
+  int m_evictions;
+
+public:
+  FramebufferSurfaceCache(size_t max_unused = 256);
+  ~FramebufferSurfaceCache();
+
+  /** Return the surface for the given image, it gets loaded on the
+      first request, a placeholder is returned if it can't be loaded */
+  FramebufferSurface get(Pathname const& filename, ResourceModifier::Enum modifier);
+
+  /** Drop all surfaces that are not used by any Sprite */
+  void cleanup();
+
+  /** Drop all surfaces, Sprites keep their own reference */
+  void clear();
+
+  Stats get_stats() const;
+
+private:
+  FramebufferSurface load(Pathname const& filename, ResourceModifier::Enum modifier);
+
+  /** Evict unused entries until no more than m_max_unused are left,
+      m_mutex must be held */
+  void evict();
+
+private:
+  FramebufferSurfaceCache(FramebufferSurfaceCache const&);
+  FramebufferSurfaceCache& operator=(FramebufferSurfaceCache const&);
+};
+
+} // namespace pingus
+
+#endif
+
+/* EOF */
@@ -34,6 +34,8 @@ public:
 
   int get_width()  const override { return size.width(); }
   int get_height() const override { return size.height(); }
+
+  void update(Surface const& surface, geom::irect const& rect) override {}
 };
 
 NullFramebuffer::NullFramebuffer() :
@@ -21,13 +21,13 @@
 #endif
 
 #include <SDL.h>
-#include <SDL_image.h>
 #include <sstream>
 #include <stdexcept>
 
 #include <logmich/log.hpp>
 
 #include "engine/display/opengl/opengl_framebuffer_surface_impl.hpp"
+#include "engine/display/surface.hpp"
 #include "util/raise_exception.hpp"
 
 namespace pingus {
@@ -129,7 +129,16 @@ OpenGLFramebuffer::set_video_mode(geom::isize const& size, bool fullscreen, bool
     {
       raise_error("Couldn't set video mode (" << size.width() << "x" << size.height() << "): " << SDL_GetError());
     }
-    SDL_SetWindowIcon(m_window, IMG_Load(Pathname("images/icons/pingus.png", Pathname::DATA_PATH).get_sys_path().c_str()));
+    try
+    {
+      // through Surface, so the icon can come from the resource archive
+      Surface icon(Pathname("images/icons/pingus.png", Pathname::DATA_PATH));
+      SDL_SetWindowIcon(m_window, icon.get_surface());
+    }
+    catch(std::exception const& err)
+    {
+      log_warn("couldn't load window icon: {}", err.what());
+    }
 
     m_glcontext = SDL_GL_CreateContext(m_window);
     if (!m_glcontext)
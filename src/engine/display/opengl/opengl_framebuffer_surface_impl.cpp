@@ -88,6 +88,34 @@ OpenGLFramebufferSurfaceImpl::~OpenGLFramebufferSurfaceImpl()
   glDeleteTextures(1, &m_handle);
 }
 
+void
+OpenGLFramebufferSurfaceImpl::update(Surface const& surface, geom::irect const& rect)
+{
+  // Convert the rect the same way the constructor converts the whole surface
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+  SDL_Surface* convert = SDL_CreateRGBSurface(0, rect.width(), rect.height(), 32,
+                                              0xff000000, 0x00ff0000, 0x0000ff00, 0x000000ff);
+#else
+  SDL_Surface* convert = SDL_CreateRGBSurface(0, rect.width(), rect.height(), 32,
+                                              0x000000ff, 0x0000ff00, 0x00ff0000, 0xff000000);
+#endif
+  SDL_Rect srcrect = { rect.left(), rect.top(), rect.width(), rect.height() };
+  SDL_BlitSurface(surface.get_surface(), &srcrect, convert, nullptr);
+
+  glBindTexture(GL_TEXTURE_2D, m_handle);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  glPixelStorei(GL_UNPACK_ROW_LENGTH, convert->pitch/convert->format->BytesPerPixel);
+
+  SDL_LockSurface(convert);
+  glTexSubImage2D(GL_TEXTURE_2D, 0, rect.left(), rect.top(), rect.width(), rect.height(),
+                  GL_RGBA, GL_UNSIGNED_BYTE, convert->pixels);
+  SDL_UnlockSurface(convert);
+
+  SDL_FreeSurface(convert);
+
+  glBindTexture(GL_TEXTURE_2D, 0);
+}
+
 } // namespace pingus
 
 /* EOF */
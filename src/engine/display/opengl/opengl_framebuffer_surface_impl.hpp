@@ -37,6 +37,8 @@ public:
   int get_width()  const override { return m_size.width();  }
   int get_height() const override { return m_size.height(); }
 
+  void update(Surface const& surface, geom::irect const& rect) override;
+
   GLuint get_handle() const { return m_handle; }
   geom::isize get_texture_size() const { return m_texture_size; }
   geom::isize get_size() const { return m_size; }
@@ -16,12 +16,12 @@
 
 #include "engine/display/sdl_framebuffer.hpp"
 
-#include <SDL_image.h>
 #include <sstream>
 
 #include <logmich/log.hpp>
 
 #include "engine/display/sdl_framebuffer_surface_impl.hpp"
+#include "engine/display/surface.hpp"
 
 namespace pingus {
 
@@ -241,7 +241,16 @@ SDLFramebuffer::set_video_mode(geom::isize const& size, bool fullscreen, bool re
       msg << "Couldn't set video mode (" << size.width() << "x" << size.height() << "): " << SDL_GetError();
       throw std::runtime_error(msg.str());
     }
-    SDL_SetWindowIcon(m_window, IMG_Load(Pathname("images/icons/pingus.png", Pathname::DATA_PATH).get_sys_path().c_str()));
+    try
+    {
+      // through Surface, so the icon can come from the resource archive
+      Surface icon(Pathname("images/icons/pingus.png", Pathname::DATA_PATH));
+      SDL_SetWindowIcon(m_window, icon.get_surface());
+    }
+    catch(std::exception const& err)
+    {
+      log_warn("couldn't load window icon: {}", err.what());
+    }
 
     m_renderer = SDL_CreateRenderer(m_window, -1, SDL_RENDERER_ACCELERATED);
   }
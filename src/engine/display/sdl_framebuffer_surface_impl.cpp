@@ -16,6 +16,10 @@
 
 #include "engine/display/sdl_framebuffer_surface_impl.hpp"
 
+#include <vector>
+
+#include <logmich/log.hpp>
+
 namespace pingus {
 
 SDLFramebufferSurfaceImpl::SDLFramebufferSurfaceImpl(SDL_Renderer* renderer, SDL_Surface* src) :
@@ -30,6 +34,41 @@ SDLFramebufferSurfaceImpl::~SDLFramebufferSurfaceImpl()
   SDL_DestroyTexture(m_texture);
 }
 
+void
+SDLFramebufferSurfaceImpl::update(Surface const& surface, geom::irect const& rect)
+{
+  SDL_Surface* src = surface.get_surface();
+
+  Uint32 format;
+  if (SDL_QueryTexture(m_texture, &format, nullptr, nullptr, nullptr) != 0)
+  {
+    log_error("failed to query texture: {}", SDL_GetError());
+    return;
+  }
+
+  // the texture format can differ from the surface format, so convert
+  // the rect just like SDL_CreateTextureFromSurface() did
+  int const pitch = rect.width() * SDL_BYTESPERPIXEL(format);
+  std::vector<uint8_t> pixels(static_cast<size_t>(pitch * rect.height()));
+
+  SDL_LockSurface(src);
+  uint8_t const* src_pixels = static_cast<uint8_t const*>(src->pixels)
+    + rect.top() * src->pitch + rect.left() * src->format->BytesPerPixel;
+  int const ret = SDL_ConvertPixels(rect.width(), rect.height(),
+                                    src->format->format, src_pixels, src->pitch,
+                                    format, pixels.data(), pitch);
+  SDL_UnlockSurface(src);
+
+  if (ret != 0)
+  {
+    log_error("failed to convert pixels: {}", SDL_GetError());
+    return;
+  }
+
+  SDL_Rect const sdl_rect = { rect.left(), rect.top(), rect.width(), rect.height() };
+  SDL_UpdateTexture(m_texture, &sdl_rect, pixels.data(), pitch);
+}
+
 } // namespace pingus
 
 /* EOF */
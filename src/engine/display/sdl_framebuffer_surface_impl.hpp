@@ -35,6 +35,8 @@ public:
   int get_width()  const override { return m_width; }
   int get_height() const override { return m_height; }
 
+  void update(Surface const& surface, geom::irect const& rect) override;
+
   SDL_Texture* get_texture() const { return m_texture; }
 
 private:
@@ -77,6 +77,13 @@ Sprite::~Sprite()
 {
 }
 
+void
+Sprite::update_surface(Surface const& surface, geom::irect const& rect)
+{
+  if (impl.get())
+    impl->framebuffer_surface.update(surface, rect);
+}
+
 void
 Sprite::render(int x, int y, Framebuffer& fb)
 {
@@ -178,6 +185,28 @@ Sprite::finish()
     impl->finish();
 }
 
+Sprite::State
+Sprite::get_state() const
+{
+  if (impl.get())
+    return State{impl->frame, impl->tick_count, impl->loop, impl->loop_last_cycle, impl->finished};
+  else
+    return State{0, 0, false, false, true};
+}
+
+void
+Sprite::set_state(State const& state)
+{
+  if (impl.get())
+  {
+    impl->frame = state.frame;
+    impl->tick_count = state.tick_count;
+    impl->loop = state.loop;
+    impl->loop_last_cycle = state.loop_last_cycle;
+    impl->finished = state.finished;
+  }
+}
+
 geom::ioffset
 Sprite::get_offset() const
 {
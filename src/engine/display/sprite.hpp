@@ -22,6 +22,7 @@
 
 #include <geom/origin.hpp>
 #include <geom/offset.hpp>
+#include <geom/rect.hpp>
 
 #include "engine/display/resource_modifier.hpp"
 
@@ -37,6 +38,18 @@ class Framebuffer;
 
 class Sprite
 {
+public:
+  /** The animation state, everything that changes while the sprite
+      is played, used to store the sprite in a savestate */
+  struct State
+  {
+    int frame;
+    int tick_count;
+    bool loop;
+    bool loop_last_cycle;
+    bool finished;
+  };
+
 public:
   Sprite();
   Sprite(std::string const& name);
@@ -51,6 +64,11 @@ public:
   void render(int x, int y, Framebuffer& target);
   void update(float delta = 0.033f);
 
+  /** Upload rect of surface into the Sprite in place, only valid for
+      Sprites that got created from surface, as Sprites loaded from
+      files share their surface */
+  void update_surface(Surface const& surface, geom::irect const& rect);
+
   void set_hotspot(geom::origin origin, int x, int y);
   geom::ioffset get_offset() const;
   void set_frame(int i);
@@ -61,6 +79,10 @@ public:
   void set_play_loop(bool loop = true);
   void restart();
   void finish();
+
+  State get_state() const;
+  void set_state(State const& state);
+
   operator bool() const;
 
 private:
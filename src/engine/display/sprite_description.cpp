@@ -26,7 +26,7 @@ namespace pingus {
 SpriteDescriptionPtr
 SpriteDescription::from_file(Pathname const& path)
 {
-  auto doc = prio::ReaderDocument::from_file(path.get_sys_path());
+  auto doc = read_document(path);
   prio::ReaderMapping reader = doc.get_root().get_mapping();
 
   SpriteDescriptionPtr desc(new SpriteDescription);
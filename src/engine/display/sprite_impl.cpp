@@ -16,39 +16,13 @@
 
 #include "engine/display/sprite_impl.hpp"
 
-#include <logmich/log.hpp>
-
 #include "engine/display/display.hpp"
 #include "engine/display/framebuffer.hpp"
+#include "engine/display/framebuffer_surface_cache.hpp"
 #include "engine/display/sprite_description.hpp"
 
 namespace pingus {
 
-namespace {
-
-FramebufferSurface load_framebuffer_surface(Pathname const& filename, ResourceModifier::Enum modifier)
-{
-  // FIXME: Implement proper cache
-  try
-  {
-    Surface surface(filename);
-    if (modifier != ResourceModifier::ROT0)
-    {
-      surface = surface.mod(modifier);
-    }
-    return Display::get_framebuffer()->create_surface(surface);
-  }
-  catch(std::exception const& err)
-  {
-    // return a dummy surface for cases where the image file can't be found
-    log_error("{}: exception on load: {}", fmt::streamed(filename), err.what());
-    Surface surface(Pathname("images/core/misc/404.png", Pathname::DATA_PATH));
-    return Display::get_framebuffer()->create_surface(surface);
-  }
-}
-
-} // namespace
-
 SpriteImpl::SpriteImpl() :
   filename(),
   framebuffer_surface(),
@@ -79,7 +53,7 @@ SpriteImpl::SpriteImpl(SpriteDescription const& desc, ResourceModifier::Enum mod
   frame(0),
   tick_count(0)
 {
-  framebuffer_surface = load_framebuffer_surface(desc.filename, mod);
+  framebuffer_surface = Display::get_surface_cache()->get(desc.filename, mod);
 
   frame_pos = desc.frame_pos;
 
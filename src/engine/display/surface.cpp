@@ -68,7 +68,17 @@ Surface::Surface(std::shared_ptr<SurfaceImpl> impl_) :
 Surface::Surface(Pathname const& pathname) :
   impl()
 {
-  SDL_Surface* surface = IMG_Load(pathname.get_sys_path().c_str());
+  SDL_Surface* surface;
+  std::string_view data;
+  if (pathname.find_in_archive(data))
+  {
+    surface = IMG_Load_RW(SDL_RWFromConstMem(data.data(), static_cast<int>(data.size())), 1);
+  }
+  else
+  {
+    surface = IMG_Load(pathname.get_sys_path().c_str());
+  }
+
   if (!surface)
   {
     throw std::runtime_error(fmt::format("couldn't load {}\n  IMG_GetError: {}",
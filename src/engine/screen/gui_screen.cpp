@@ -122,6 +122,9 @@ GUIScreen::process_button_event (pingus::input::ButtonEvent const& event)
       case SINGLE_STEP_BUTTON:
         on_single_step_press();
         break;
+      case REWIND_BUTTON:
+        on_rewind_press();
+        break;
       case FAST_FORWARD_BUTTON:
         on_fast_forward_press();
         break;
@@ -158,6 +161,9 @@ GUIScreen::process_button_event (pingus::input::ButtonEvent const& event)
       case SINGLE_STEP_BUTTON:
         on_single_step_release();
         break;
+      case REWIND_BUTTON:
+        on_rewind_release();
+        break;
       case FAST_FORWARD_BUTTON:
         on_fast_forward_release();
         break;
@@ -43,6 +43,7 @@ public:
 
   virtual void on_pause_press() {}
   virtual void on_single_step_press() {}
+  virtual void on_rewind_press() {}
   virtual void on_fast_forward_press() {}
   virtual void on_armageddon_press() {}
   virtual void on_escape_press() {}
@@ -51,6 +52,7 @@ public:
 
   virtual void on_pause_release() {}
   virtual void on_single_step_release() {}
+  virtual void on_rewind_release() {}
   virtual void on_fast_forward_release() {}
   virtual void on_armageddon_release() {}
   virtual void on_escape_release() {}
@@ -38,11 +38,16 @@ class MenuButton;
 class PauseButton;
 class Pingu;
 class PinguAction;
+class PinguActionPool;
+class PinguGrid;
 class PinguHolder;
 class PingusCounter;
 class PingusDemo;
 class PingusLevel;
 class Playfield;
+class RewindBuffer;
+class Savestate;
+class SavestateStream;
 class SceneContext;
 class Screen;
 class ScreenManager;
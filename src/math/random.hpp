@@ -0,0 +1,101 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_PINGUS_MATH_RANDOM_HPP
+#define HEADER_PINGUS_MATH_RANDOM_HPP
+
+#include <cassert>
+#include <cstdint>
+#include <random>
+
+namespace pingus {
+
+/** A small seedable pseudo random number generator (PCG32), unlike
+    rand() it has no global state, so every World can own one and
+    produce the same sequence on every platform for a given seed.
+
+    @brief Deterministic random number generator */
+class Random
+{
+private:
+  uint32_t m_seed;
+  uint64_t m_state;
+
+  static constexpr uint64_t multiplier = 6364136223846793005ULL;
+  static constexpr uint64_t increment  = 1442695040888963407ULL;
+
+public:
+  explicit Random(uint32_t seed = 0) :
+    m_seed(),
+    m_state()
+  {
+    set_seed(seed);
+  }
+
+  /** Restart the sequence for the given seed */
+  void set_seed(uint32_t seed)
+  {
+    m_seed = seed;
+    m_state = 0;
+    next();
+    m_state += seed;
+    next();
+  }
+
+  uint32_t get_seed() const { return m_seed; }
+
+  /** The position in the sequence, restoring it with set_state()
+      continues the sequence from there */
+  uint64_t get_state() const { return m_state; }
+  void set_state(uint64_t state) { m_state = state; }
+
+  /** @return the next 32 random bits */
+  uint32_t next()
+  {
+    uint64_t const old_state = m_state;
+    m_state = old_state * multiplier + increment;
+    uint32_t const xorshifted = static_cast<uint32_t>(((old_state >> 18u) ^ old_state) >> 27u);
+    uint32_t const rot = static_cast<uint32_t>(old_state >> 59u);
+    return (xorshifted >> rot) | (xorshifted << ((32u - rot) & 31u));
+  }
+
+  /** @return a random integer in the range [0, range) */
+  int rand(int range)
+  {
+    assert(range > 0);
+    return static_cast<int>((static_cast<uint64_t>(next()) * static_cast<uint64_t>(range)) >> 32);
+  }
+
+  /** @return a random float in the range [0, 1) */
+  float frand()
+  {
+    return static_cast<float>(next() >> 8) * (1.0f / 16777216.0f);
+  }
+
+  /** @return a non-deterministic seed, used for new games which get
+      their seed recorded in the demo file */
+  static uint32_t random_seed()
+  {
+    // keep it in the positive int range so it survives the demo file
+    return std::random_device()() & 0x7fffffffu;
+  }
+};
+
+} // namespace pingus
+
+#endif
+
+/* EOF */
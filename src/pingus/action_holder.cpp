@@ -18,6 +18,7 @@
 
 #include "pingus/globals.hpp"
 #include "pingus/pingus_level.hpp"
+#include "pingus/savestate.hpp"
 
 namespace pingus {
 
@@ -113,6 +114,38 @@ ActionHolder::get_used(ActionName::Enum name)
   }
 }
 
+void
+ActionHolder::sync_state(SavestateStream& stream)
+{
+  uint64_t count = m_actions.size();
+  stream.sync(count);
+
+  if (stream.is_reading())
+  {
+    stream.check_size(count);
+    m_actions.clear();
+    for (uint64_t i = 0; i < count; ++i)
+    {
+      ActionName::Enum name;
+      ActionCount action_count;
+      stream.sync(name);
+      stream.sync(action_count.available);
+      stream.sync(action_count.used);
+      m_actions[name] = action_count;
+    }
+  }
+  else
+  {
+    for (auto& it : m_actions)
+    {
+      ActionName::Enum name = it.first;
+      stream.sync(name);
+      stream.sync(it.second.available);
+      stream.sync(it.second.used);
+    }
+  }
+}
+
 } // namespace pingus
 
 /* EOF */
@@ -26,6 +26,7 @@ namespace pingus {
 
 class PingusLevel;
 class PinguAction;
+class SavestateStream;
 
 /**
  * The ActionHolder is the backend of the ButtonPanel. It is responsible for
@@ -81,6 +82,9 @@ public:
   int get_available(ActionName::Enum name);
   int get_used(ActionName::Enum name);
 
+  /** Store or restore the number of available and used actions */
+  void sync_state(SavestateStream& stream);
+
 private:
   ActionHolder (ActionHolder const&);
   ActionHolder& operator= (ActionHolder const&);
@@ -19,6 +19,7 @@
 #include "engine/display/scene_context.hpp"
 #include "pingus/globals.hpp"
 #include "pingus/pingu.hpp"
+#include "pingus/savestate.hpp"
 
 namespace pingus::actions {
 
@@ -43,6 +44,14 @@ Angel::update()
     pingu->set_status (Pingu::PS_DEAD);
 }
 
+void
+Angel::sync_state(SavestateStream& stream)
+{
+  stream.sync(counter);
+  stream.sync(x_pos);
+  stream.sync(sprite);
+}
+
 void
 Angel::draw (SceneContext& gc)
 {
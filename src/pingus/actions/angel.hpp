@@ -22,7 +22,7 @@
 
 namespace pingus::actions {
 
-class Angel : public PinguAction
+class Angel final : public PinguAction
 {
 private:
   float counter;
@@ -35,6 +35,7 @@ public:
   ActionName::Enum get_type() const override { return ActionName::ANGEL; }
 
   void  update() override;
+  void  sync_state(SavestateStream& stream) override;
   void  draw (SceneContext& gc) override;
 
 private:
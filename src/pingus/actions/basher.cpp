@@ -23,6 +23,7 @@
 #include "pingus/globals.hpp"
 #include "pingus/pingu.hpp"
 #include "pingus/pingu_enums.hpp"
+#include "pingus/savestate.hpp"
 #include "pingus/world.hpp"
 #include "pingus/worldobj.hpp"
 
@@ -107,6 +108,14 @@ Basher::update()
   }
 }
 
+void
+Basher::sync_state(SavestateStream& stream)
+{
+  stream.sync(sprite);
+  stream.sync(basher_c);
+  stream.sync(first_bash);
+}
+
 void
 Basher::bash()
 {
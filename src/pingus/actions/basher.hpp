@@ -23,7 +23,7 @@
 
 namespace pingus::actions {
 
-class Basher : public PinguAction
+class Basher final : public PinguAction
 {
 private:
   StateSprite   sprite;
@@ -54,6 +54,7 @@ public:
 
   void draw (SceneContext& gc) override;
   void update() override;
+  void sync_state(SavestateStream& stream) override;
 
   bool have_something_to_dig();
   bool walk_forward();
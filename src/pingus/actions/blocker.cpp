@@ -19,6 +19,7 @@
 #include "engine/display/scene_context.hpp"
 #include "pingus/pingu.hpp"
 #include "pingus/pingu_holder.hpp"
+#include "pingus/savestate.hpp"
 #include "pingus/world.hpp"
 
 namespace pingus::actions {
@@ -53,16 +54,22 @@ Blocker::update()
   }
   else
   {
-    // FIXME: PinguHolder iterations should be handled otherwise
     PinguHolder* pingus = WorldObj::get_world()->get_pingus();
-    for(PinguIter i = pingus->begin(); i != pingus->end(); ++i)
+    for (Pingu* other : pingus->query_rect(pingu->get_x() - 16, pingu->get_y() - 32,
+                                           pingu->get_x() + 16, pingu->get_y() + 5))
     {
-      catch_pingu(*i);
+      catch_pingu(other);
     }
   }
   sprite.update();
 }
 
+void
+Blocker::sync_state(SavestateStream& stream)
+{
+  stream.sync(sprite);
+}
+
 void
 Blocker::draw (SceneContext& gc)
 {
@@ -18,6 +18,7 @@
 
 #include "engine/display/scene_context.hpp"
 #include "pingus/pingu.hpp"
+#include "pingus/savestate.hpp"
 
 namespace pingus::actions {
 
@@ -76,6 +77,14 @@ Boarder::update()
   }
 }
 
+void
+Boarder::sync_state(SavestateStream& stream)
+{
+  stream.sync(x_pos);
+  stream.sync(speed);
+  stream.sync(sprite);
+}
+
 void
 Boarder::draw (SceneContext& gc)
 {
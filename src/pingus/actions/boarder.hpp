@@ -24,7 +24,7 @@ namespace pingus::actions {
 
 /** The Boarder action causes a pingu to use a skateboard to move
     forward. */
-class Boarder : public PinguAction
+class Boarder final : public PinguAction
 {
 private:
   float x_pos;
@@ -37,6 +37,7 @@ public:
 
   void  draw (SceneContext& gc) override;
   void  update() override;
+  void  sync_state(SavestateStream& stream) override;
 
 private:
   bool on_ground();
@@ -22,6 +22,7 @@
 #include "pingus/particles/pingu_particle_holder.hpp"
 #include "pingus/pingu.hpp"
 #include "pingus/pingu_enums.hpp"
+#include "pingus/savestate.hpp"
 #include "pingus/world.hpp"
 
 namespace pingus::actions {
@@ -112,6 +113,17 @@ Bomber::update()
   }
 }
 
+void
+Bomber::sync_state(SavestateStream& stream)
+{
+  stream.sync(particle_thrown);
+  stream.sync(sound_played);
+  stream.sync(gfx_exploded);
+  stream.sync(colmap_exploded);
+  stream.sync(sprite);
+  stream.sync(explo_surf);
+}
+
 } // namespace pingus::actions
 
 /* EOF */
@@ -25,7 +25,7 @@ namespace pingus::actions {
 
 /** An action with lets the Pingu explode. After the explosion the the
     Pingu leaves a hole inside the ground. */
-class Bomber : public PinguAction
+class Bomber final : public PinguAction
 {
 private:
   bool particle_thrown;
@@ -47,6 +47,7 @@ public:
 
   void draw (SceneContext& gc) override;
   void update() override;
+  void sync_state(SavestateStream& stream) override;
 
 private:
   Bomber (Bomber const&);
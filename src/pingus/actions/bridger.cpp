@@ -22,6 +22,7 @@
 #include "engine/sound/sound.hpp"
 #include "pingus/gettext.h"
 #include "pingus/pingu.hpp"
+#include "pingus/savestate.hpp"
 #include "pingus/world.hpp"
 #include "pingus/worldobj.hpp"
 
@@ -96,6 +97,17 @@ Bridger::update()
   }
 }
 
+void
+Bridger::sync_state(SavestateStream& stream)
+{
+  stream.sync(mode);
+  stream.sync(bricks);
+  stream.sync(block_build);
+  stream.sync(name);
+  stream.sync(walk_sprite);
+  stream.sync(build_sprite);
+}
+
 void
 Bridger::update_walk()
 {
@@ -24,7 +24,7 @@
 
 namespace pingus::actions {
 
-class Bridger : public PinguAction
+class Bridger final : public PinguAction
 {
 private:
   enum Mode { B_WALKING, B_BUILDING } mode;
@@ -51,6 +51,7 @@ public:
   ActionName::Enum get_type() const override { return ActionName::BRIDGER; }
 
   void   update() override;
+  void   sync_state(SavestateStream& stream) override;
   void   update_build();
   void   update_walk();
 
@@ -19,6 +19,7 @@
 #include "engine/display/scene_context.hpp"
 #include "pingus/groundtype.hpp"
 #include "pingus/pingu.hpp"
+#include "pingus/savestate.hpp"
 
 namespace pingus::actions {
 
@@ -92,6 +93,12 @@ Climber::update()
   }
 }
 
+void
+Climber::sync_state(SavestateStream& stream)
+{
+  stream.sync(sprite);
+}
+
 void
 Climber::draw (SceneContext& gc)
 {
@@ -22,7 +22,7 @@
 
 namespace pingus::actions {
 
-class Climber : public PinguAction
+class Climber final : public PinguAction
 {
 private:
   StateSprite sprite;
@@ -37,6 +37,7 @@ public:
   void draw (SceneContext& gc) override;
 
   void update() override;
+  void sync_state(SavestateStream& stream) override;
 
   char get_persistent_char() override { return 'c'; }
   bool change_allowed(ActionName::Enum new_action) override;
@@ -19,6 +19,7 @@
 #include "engine/display/scene_context.hpp"
 #include "engine/sound/sound.hpp"
 #include "pingus/pingu.hpp"
+#include "pingus/savestate.hpp"
 #include "pingus/world.hpp"
 #include "pingus/worldobj.hpp"
 
@@ -60,6 +61,13 @@ Digger::update()
   }
 }
 
+void
+Digger::sync_state(SavestateStream& stream)
+{
+  stream.sync(sprite);
+  stream.sync(delay_count);
+}
+
 bool
 Digger::have_something_to_dig()
 {
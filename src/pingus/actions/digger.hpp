@@ -23,7 +23,7 @@
 
 namespace pingus::actions {
 
-class Digger : public PinguAction
+class Digger final : public PinguAction
 {
 private:
   CollisionMask digger_radius;
@@ -41,6 +41,7 @@ public:
 
   void draw(SceneContext& gc) override;
   void update() override;
+  void sync_state(SavestateStream& stream) override;
 
 private:
   Digger (Digger const&);
@@ -18,6 +18,7 @@
 
 #include "engine/display/scene_context.hpp"
 #include "pingus/pingu.hpp"
+#include "pingus/savestate.hpp"
 
 namespace pingus::actions {
 
@@ -47,6 +48,12 @@ Drown::update()
   }
 }
 
+void
+Drown::sync_state(SavestateStream& stream)
+{
+  stream.sync(sprite);
+}
+
 } // namespace pingus::actions
 
 /* EOF */
@@ -19,6 +19,7 @@
 #include "engine/display/scene_context.hpp"
 #include "engine/sound/sound.hpp"
 #include "pingus/pingu.hpp"
+#include "pingus/savestate.hpp"
 
 namespace pingus::actions {
 
@@ -53,6 +54,13 @@ Exiter::update()
   }
 }
 
+void
+Exiter::sync_state(SavestateStream& stream)
+{
+  stream.sync(sprite);
+  stream.sync(sound_played);
+}
+
 void
 Exiter::draw (SceneContext& gc)
 {
@@ -22,7 +22,7 @@
 
 namespace pingus::actions {
 
-class Exiter : public PinguAction
+class Exiter final : public PinguAction
 {
 private:
   StateSprite sprite;
@@ -35,6 +35,7 @@ public:
 
   void draw (SceneContext& gc) override;
   void update() override;
+  void sync_state(SavestateStream& stream) override;
 
 private:
   Exiter (Exiter const&);
@@ -21,6 +21,7 @@
 #include "pingus/movers/linear_mover.hpp"
 #include "pingus/pingu.hpp"
 #include "pingus/pingu_enums.hpp"
+#include "pingus/savestate.hpp"
 #include "pingus/world.hpp"
 #include "pingus/worldobj.hpp"
 
@@ -138,6 +139,13 @@ Faller::update()
   }
 }
 
+void
+Faller::sync_state(SavestateStream& stream)
+{
+  stream.sync(faller);
+  stream.sync(tumbler);
+}
+
 void
 Faller::draw (SceneContext& gc)
 {
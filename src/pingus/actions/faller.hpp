@@ -22,7 +22,7 @@
 
 namespace pingus::actions {
 
-class Faller : public PinguAction
+class Faller final : public PinguAction
 {
 private:
   StateSprite faller;
@@ -34,6 +34,7 @@ public:
 
   void  draw (SceneContext& gc) override;
   void  update() override;
+  void  sync_state(SavestateStream& stream) override;
 
   bool change_allowed (ActionName::Enum new_action) override;
 
@@ -19,6 +19,7 @@
 #include "engine/display/scene_context.hpp"
 #include "pingus/groundtype.hpp"
 #include "pingus/pingu.hpp"
+#include "pingus/savestate.hpp"
 
 namespace pingus::actions {
 
@@ -53,6 +54,14 @@ Floater::update()
   }
 }
 
+void
+Floater::sync_state(SavestateStream& stream)
+{
+  stream.sync(falling_depth);
+  stream.sync(step);
+  stream.sync(sprite);
+}
+
 void
 Floater::draw (SceneContext& gc)
 {
@@ -22,7 +22,7 @@
 
 namespace pingus::actions {
 
-class Floater : public PinguAction
+class Floater final : public PinguAction
 {
 private:
   int falling_depth;
@@ -38,6 +38,7 @@ public:
 
   void draw (SceneContext& gc) override;
   void update() override;
+  void sync_state(SavestateStream& stream) override;
 
   char get_persistent_char() override { return 'f'; }
   bool change_allowed (ActionName::Enum new_action) override;
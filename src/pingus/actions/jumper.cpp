@@ -18,6 +18,7 @@
 
 #include "engine/display/scene_context.hpp"
 #include "pingus/pingu.hpp"
+#include "pingus/savestate.hpp"
 
 namespace pingus::actions {
 
@@ -59,6 +60,12 @@ Jumper::update()
   pingu->set_action (ActionName::FALLER);
 }
 
+void
+Jumper::sync_state(SavestateStream& stream)
+{
+  stream.sync(sprite);
+}
+
 } // namespace pingus::actions
 
 /* EOF */
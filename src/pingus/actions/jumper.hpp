@@ -22,7 +22,7 @@
 
 namespace pingus::actions {
 
-class Jumper : public PinguAction
+class Jumper final : public PinguAction
 {
 private:
   StateSprite sprite;
@@ -34,6 +34,7 @@ public:
 
   void  draw (SceneContext& gc) override;
   void  update() override;
+  void  sync_state(SavestateStream& stream) override;
 
 private:
   Jumper (Jumper const&);
@@ -18,6 +18,7 @@
 
 #include "engine/display/scene_context.hpp"
 #include "pingus/pingu.hpp"
+#include "pingus/savestate.hpp"
 
 namespace pingus::actions {
 
@@ -44,6 +45,12 @@ LaserKill::update()
     sprite[pingu->direction].update();
 }
 
+void
+LaserKill::sync_state(SavestateStream& stream)
+{
+  stream.sync(sprite);
+}
+
 } // namespace pingus::actions
 
 /* EOF */
@@ -24,7 +24,7 @@ namespace pingus::actions {
 
 /** This action is triggered by the LaserExit trap and causes the
     pingu to 'burn-away' */
-class LaserKill : public PinguAction
+class LaserKill final : public PinguAction
 {
 private:
   StateSprite sprite;
@@ -37,6 +37,7 @@ public:
 
   void draw (SceneContext& gc) override;
   void update() override;
+  void sync_state(SavestateStream& stream) override;
 
   bool catchable() override { return false; }
 
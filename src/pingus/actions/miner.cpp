@@ -21,6 +21,7 @@
 #include "engine/sound/sound.hpp"
 #include "pingus/pingu.hpp"
 #include "pingus/pingu_enums.hpp"
+#include "pingus/savestate.hpp"
 #include "pingus/world.hpp"
 #include "pingus/worldobj.hpp"
 
@@ -79,6 +80,13 @@ Miner::update()
   }
 }
 
+void
+Miner::sync_state(SavestateStream& stream)
+{
+  stream.sync(sprite);
+  stream.sync(delay_count);
+}
+
 void
 Miner::mine(bool final)
 {
@@ -23,7 +23,7 @@
 
 namespace pingus::actions {
 
-class Miner : public PinguAction
+class Miner final : public PinguAction
 {
 private:
   CollisionMask miner_radius;
@@ -41,6 +41,7 @@ public:
 
   void draw (SceneContext& gc) override;
   void update() override;
+  void sync_state(SavestateStream& stream) override;
 
 private:
   void mine(bool final);
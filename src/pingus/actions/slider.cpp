@@ -19,6 +19,7 @@
 #include "engine/display/scene_context.hpp"
 #include "pingus/groundtype.hpp"
 #include "pingus/pingu.hpp"
+#include "pingus/savestate.hpp"
 
 namespace pingus::actions {
 
@@ -68,6 +69,13 @@ Slider::update()
   }
 }
 
+void
+Slider::sync_state(SavestateStream& stream)
+{
+  stream.sync(sprite);
+  stream.sync(speed);
+}
+
 void
 Slider::draw (SceneContext& gc)
 {
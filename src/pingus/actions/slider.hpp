@@ -22,7 +22,7 @@
 
 namespace pingus::actions {
 
-class Slider : public PinguAction
+class Slider final : public PinguAction
 {
 private:
   StateSprite sprite;
@@ -34,6 +34,7 @@ public:
 
   void draw (SceneContext& gc) override;
   void update() override;
+  void sync_state(SavestateStream& stream) override;
 
 private:
   Slider (Slider const&);
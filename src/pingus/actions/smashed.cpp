@@ -18,6 +18,7 @@
 
 #include "engine/display/scene_context.hpp"
 #include "pingus/pingu.hpp"
+#include "pingus/savestate.hpp"
 
 namespace pingus::actions {
 
@@ -44,6 +45,13 @@ Smashed::update()
     pingu->set_status(Pingu::PS_DEAD);
 }
 
+void
+Smashed::sync_state(SavestateStream& stream)
+{
+  stream.sync(sound_played);
+  stream.sync(sprite);
+}
+
 } // namespace pingus::actions
 
 /* EOF */
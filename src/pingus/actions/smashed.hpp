@@ -24,7 +24,7 @@ namespace pingus::actions {
 
 /** FIXME: this action doesn't have a purpose, its pretty much equal
     to the new splashed action */
-class Smashed : public PinguAction
+class Smashed final : public PinguAction
 {
 private:
   bool sound_played;
@@ -37,6 +37,7 @@ public:
 
   void draw (SceneContext& gc) override;
   void update() override;
+  void sync_state(SavestateStream& stream) override;
 
   bool catchable() override { return false; }
 
@@ -18,6 +18,7 @@
 
 #include "engine/display/scene_context.hpp"
 #include "pingus/pingu.hpp"
+#include "pingus/savestate.hpp"
 #include "pingus/world.hpp"
 #include "pingus/worldobj.hpp"
 
@@ -49,6 +50,14 @@ Splashed::update()
   }
 }
 
+void
+Splashed::sync_state(SavestateStream& stream)
+{
+  stream.sync(particle_thrown);
+  stream.sync(sound_played);
+  stream.sync(sprite);
+}
+
 void
 Splashed::draw (SceneContext& gc)
 {
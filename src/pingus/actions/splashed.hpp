@@ -22,7 +22,7 @@
 
 namespace pingus::actions {
 
-class Splashed : public PinguAction
+class Splashed final : public PinguAction
 {
 private:
   bool particle_thrown;
@@ -36,6 +36,7 @@ public:
 
   void draw (SceneContext& gc) override;
   void update() override;
+  void sync_state(SavestateStream& stream) override;
 
   bool catchable() override { return false; }
   bool change_allowed (ActionName::Enum ) override { return false; }
@@ -18,6 +18,7 @@
 
 #include "engine/display/scene_context.hpp"
 #include "pingus/pingu.hpp"
+#include "pingus/savestate.hpp"
 
 namespace pingus::actions {
 
@@ -40,6 +41,14 @@ Superman::update()
     pingu->set_status(Pingu::PS_DEAD);
 }
 
+void
+Superman::sync_state(SavestateStream& stream)
+{
+  stream.sync(counter);
+  stream.sync(x_pos);
+  stream.sync(sprite);
+}
+
 void
 Superman::draw (SceneContext& gc)
 {
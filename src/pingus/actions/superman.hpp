@@ -22,7 +22,7 @@
 
 namespace pingus::actions {
 
-class Superman : public PinguAction
+class Superman final : public PinguAction
 {
 private:
   float counter;
@@ -36,6 +36,7 @@ public:
 
   void draw (SceneContext& gc) override;
   void update() override;
+  void sync_state(SavestateStream& stream) override;
 
 private:
   Superman (Superman const&);
@@ -18,6 +18,7 @@
 
 #include "engine/display/scene_context.hpp"
 #include "pingus/pingu.hpp"
+#include "pingus/savestate.hpp"
 
 namespace pingus::actions {
 
@@ -43,6 +44,13 @@ Waiter::update()
   countdown -= 0.025f;
 }
 
+void
+Waiter::sync_state(SavestateStream& stream)
+{
+  stream.sync(countdown);
+  stream.sync(sprite);
+}
+
 void
 Waiter::draw (SceneContext& gc)
 {
@@ -25,7 +25,7 @@ namespace pingus::actions {
 /** A Waiting action for the bridger, it gets activated when the
     bridger is out of bridges. It then waits two seconds (meanwhile doing a
     funny animation) and then he changes back to a normal walker. */
-class Waiter : public PinguAction
+class Waiter final : public PinguAction
 {
 private:
   float countdown;
@@ -38,6 +38,7 @@ public:
 
   void draw (SceneContext& gc) override;
   void update() override;
+  void sync_state(SavestateStream& stream) override;
 
 private:
   Waiter (Waiter const&);
@@ -16,12 +16,19 @@
 
 #include "pingus/actions/walker.hpp"
 
+#include <array>
+#include <stdint.h>
+
 #include <logmich/log.hpp>
 
 #include "engine/display/scene_context.hpp"
+#include "pingus/collision_map.hpp"
 #include "pingus/globals.hpp"
 #include "pingus/groundtype.hpp"
 #include "pingus/pingu.hpp"
+#include "pingus/savestate.hpp"
+#include "pingus/world.hpp"
+#include "pingus/worldobj.hpp"
 
 namespace pingus::actions {
 
@@ -82,15 +89,14 @@ Walker::update()
   {
     // We search for the nearest ground below the pingu, if we can't
     // find anything within a few pixels, we will turn into a faller
-    bool found_ground = false;
+    CollisionMap const* colmap = WorldObj::get_world()->get_colmap();
+    int const ground_y = colmap->find_nonempty(rel_x(0), rel_y(-2), rel_y(-4) + 1);
+    bool const found_ground = (ground_y <= rel_y(-4));
     int i;
     for (i = -2; i > -5; --i)
     {
-      if (!(rel_getpixel(0, i) == Groundtype::GP_NOTHING))
-      {
-        found_ground = true;
+      if (rel_y(i) == ground_y)
         break;
-      }
     }
 
     if (found_ground)
@@ -125,14 +131,22 @@ Walker::update()
     // if infront is a pixel
     // Pingu is walking up the mountain
     // we can continue walking up. search for the correct y_pos
+    // fetch the scanned part of the column in front of the pingu at
+    // once, from rel_y(max_steps) down to rel_y(-max_steps - 1)
+    std::array<uint8_t, 2 * max_steps + 2> front;
+    int const front_top = rel_y(max_steps);
+    WorldObj::get_world()->get_colmap()->get_column(rel_x(1), front_top, rel_y(-max_steps - 1) + 1,
+                                                    front.data());
+    auto front_pixel = [&](int y) -> int { return front[static_cast<size_t>(rel_y(y) - front_top)]; };
+
     int y_inc = 0;
     int possible_y_step = 0;
     bool found_next_step = false;
     for (y_inc = -max_steps; y_inc <= max_steps; ++y_inc)
     {// up/down-hill scan
-      if ((  rel_getpixel(1, y_inc)     == Groundtype::GP_NOTHING
-             || rel_getpixel(1, y_inc)     == Groundtype::GP_BRIDGE) // FIXME: This causes a rather huge step
-          && rel_getpixel(1, y_inc - 1) != Groundtype::GP_NOTHING)
+      if ((  front_pixel(y_inc)     == Groundtype::GP_NOTHING
+             || front_pixel(y_inc)     == Groundtype::GP_BRIDGE) // FIXME: This causes a rather huge step
+          && front_pixel(y_inc - 1) != Groundtype::GP_NOTHING)
       { // FIXME:
         found_next_step = true;
         possible_y_step = y_inc;
@@ -203,6 +217,13 @@ Walker::update()
   */
 }
 
+void
+Walker::sync_state(SavestateStream& stream)
+{
+  stream.sync(walker);
+  stream.sync(floaterlayer);
+}
+
 void
 Walker::draw (SceneContext& gc)
 {
@@ -22,7 +22,7 @@
 
 namespace pingus::actions {
 
-class Walker : public PinguAction
+class Walker final : public PinguAction
 {
 private:
   StateSprite walker;
@@ -35,6 +35,7 @@ public:
 
   void draw (SceneContext& gc) override;
   void update() override;
+  void sync_state(SavestateStream& stream) override;
 
   ActionName::Enum get_type() const override { return ActionName::WALKER; }
 
@@ -69,6 +69,7 @@ input::ControllerDescription pingus_controller_description()
   desc.add_button("armageddon-button",   ARMAGEDDON_BUTTON);
   desc.add_button("pause-button",        PAUSE_BUTTON);
   desc.add_button("single-step-button",  SINGLE_STEP_BUTTON);
+  desc.add_button("rewind-button",       REWIND_BUTTON);
   desc.add_button("escape-button",       ESCAPE_BUTTON);
 
   desc.add_button("action-up-button",    ACTION_UP_BUTTON);
@@ -17,7 +17,9 @@
 #include "pingus/colliders/pingu_collider.hpp"
 
 #include "math/vector2f.hpp"
+#include "pingus/collision_map.hpp"
 #include "pingus/groundtype.hpp"
+#include "pingus/world.hpp"
 
 namespace pingus::colliders {
 
@@ -45,20 +47,23 @@ bool PinguCollider::operator() (World const* world, Vector2f const& current_pos,
   {
     float top_of_pingu = new_pos.y - static_cast<float>(height);
 
-    for (; new_pos.y >= top_of_pingu; --new_pos.y)
+    // The rows from the feet up to the head. Stepping down from the
+    // feet in whole pixels ends exactly at top_of_pingu, except close
+    // to the top border where the float steps get inexact, so follow
+    // them one by one there.
+    int const feet_row = static_cast<int>(new_pos.y);
+    int head_row = static_cast<int>(top_of_pingu);
+    if (top_of_pingu < 1.0f)
     {
-      pixel = getpixel(world, Vector2f(new_pos));
-
-      // If there is something in the way, then Pingu has collided with
-      // something.  However, if not falling and colliding with a
-      // Bridge, allow Pingu to go through it.
-      if (pixel != Groundtype::GP_NOTHING
-          && !(pixel == Groundtype::GP_BRIDGE && !falling))
-      {
-        collided = true;
-        break;
-      }
+      for (float y = new_pos.y; y >= top_of_pingu; --y)
+        head_row = static_cast<int>(y);
     }
+
+    // If there is something in the way, then Pingu has collided with
+    // something.  However, if not falling and colliding with a
+    // Bridge, allow Pingu to go through it.
+    collided = !world->get_colmap()->is_clear(static_cast<int>(new_pos.x), head_row, feet_row + 1,
+                                              falling ? Groundtype::GP_NOTHING : Groundtype::GP_BRIDGE);
   }
   // If the Pingu is not falling...
   else if (!falling)
@@ -16,22 +16,121 @@
 
 #include "pingus/collision_map.hpp"
 
+#include <algorithm>
+#include <string.h>
+#include <utility>
+
+#ifdef __SSE2__
+#  include <emmintrin.h>
+#endif
+
 #include "engine/display/drawing_context.hpp"
 #include "engine/display/sprite.hpp"
 #include "pingus/collision_mask.hpp"
+#include "pingus/savestate.hpp"
+#include "util/raise_exception.hpp"
 
 namespace pingus {
 
+namespace {
+
+/** Turn every pixel of the span that isn't GP_SOLID into GP_NOTHING */
+void remove_pixels(uint8_t* p, int len)
+{
+  int i = 0;
+#ifdef __SSE2__
+  __m128i const solid   = _mm_set1_epi8(Groundtype::GP_SOLID);
+  __m128i const nothing = _mm_set1_epi8(Groundtype::GP_NOTHING);
+  for (; i + 16 <= len; i += 16)
+  {
+    __m128i const v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p + i));
+    __m128i const is_solid = _mm_cmpeq_epi8(v, solid);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p + i),
+                     _mm_or_si128(_mm_and_si128(is_solid, v),
+                                  _mm_andnot_si128(is_solid, nothing)));
+  }
+#endif
+  for (; i < len; ++i)
+  {
+    if (p[i] != Groundtype::GP_SOLID)
+      p[i] = Groundtype::GP_NOTHING;
+  }
+}
+
+/** Set every GP_NOTHING pixel of the span to value, leave the rest alone */
+void fill_empty_span(uint8_t* p, int len, Groundtype::GPType value)
+{
+  int i = 0;
+#ifdef __SSE2__
+  __m128i const nothing = _mm_set1_epi8(Groundtype::GP_NOTHING);
+  __m128i const fill    = _mm_set1_epi8(static_cast<char>(value));
+  for (; i + 16 <= len; i += 16)
+  {
+    __m128i const v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p + i));
+    __m128i const is_empty = _mm_cmpeq_epi8(v, nothing);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p + i),
+                     _mm_or_si128(_mm_and_si128(is_empty, fill),
+                                  _mm_andnot_si128(is_empty, v)));
+  }
+#endif
+  for (; i < len; ++i)
+  {
+    if (p[i] == Groundtype::GP_NOTHING)
+      p[i] = static_cast<uint8_t>(value);
+  }
+}
+
+/** splitmix64 finalizer, spreads every input bit over the result */
+uint64_t mix(uint64_t value)
+{
+  value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+  value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+  return value ^ (value >> 31);
+}
+
+uint64_t hash_spans(int x, std::vector<CollisionMap::ColumnSpan> const& spans)
+{
+  // the column is part of the hash, so that equal columns at
+  // different places don't cancel each other out
+  uint64_t h = mix(static_cast<uint64_t>(x) + 1);
+  for (CollisionMap::ColumnSpan const& span : spans)
+  {
+    h = mix(h ^ (static_cast<uint64_t>(span.y) |
+                 static_cast<uint64_t>(span.len) << 24 |
+                 static_cast<uint64_t>(span.type) << 48));
+  }
+  return h;
+}
+
+} // namespace
+
 CollisionMap::CollisionMap(int w, int h) :
   serial(0),
+  batching(false),
+  batch_changed(false),
+  changes(),
   width(w),
   height(h),
   colmap(new unsigned char[static_cast<size_t>(width * height)]),
+  columns(static_cast<size_t>(width)),
+  column_hashes(static_cast<size_t>(width)),
+  hash(0),
+  column_scratch(),
+  journaling(false),
+  journal_generation(0),
+  journal_marks(),
+  journal(),
   m_colmap_sprite(),
   m_colmap_sprite_serial()
 {
   // Clear the colmap
   memset(colmap.get(), Groundtype::GP_NOTHING, sizeof(unsigned char) * static_cast<size_t>(width * height));
+
+  for (int x = 0; x < width; ++x)
+  {
+    column_hashes[static_cast<size_t>(x)] = hash_spans(x, columns[static_cast<size_t>(x)]);
+    hash ^= column_hashes[static_cast<size_t>(x)];
+  }
 }
 
 CollisionMap::~CollisionMap()
@@ -75,11 +174,8 @@ CollisionMap::get_width() const
 void
 CollisionMap::remove(CollisionMask const& mask, int x_pos, int y_pos)
 {
-  ++serial;
-
   int swidth  = mask.get_width();
   int sheight = mask.get_height();
-  uint8_t* buffer = mask.get_data();
 
   int start_x = std::max(0, -x_pos);
   int start_y = std::max(0, -y_pos);
@@ -88,27 +184,116 @@ CollisionMap::remove(CollisionMask const& mask, int x_pos, int y_pos)
 
   for (int y = start_y; y < end_y; ++y)
   {
-    for (int x = start_x; x < end_x; ++x)
+    uint8_t* row = colmap.get() + (y + y_pos) * width;
+    for (CollisionMask::Span const& span : mask.get_spans(y))
     {
-      if (buffer[y*swidth + x])
+      int const span_start = std::max(span.x, start_x);
+      int const span_end   = std::min(span.x + span.len, end_x);
+      if (span_start < span_end)
       {
-        uint8_t& pixel = colmap[(y+y_pos)*width + (x+x_pos)];
-        if (pixel != Groundtype::GP_SOLID)
-          pixel = Groundtype::GP_NOTHING;
+        remove_pixels(row + x_pos + span_start, span_end - span_start);
       }
     }
   }
+
+  touch(x_pos + start_x, y_pos + start_y, x_pos + end_x, y_pos + end_y);
 }
 
 void
-CollisionMap::put(int x, int y, Groundtype::GPType p)
+CollisionMap::remove_span(int x, int y, int len)
+{
+  remove_pixels(colmap.get() + y * width + x, len);
+}
+
+void
+CollisionMap::touch(int x1, int y1, int x2, int y2)
 {
-  ++serial; // FIXME: Shouldn't be here but at a more heigher level function
+  changed(Rect(x1, y1, x2, y2));
+  update_columns(x1, y1, x2, y2);
+}
+
+void
+CollisionMap::begin_batch()
+{
+  batching = true;
+}
+
+void
+CollisionMap::end_batch()
+{
+  batching = false;
+  if (batch_changed)
+  {
+    batch_changed = false;
+    ++serial;
+  }
+}
+
+std::vector<Rect>
+CollisionMap::take_changes()
+{
+  return std::exchange(changes, {});
+}
+
+void
+CollisionMap::changed(Rect const& area)
+{
+  if (batching)
+    batch_changed = true;
+  else
+    ++serial;
 
+  if (area.width() <= 0 || area.height() <= 0)
+    return;
+
+  // swallow every area that overlaps or touches the new one, the
+  // grown area might now reach further ones, so start over
+  Rect merged = area;
+  for (size_t i = 0; i < changes.size();)
+  {
+    Rect const& other = changes[i];
+    if (other.left() <= merged.right() && merged.left() <= other.right() &&
+        other.top() <= merged.bottom() && merged.top() <= other.bottom())
+    {
+      merged = Rect(std::min(merged.left(),   other.left()),
+                    std::min(merged.top(),    other.top()),
+                    std::max(merged.right(),  other.right()),
+                    std::max(merged.bottom(), other.bottom()));
+      changes.erase(changes.begin() + static_cast<std::ptrdiff_t>(i));
+      i = 0;
+    }
+    else
+    {
+      ++i;
+    }
+  }
+  changes.push_back(merged);
+
+  // nobody took the changes for a while, a single bounding box is
+  // good enough then
+  if (changes.size() > 64)
+  {
+    Rect bounds = changes.front();
+    for (Rect const& other : changes)
+    {
+      bounds = Rect(std::min(bounds.left(),   other.left()),
+                    std::min(bounds.top(),    other.top()),
+                    std::max(bounds.right(),  other.right()),
+                    std::max(bounds.bottom(), other.bottom()));
+    }
+    changes.assign(1, bounds);
+  }
+}
+
+void
+CollisionMap::put(int x, int y, Groundtype::GPType p)
+{
   if (x >= 0 && x < width
       && y >= 0 && y < height)
   {
     colmap[x+y*width] = p;
+    changed(Rect(x, y, x + 1, y + 1));
+    update_column(x, y, y + 1);
   }
 }
 
@@ -135,20 +320,239 @@ CollisionMap::put(CollisionMask const& mask, int sur_x, int sur_y, Groundtype::G
   if (pixel == Groundtype::GP_TRANSPARENT)
     return;
 
-  if ((sur_x > width) || (sur_y > height))
+  int start_x = std::max(0, -sur_x);
+  int start_y = std::max(0, -sur_y);
+  int end_x   = std::min(mask.get_width(),  width  - sur_x);
+  int end_y   = std::min(mask.get_height(), height - sur_y);
+
+  for (int y = start_y; y < end_y; ++y)
+  {
+    uint8_t* row = colmap.get() + (y + sur_y) * width;
+    for (CollisionMask::Span const& span : mask.get_spans(y))
+    {
+      int const span_start = std::max(span.x, start_x);
+      int const span_end   = std::min(span.x + span.len, end_x);
+      if (span_start < span_end)
+      {
+        if (pixel == Groundtype::GP_BRIDGE)
+        {
+          // bridges are only allowed to fill empty space, see blit_allowed()
+          fill_empty_span(row + sur_x + span_start, span_end - span_start, Groundtype::GP_BRIDGE);
+        }
+        else
+        {
+          memset(row + sur_x + span_start, pixel, static_cast<size_t>(span_end - span_start));
+        }
+      }
+    }
+  }
+
+  touch(sur_x + start_x, sur_y + start_y, sur_x + end_x, sur_y + end_y);
+}
+
+void
+CollisionMap::fill_rect(Rect const& rect, Groundtype::GPType pixel)
+{
+  int const x1 = std::max(0, rect.left());
+  int const y1 = std::max(0, rect.top());
+  int const x2 = std::min(width,  rect.right());
+  int const y2 = std::min(height, rect.bottom());
+
+  if (x1 >= x2)
+    return;
+
+  for (int y = y1; y < y2; ++y)
+  {
+    memset(colmap.get() + y * width + x1, pixel, static_cast<size_t>(x2 - x1));
+  }
+
+  touch(x1, y1, x2, y2);
+}
+
+void
+CollisionMap::update_columns(int x1, int y1, int x2, int y2)
+{
+  if (x1 >= x2 || y1 >= y2)
+    return;
+
+  for (int x = x1; x < x2; ++x)
+  {
+    update_column(x, y1, y2);
+  }
+}
+
+void
+CollisionMap::update_column(int x, int y1, int y2)
+{
+  std::vector<ColumnSpan>& spans = columns[static_cast<size_t>(x)];
+
+  // the spans still describe the column before the change
+  if (journaling && journal_marks[static_cast<size_t>(x)] != journal_generation)
+  {
+    journal_marks[static_cast<size_t>(x)] = journal_generation;
+    journal.push_back(ColumnDelta{x, spans});
+  }
+
+  // spans touching the changed range are rescanned as a whole, as
+  // they might have to be split or merged
+  auto first = std::partition_point(spans.begin(), spans.end(),
+                                    [y1](ColumnSpan const& span) { return span.y + span.len < y1; });
+  auto last = first;
+  while (last != spans.end() && last->y <= y2)
+    ++last;
+
+  if (first != last)
+  {
+    y1 = std::min(y1, first->y);
+    y2 = std::max(y2, (last - 1)->y + (last - 1)->len);
+  }
+
+  column_scratch.clear();
+  uint8_t const* pixel = colmap.get() + y1 * width + x;
+  for (int y = y1; y < y2; ++y, pixel += width)
+  {
+    if (*pixel == Groundtype::GP_NOTHING)
+      continue;
+
+    if (!column_scratch.empty() &&
+        column_scratch.back().type == *pixel &&
+        column_scratch.back().y + column_scratch.back().len == y)
+    {
+      column_scratch.back().len += 1;
+    }
+    else
+    {
+      column_scratch.push_back(ColumnSpan{y, 1, *pixel});
+    }
+  }
+
+  auto const begin = spans.erase(first, last);
+  size_t const i = static_cast<size_t>(begin - spans.begin());
+  spans.insert(begin, column_scratch.begin(), column_scratch.end());
+  size_t const j = i + column_scratch.size();
+
+  // the spans right outside of the rescanned range might now continue
+  // the new spans, right side first, so that i stays valid
+  auto merge = [&spans](size_t k) {
+    if (k > 0 && k < spans.size() &&
+        spans[k - 1].type == spans[k].type &&
+        spans[k - 1].y + spans[k - 1].len == spans[k].y)
+    {
+      spans[k - 1].len += spans[k].len;
+      spans.erase(spans.begin() + static_cast<std::ptrdiff_t>(k));
+    }
+  };
+  merge(j);
+  merge(i);
+
+  rehash_column(x);
+}
+
+void
+CollisionMap::rehash_column(int x)
+{
+  uint64_t& column_hash = column_hashes[static_cast<size_t>(x)];
+  hash ^= column_hash;
+  column_hash = hash_spans(x, columns[static_cast<size_t>(x)]);
+  hash ^= column_hash;
+}
+
+int
+CollisionMap::find_nonempty(int x, int y1, int y2) const
+{
+  if (y1 >= y2)
+    return y2;
+
+  if (x < 0 || x >= width || y1 < 0)
+    return y1;
+
+  std::vector<ColumnSpan> const& spans = columns[static_cast<size_t>(x)];
+  auto it = std::partition_point(spans.begin(), spans.end(),
+                                 [y1](ColumnSpan const& span) { return span.y + span.len <= y1; });
+
+  // everything from height on is out of screen
+  int const y = (it != spans.end()) ? std::max(it->y, y1) : height;
+  return std::min(std::min(y, height), y2);
+}
+
+bool
+CollisionMap::is_clear(int x, int y1, int y2, Groundtype::GPType ignore) const
+{
+  if (y1 >= y2)
+    return true;
+
+  if (x < 0 || x >= width || y1 < 0 || y2 > height)
+    return false;
+
+  std::vector<ColumnSpan> const& spans = columns[static_cast<size_t>(x)];
+  for (auto it = std::partition_point(spans.begin(), spans.end(),
+                                      [y1](ColumnSpan const& span) { return span.y + span.len <= y1; });
+       it != spans.end() && it->y < y2; ++it)
+  {
+    if (it->type != ignore)
+      return false;
+  }
+
+  return true;
+}
+
+void
+CollisionMap::get_column(int x, int y1, int y2, uint8_t* out) const
+{
+  if (y1 >= y2)
+    return;
+
+  if (x < 0 || x >= width)
   {
+    memset(out, Groundtype::GP_OUTOFSCREEN, static_cast<size_t>(y2 - y1));
     return;
   }
 
-  // FIXME: This could be speed up quite a bit
-  uint8_t* source = mask.get_data();
-  for (int y = 0; y < mask.get_height(); ++y)
-    for (int x = 0; x < mask.get_width(); ++x)
+  int const inner_y1 = std::clamp(y1, 0, height);
+  int const inner_y2 = std::clamp(y2, inner_y1, height);
+
+  memset(out, Groundtype::GP_OUTOFSCREEN, static_cast<size_t>(inner_y1 - y1));
+  memset(out + (inner_y1 - y1), Groundtype::GP_NOTHING, static_cast<size_t>(inner_y2 - inner_y1));
+  memset(out + (inner_y2 - y1), Groundtype::GP_OUTOFSCREEN, static_cast<size_t>(y2 - inner_y2));
+
+  std::vector<ColumnSpan> const& spans = columns[static_cast<size_t>(x)];
+  for (auto it = std::partition_point(spans.begin(), spans.end(),
+                                      [inner_y1](ColumnSpan const& span) { return span.y + span.len <= inner_y1; });
+       it != spans.end() && it->y < inner_y2; ++it)
+  {
+    int const start = std::max(it->y, inner_y1);
+    int const end   = std::min(it->y + it->len, inner_y2);
+    memset(out + (start - y1), it->type, static_cast<size_t>(end - start));
+  }
+}
+
+CollisionMap::RayHit
+CollisionMap::raycast(glm::vec2 pos, glm::vec2 const& step, int steps) const
+{
+  for (int i = 0; i < steps; ++i)
+  {
+    int const x = static_cast<int>(pos.x);
+    int const y = static_cast<int>(pos.y);
+
+    int const pixel = (x >= 0 && x < width && y >= 0 && y < height)
+      ? colmap[static_cast<size_t>(y * width + x)]
+      : static_cast<int>(Groundtype::GP_OUTOFSCREEN);
+
+    if (pixel != Groundtype::GP_NOTHING)
     {
-      if (source[y * mask.get_width() + x])
-        if (blit_allowed(x + sur_x, y + sur_y, pixel))
-          put(x + sur_x, y + sur_y, pixel);
+      return RayHit{i, pixel, pos};
     }
+
+    pos += step;
+  }
+
+  return RayHit{steps, Groundtype::GP_NOTHING, pos};
+}
+
+std::span<CollisionMap::ColumnSpan const>
+CollisionMap::get_column_spans(int x) const
+{
+  return columns[static_cast<size_t>(x)];
 }
 
 void
@@ -212,6 +616,107 @@ CollisionMap::draw(DrawingContext& gc)
   gc.draw(m_colmap_sprite, geom::ipoint(0, 0), 1000);
 }
 
+void
+CollisionMap::sync_state(SavestateStream& stream)
+{
+  for (int x = 0; x < width; ++x)
+  {
+    std::vector<ColumnSpan>& spans = columns[static_cast<size_t>(x)];
+    stream.sync_size(spans);
+    for (ColumnSpan& span : spans)
+    {
+      stream.sync(span.y);
+      stream.sync(span.len);
+      stream.sync(span.type);
+
+      if (span.y < 0 || span.len <= 0 || span.len > height - span.y)
+      {
+        raise_exception(std::runtime_error, "span out of range in column " << x);
+      }
+    }
+  }
+
+  if (stream.is_reading())
+  {
+    memset(colmap.get(), Groundtype::GP_NOTHING, static_cast<size_t>(width * height));
+    for (int x = 0; x < width; ++x)
+    {
+      for (ColumnSpan const& span : columns[static_cast<size_t>(x)])
+      {
+        uint8_t* pixel = colmap.get() + span.y * width + x;
+        for (int i = 0; i < span.len; ++i, pixel += width)
+        {
+          *pixel = span.type;
+        }
+      }
+      rehash_column(x);
+    }
+
+    changed(Rect(0, 0, width, height));
+  }
+}
+
+void
+CollisionMap::start_journal()
+{
+  if (!journaling)
+  {
+    journaling = true;
+    journal_marks.assign(static_cast<size_t>(width), journal_generation);
+    ++journal_generation;
+  }
+}
+
+std::vector<CollisionMap::ColumnDelta>
+CollisionMap::take_journal()
+{
+  ++journal_generation;
+  if (journal_generation == 0)
+  {
+    // wrapped around, old marks could match again
+    std::fill(journal_marks.begin(), journal_marks.end(), 0);
+    journal_generation = 1;
+  }
+
+  return std::exchange(journal, {});
+}
+
+void
+CollisionMap::undo(std::vector<ColumnDelta> const& delta)
+{
+  int x1 = width;
+  int x2 = 0;
+
+  for (ColumnDelta const& column : delta)
+  {
+    if (column.x < 0 || column.x >= width)
+      continue;
+
+    uint8_t* pixel = colmap.get() + column.x;
+    for (int y = 0; y < height; ++y, pixel += width)
+    {
+      *pixel = Groundtype::GP_NOTHING;
+    }
+
+    for (ColumnSpan const& span : column.spans)
+    {
+      pixel = colmap.get() + span.y * width + column.x;
+      for (int i = 0; i < span.len; ++i, pixel += width)
+      {
+        *pixel = span.type;
+      }
+    }
+
+    columns[static_cast<size_t>(column.x)] = column.spans;
+    rehash_column(column.x);
+
+    x1 = std::min(x1, column.x);
+    x2 = std::max(x2, column.x + 1);
+  }
+
+  changed(Rect(x1, 0, x2, height));
+}
+
 unsigned
 CollisionMap::get_serial() const
 {
@@ -18,13 +18,19 @@
 #define HEADER_PINGUS_PINGUS_COLLISION_MAP_HPP
 
 #include <memory>
+#include <span>
+#include <stdint.h>
+#include <vector>
+#include <glm/glm.hpp>
 
 #include "engine/display/sprite.hpp"
+#include "math/rect.hpp"
 #include "pingus/groundtype.hpp"
 
 namespace pingus {
 
 class CollisionMask;
+class SavestateStream;
 
 class DrawingContext;
 class ResDescriptor;
@@ -35,11 +41,52 @@ class PixelStatus;
     can contain lava or water, it can be solid and many more. */
 class CollisionMap
 {
+public:
+  /** A vertical run of pixels of the same type in a column */
+  struct ColumnSpan
+  {
+    int y;
+    int len;
+    uint8_t type;
+  };
+
+  /** The spans a column had before it got changed, see take_journal() */
+  struct ColumnDelta
+  {
+    int x;
+    std::vector<ColumnSpan> spans;
+  };
+
+  /** The result of raycast() */
+  struct RayHit
+  {
+    /** The number of steps taken before the hit, equal to the
+        requested steps if nothing was hit */
+    int steps;
+
+    /** The type of the pixel that was hit, GP_NOTHING if none */
+    int type;
+
+    /** The position of the hit, or the end of the ray */
+    glm::vec2 pos;
+  };
+
 private:
   /** The serial number indicates the state of the colmap, on every
-      change of the colmap it will get increased. */
+      change of the colmap it will get increased, during a batch only
+      once at its end. */
   unsigned int serial;
 
+  /** Set between begin_batch() and end_batch() */
+  bool batching;
+
+  /** Set when the colmap got changed during the current batch */
+  bool batch_changed;
+
+  /** The areas changed since the last take_changes(), merged where
+      they overlap */
+  std::vector<Rect> changes;
+
   /** The width of the collision map. */
   int    width;
 
@@ -49,6 +96,32 @@ private:
   /** A array of uchar, each uchar represents a pixel on the map. */
   std::unique_ptr<uint8_t[]> colmap;
 
+  /** The runs of non-empty pixels of each column, sorted by y and
+      merged where neighbours have the same type. Every function that
+      writes to colmap updates the columns it touched. */
+  std::vector<std::vector<ColumnSpan> > columns;
+
+  /** Hash of the spans of each column */
+  std::vector<uint64_t> column_hashes;
+
+  /** The xor of all column_hashes, kept up to date on every change */
+  uint64_t hash;
+
+  /** Scratch space for update_column() */
+  std::vector<ColumnSpan> column_scratch;
+
+  /** Set by start_journal() */
+  bool journaling;
+
+  /** Columns whose mark equals the generation are already in the
+      journal, bumping the generation empties it in O(1) */
+  uint32_t journal_generation;
+  std::vector<uint32_t> journal_marks;
+
+  /** The previous spans of every column changed since the last
+      take_journal() */
+  std::vector<ColumnDelta> journal;
+
   Sprite m_colmap_sprite;
   unsigned int m_colmap_sprite_serial;
 
@@ -61,7 +134,9 @@ public:
   ~CollisionMap();
 
   /** Returns the raw uchar array used for the inner representation of
-      the colmap. This is used by the smallmap to create the radar  */
+      the colmap. This is used by the smallmap to create the radar,
+      it must not be written to, as that would bypass the column
+      index */
   unsigned char* get_data();
 
   /** Returns the height of the collision map. */
@@ -75,22 +150,106 @@ public:
   /** Same as getpixel() but without the range check */
   int  getpixel_fast(int x, int y) const;
 
+  /** @return the first y in [y1, y2) at which column x isn't
+      GP_NOTHING, pixels outside of the map count as GP_OUTOFSCREEN,
+      y2 if the whole range is empty */
+  int find_nonempty(int x, int y1, int y2) const;
+
+  /** @return true if every pixel of column x in [y1, y2) is either
+      GP_NOTHING or of the ignored type, pixels outside of the map
+      are never clear */
+  bool is_clear(int x, int y1, int y2, Groundtype::GPType ignore = Groundtype::GP_NOTHING) const;
+
+  /** Copy the pixels of column x in [y1, y2) to out, same values as
+      getpixel() would return, but without a lookup per pixel */
+  void get_column(int x, int y1, int y2, uint8_t* out) const;
+
+  /** Follow the ray from pos in the given number of steps, testing
+      the pixel at the current position before every step, the
+      position is advanced by adding step, so the visited positions
+      are the same as with a manual loop doing pos += step.
+
+      @return the first pixel that isn't GP_NOTHING, pixels outside of
+      the map count as GP_OUTOFSCREEN */
+  RayHit raycast(glm::vec2 pos, glm::vec2 const& step, int steps) const;
+
+  /** @return the runs of non-empty pixels of column x, sorted by y */
+  std::span<ColumnSpan const> get_column_spans(int x) const;
+
   /** @return a number which represents the state of the collision
       map, once it changes the serial changes also */
   unsigned get_serial() const;
 
+  /** @return a hash of the content, two maps with the same content
+      have the same hash, unlike the serial. It is maintained on every
+      change, so it costs nothing to get. */
+  uint64_t get_hash() const { return hash; }
+
   /** Return true if the given GroundType i*/
   bool blit_allowed (int x, int y,  Groundtype::GPType) const;
 
   void put(int x, int y, Groundtype::GPType p = Groundtype::GP_GROUND);
+
+  /** Put the solid pixels of mask into the colmap, GP_BRIDGE only
+      fills empty pixels, GP_TRANSPARENT doesn't touch the colmap */
   void put(CollisionMask const& mask, int x, int y, Groundtype::GPType);
 
+  /** Set all pixels of rect to the given type, clipped to the colmap */
+  void fill_rect(Rect const& rect, Groundtype::GPType p);
+
   void remove(int x, int y);
   void remove(CollisionMask const& mask, int x, int y);
 
+  /** Low level version of remove(), clears len pixels of row y
+      starting at x, the caller has to do the clipping and call
+      touch() once for the whole edit */
+  void remove_span(int x, int y, int len);
+
+  /** Mark the already clipped area [x1, x2) x [y1, y2) as changed
+      after it got written to with remove_span() */
+  void touch(int x1, int y1, int x2, int y2);
+
+  /** Collect the changes until end_batch(), so that the serial
+      changes only once for all of them, used for the edits of a
+      game tick */
+  void begin_batch();
+  void end_batch();
+
+  /** @return the areas changed since the last call, overlapping
+      areas are merged, so each pixel shows up at most once */
+  std::vector<Rect> take_changes();
+
   void draw(DrawingContext& gc);
 
+  /** Store or restore the content of the colmap, only the column
+      spans are stored, the pixels are rebuild from them */
+  void sync_state(SavestateStream& stream);
+
+  /** Start recording the previous content of every column that gets
+      changed, so that the changes can be undone later */
+  void start_journal();
+
+  /** @return the previous content of the columns that got changed
+      since the last call, each column appears at most once */
+  std::vector<ColumnDelta> take_journal();
+
+  /** Put the columns back into the state recorded in delta, this
+      doesn't go into the journal */
+  void undo(std::vector<ColumnDelta> const& delta);
+
 private:
+  /** Record the change of area and bump the serial, or defer that
+      to end_batch() */
+  void changed(Rect const& area);
+
+  /** Rebuild the column spans of the already clipped area
+      [x1, x2) x [y1, y2) after it got written to */
+  void update_columns(int x1, int y1, int x2, int y2);
+  void update_column(int x, int y1, int y2);
+
+  /** Recalculate the hash of column x after its spans changed */
+  void rehash_column(int x);
+
   CollisionMap (CollisionMap const&);
   CollisionMap& operator= (CollisionMap const&);
 };
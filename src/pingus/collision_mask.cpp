@@ -16,58 +16,37 @@
 
 #include "pingus/collision_mask.hpp"
 
+#include <map>
+#include <mutex>
+
 #include <logmich/log.hpp>
 
 #include "pingus/resource.hpp"
 
 namespace pingus {
 
-CollisionMask::CollisionMask() :
-  surface(),
-  buffer(),
-  width(),
-  height()
-{
-}
+namespace {
 
-CollisionMask::CollisionMask(std::string const& gfx_name, std::string const& col_name) :
-  surface(),
-  buffer(),
-  width(),
-  height()
-{
-  surface = Resource::load_surface(gfx_name);
-  init_colmap(Resource::load_surface(col_name), col_name);
-}
+/** Masks are keyed by the graphic and the collision resource, which
+    are the same for masks created from a single resource */
+using MaskKey = std::pair<ResDescriptor, ResDescriptor>;
 
-CollisionMask::CollisionMask(std::string const& name) :
-  surface(),
-  buffer(),
-  width(),
-  height()
-{
-  surface = Resource::load_surface(name);
-  init_colmap(surface, name);
-}
+std::mutex s_mask_cache_mutex;
+std::map<MaskKey, std::shared_ptr<CollisionMask::Data const>> s_mask_cache;
 
-CollisionMask::CollisionMask(ResDescriptor const& res_desc) :
-  surface(),
-  buffer(),
-  width(),
-  height()
-{
-  surface = Resource::load_surface(res_desc);
-  init_colmap(surface, res_desc.res_name);
-}
+/** The innermost Recorder of the current thread */
+thread_local CollisionMask::Recorder* s_recorder = nullptr;
 
-void
-CollisionMask::init_colmap(Surface const& surf, std::string const& surface_res)
+/** Return one byte per pixel of surf, 1 for opaque pixels, 0 for
+    transparent ones */
+std::vector<uint8_t> make_buffer(Surface const& surf, std::string const& surface_res)
 {
   int pitch = surf.get_pitch();
-  width  = surf.get_width();
-  height = surf.get_height();
+  int const width  = surf.get_width();
+  int const height = surf.get_height();
 
-  buffer.reset(new uint8_t[static_cast<size_t>(width * height)]);
+  std::vector<uint8_t> result(static_cast<size_t>(width * height), 0);
+  uint8_t* buffer = result.data();
 
   SDL_Surface* sdl_surface = surf.get_surface();
   SDL_LockSurface(sdl_surface);
@@ -89,13 +68,13 @@ CollisionMask::init_colmap(Surface const& surf, std::string const& surface_res)
     }
     else
     { // completly opaque surface
-      memset(buffer.get(), 1, width * height);
+      memset(buffer, 1, static_cast<size_t>(width * height));
     }
   }
   else if (sdl_surface->format->BitsPerPixel == 24)
   {
     // completly opaque surface
-    memset(buffer.get(), 1, width * height);
+    memset(buffer, 1, static_cast<size_t>(width * height));
   }
   else if (sdl_surface->format->BitsPerPixel == 32)
   {
@@ -110,17 +89,15 @@ CollisionMask::init_colmap(Surface const& surf, std::string const& surface_res)
   }
   else
   {
-    memset(buffer.get(), 0, width * height);
-
     log_error("unsupported image format:\n"
-              "  File: %s\n"
-              "  BitsPerPixel: %d\n"
-              "  BytesPerPixel: %d\n"
-              "  rmask: 0x%08x\n"
-              "  gmask: 0x%08x\n"
-              "  bmask: 0x%08x\n"
-              "  amask: 0x%08x\n",
-              surface_res.c_str(),
+              "  File: {}\n"
+              "  BitsPerPixel: {}\n"
+              "  BytesPerPixel: {}\n"
+              "  rmask: 0x{:08x}\n"
+              "  gmask: 0x{:08x}\n"
+              "  bmask: 0x{:08x}\n"
+              "  amask: 0x{:08x}\n",
+              surface_res,
               static_cast<int>(sdl_surface->format->BitsPerPixel),
               static_cast<int>(sdl_surface->format->BytesPerPixel),
               sdl_surface->format->Rmask,
@@ -130,6 +107,119 @@ CollisionMask::init_colmap(Surface const& surf, std::string const& surface_res)
   }
 
   SDL_UnlockSurface(sdl_surface);
+
+  return result;
+}
+
+/** Run-length encode the rows of buffer into spans */
+void make_spans(uint8_t const* buffer, int width, int height,
+                std::vector<CollisionMask::Span>& spans, std::vector<int>& row_start)
+{
+  spans.clear();
+  row_start.resize(static_cast<size_t>(height + 1));
+  for(int y = 0; y < height; ++y)
+  {
+    row_start[static_cast<size_t>(y)] = static_cast<int>(spans.size());
+
+    uint8_t const* row = buffer + y * width;
+    int x = 0;
+    while (x < width)
+    {
+      if (!row[x])
+      {
+        ++x;
+      }
+      else
+      {
+        int const start = x;
+        while (x < width && row[x])
+          ++x;
+        spans.push_back(CollisionMask::Span{start, x - start});
+      }
+    }
+  }
+  row_start[static_cast<size_t>(height)] = static_cast<int>(spans.size());
+}
+
+std::shared_ptr<CollisionMask::Data const> get_mask_data(ResDescriptor const& gfx_desc, ResDescriptor const& col_desc)
+{
+  if (s_recorder)
+  {
+    s_recorder->add(gfx_desc);
+    s_recorder->add(col_desc);
+  }
+
+  std::lock_guard<std::mutex> lock(s_mask_cache_mutex);
+
+  auto it = s_mask_cache.find(MaskKey(gfx_desc, col_desc));
+  if (it != s_mask_cache.end())
+  {
+    return it->second;
+  }
+  else
+  {
+    auto data = std::make_shared<CollisionMask::Data>();
+    data->surface = Resource::load_surface(gfx_desc);
+
+    std::vector<uint8_t> gfx_buffer = make_buffer(data->surface, gfx_desc.res_name);
+    make_spans(gfx_buffer.data(), data->surface.get_width(), data->surface.get_height(),
+               data->gfx_spans, data->gfx_row_start);
+
+    if (col_desc.res_name == gfx_desc.res_name && col_desc.modifier == gfx_desc.modifier)
+    {
+      data->width  = data->surface.get_width();
+      data->height = data->surface.get_height();
+      data->buffer = std::move(gfx_buffer);
+      data->spans = data->gfx_spans;
+      data->row_start = data->gfx_row_start;
+    }
+    else
+    {
+      Surface col_surface = Resource::load_surface(col_desc);
+      data->width  = col_surface.get_width();
+      data->height = col_surface.get_height();
+      data->buffer = make_buffer(col_surface, col_desc.res_name);
+      make_spans(data->buffer.data(), data->width, data->height,
+                 data->spans, data->row_start);
+    }
+
+    s_mask_cache[MaskKey(gfx_desc, col_desc)] = data;
+    return data;
+  }
+}
+
+} // namespace
+
+CollisionMask::Recorder::Recorder() :
+  m_resources(),
+  m_previous(s_recorder)
+{
+  s_recorder = this;
+}
+
+CollisionMask::Recorder::~Recorder()
+{
+  s_recorder = m_previous;
+}
+
+CollisionMask::CollisionMask() :
+  m_data(std::make_shared<Data>())
+{
+}
+
+CollisionMask::CollisionMask(std::string const& gfx_name, std::string const& col_name) :
+  m_data(get_mask_data(ResDescriptor(gfx_name), ResDescriptor(col_name)))
+{
+}
+
+CollisionMask::CollisionMask(std::string const& name) :
+  m_data(get_mask_data(ResDescriptor(name), ResDescriptor(name)))
+{
+}
+
+CollisionMask::CollisionMask(ResDescriptor const& res_desc) :
+  m_data(get_mask_data(res_desc, res_desc))
+{
 }
 
 CollisionMask::~CollisionMask()
@@ -139,25 +229,55 @@ CollisionMask::~CollisionMask()
 int
 CollisionMask::get_width() const
 {
-  return width;
+  return m_data->width;
 }
 
 int
 CollisionMask::get_height() const
 {
-  return height;
+  return m_data->height;
 }
 
 Surface
 CollisionMask::get_surface() const
 {
-  return surface;
+  return m_data->surface;
 }
 
-uint8_t*
+uint8_t const*
 CollisionMask::get_data() const
 {
-  return buffer.get();
+  return m_data->buffer.data();
+}
+
+std::span<CollisionMask::Span const>
+CollisionMask::get_spans(int y) const
+{
+  auto const begin = m_data->spans.begin() + m_data->row_start[static_cast<size_t>(y)];
+  auto const end   = m_data->spans.begin() + m_data->row_start[static_cast<size_t>(y + 1)];
+  return std::span<Span const>(begin, end);
+}
+
+std::span<CollisionMask::Span const>
+CollisionMask::get_gfx_spans(int y) const
+{
+  auto const begin = m_data->gfx_spans.begin() + m_data->gfx_row_start[static_cast<size_t>(y)];
+  auto const end   = m_data->gfx_spans.begin() + m_data->gfx_row_start[static_cast<size_t>(y + 1)];
+  return std::span<Span const>(begin, end);
+}
+
+void
+CollisionMask::cleanup_cache()
+{
+  std::lock_guard<std::mutex> lock(s_mask_cache_mutex);
+
+  for (auto it = s_mask_cache.begin(); it != s_mask_cache.end();)
+  {
+    if (it->second.use_count() == 1)
+      it = s_mask_cache.erase(it);
+    else
+      ++it;
+  }
 }
 
 } // namespace pingus
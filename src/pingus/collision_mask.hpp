@@ -18,20 +18,49 @@
 #define HEADER_PINGUS_PINGUS_COLLISION_MASK_HPP
 
 #include <memory>
+#include <set>
+#include <span>
+#include <vector>
 
 #include "engine/display/surface.hpp"
+#include "pingus/res_descriptor.hpp"
 
 namespace pingus {
 
-class ResDescriptor;
-
+/** A CollisionMask is the solid shape of a graphic, used to put
+    ground into or remove it from the CollisionMap. Masks are
+    immutable and shared: all masks created from the same resources
+    refer to the same data, which gets loaded only once per process. */
 class CollisionMask
 {
 public:
-  Surface   surface;
-  std::unique_ptr<uint8_t[]>  buffer;
-  int       width;
-  int       height;
+  /** A horizontal run of solid pixels in a row of the mask */
+  struct Span
+  {
+    int x;
+    int len;
+  };
+
+  struct Data
+  {
+    Surface surface;
+    std::vector<uint8_t> buffer;
+    int width;
+    int height;
+
+    /** Solid pixels of all rows as spans, row y is stored in
+        spans[row_start[y]] to spans[row_start[y+1]] */
+    std::vector<Span> spans;
+    std::vector<int> row_start;
+
+    /** Same as spans, but for the opaque pixels of surface, these
+        differ from spans when a separate collision graphic is used */
+    std::vector<Span> gfx_spans;
+    std::vector<int> gfx_row_start;
+  };
+
+private:
+  std::shared_ptr<Data const> m_data;
 
 public:
   CollisionMask();
@@ -44,14 +73,37 @@ public:
   int get_height() const;
 
   Surface  get_surface() const;
-  uint8_t* get_data() const;
+  uint8_t const* get_data() const;
 
-private:
-  void init_colmap(Surface const& surf, std::string const& surface_res);
+  /** @return the solid spans of row y, ordered by x */
+  std::span<Span const> get_spans(int y) const;
 
-private:
-  CollisionMask(CollisionMask const&);
-  CollisionMask & operator=(CollisionMask const&);
+  /** @return the opaque spans of row y of get_surface(), ordered by x */
+  std::span<Span const> get_gfx_spans(int y) const;
+
+  /** Drop all cached masks that are not in use anymore */
+  static void cleanup_cache();
+
+  /** Collects the resources of all masks created on the current
+      thread while it exists, which tells what the terrain of a level
+      got drawn from */
+  class Recorder
+  {
+  private:
+    std::set<ResDescriptor> m_resources;
+    Recorder* m_previous;
+
+  public:
+    Recorder();
+    ~Recorder();
+
+    void add(ResDescriptor const& res_desc) { m_resources.insert(res_desc); }
+    std::set<ResDescriptor> const& get_resources() const { return m_resources; }
+
+  private:
+    Recorder(Recorder const&);
+    Recorder& operator=(Recorder const&);
+  };
 };
 
 } // namespace pingus
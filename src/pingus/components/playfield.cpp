@@ -101,18 +101,19 @@ Playfield::current_pingu_find(Vector2f const& pos)
   float dist;
   Pingu* c_pingu = nullptr;
 
-  for (PinguIter pingu = server->get_world()->get_pingus()->begin();
-       pingu != server->get_world()->get_pingus()->end();
-       ++pingu)
+  // is_over() tests against the center, which is at most 16 pixel
+  // away from pos (above it, or to the side for climbers)
+  for (Pingu* pingu : server->get_world()->get_pingus()->query_rect(pos.x() - 32, pos.y() - 16,
+                                                                    pos.x() + 32, pos.y() + 32))
   {
-    if ((*pingu)->is_over(pos.x(), pos.y()))
+    if (pingu->is_over(pos.x(), pos.y()))
     {
-      dist = (*pingu)->dist(pos.x(), pos.y());
+      dist = pingu->dist(pos.x(), pos.y());
 
       if (dist < min_dist)
       {
         min_dist = dist;
-        c_pingu = *pingu;
+        c_pingu = pingu;
       }
     }
   }
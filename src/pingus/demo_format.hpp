@@ -0,0 +1,96 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_PINGUS_PINGUS_DEMO_FORMAT_HPP
+#define HEADER_PINGUS_PINGUS_DEMO_FORMAT_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+
+#include "util/varint.hpp"
+
+/** The binary .pingus-demo format, all numbers are little endian:
+
+    magic     "PINGDEMO"
+    version   uint8
+    levelname varint length + bytes
+    checksum  varint length + bytes
+    seed      uint32
+
+    followed by the events up to the end of the file, each starting
+    with varint((time - previous time) << type_bits | type), where
+    type is the ServerEvent::Type. A PINGU_ACTION_EVENT continues with
+    varint(pingu_id << 5 | action) and the position as two float32, a
+    CHECKPOINT_EVENT with the state hash as uint64.
+
+    Version 1 used two bits for the type and had no checkpoints.
+
+    Text demos start with "(level", so the two formats are told apart
+    by their first bytes. */
+namespace pingus::demo_format {
+
+char const magic[] = "PINGDEMO";
+size_t const magic_size = sizeof(magic) - 1;
+uint8_t const version = 2;
+
+/** @return the number of bits used for the event type */
+inline int type_bits(uint8_t file_version)
+{
+  return file_version < 2 ? 2 : 3;
+}
+
+/** Number of bits used for the action in a pingu action event */
+int const action_bits = 5;
+
+inline bool has_magic(uint8_t const* data, size_t size)
+{
+  return size >= magic_size && memcmp(data, magic, magic_size) == 0;
+}
+
+inline void put_uint32(std::string& out, uint32_t value)
+{
+  for (int i = 0; i < 4; ++i)
+  {
+    out += static_cast<char>((value >> (8 * i)) & 0xff);
+  }
+}
+
+inline void put_uint64(std::string& out, uint64_t value)
+{
+  put_uint32(out, static_cast<uint32_t>(value));
+  put_uint32(out, static_cast<uint32_t>(value >> 32));
+}
+
+inline void put_float(std::string& out, float value)
+{
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  put_uint32(out, bits);
+}
+
+inline void put_string(std::string& out, std::string const& value)
+{
+  put_varint(out, value.size());
+  out += value;
+}
+
+} // namespace pingus::demo_format
+
+#endif
+
+/* EOF */
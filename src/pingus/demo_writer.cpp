@@ -0,0 +1,183 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "pingus/demo_writer.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+
+#include "pingus/demo_format.hpp"
+#include "pingus/server_event.hpp"
+#include "util/raise_exception.hpp"
+#include "util/writer.hpp"
+
+namespace pingus {
+
+namespace {
+
+/** Events are written to the file once this many bytes piled up */
+size_t const block_size = 4096;
+
+} // namespace
+
+DemoWriter::DemoWriter(std::string const& filename, Format format,
+                       std::string const& levelname, std::string const& checksum, uint32_t seed) :
+  m_filename(filename),
+  m_out(filename, std::ios::binary),
+  m_format(format),
+  m_buffer(),
+  m_written(0),
+  m_last_time(0),
+  m_marks()
+{
+  if (!m_out)
+    return;
+
+  if (m_format == BINARY)
+  {
+    m_buffer.append(demo_format::magic, demo_format::magic_size);
+    m_buffer += static_cast<char>(demo_format::version);
+    demo_format::put_string(m_buffer, levelname);
+    demo_format::put_string(m_buffer, checksum);
+    demo_format::put_uint32(m_buffer, seed);
+  }
+  else
+  {
+    std::ostringstream out;
+    Writer writer(out);
+    writer.begin_mapping("level");
+    writer.write("name", levelname);
+    writer.write("checksum", checksum);
+    writer.write("seed", static_cast<int>(seed));
+    writer.end_mapping();
+    out << '\n';
+    m_buffer += out.str();
+  }
+
+  flush();
+}
+
+DemoWriter::~DemoWriter()
+{
+  flush();
+}
+
+bool
+DemoWriter::is_open() const
+{
+  return static_cast<bool>(m_out);
+}
+
+void
+DemoWriter::write(ServerEvent const& event)
+{
+  if (m_marks.empty() || m_marks.back().time != event.time_stamp)
+  {
+    m_marks.push_back(Mark{event.time_stamp, m_written + m_buffer.size()});
+  }
+
+  if (m_format == BINARY)
+  {
+    if (event.time_stamp < m_last_time)
+    {
+      raise_exception(std::runtime_error, "demo event at " << event.time_stamp
+                      << " is older than the previous one at " << m_last_time);
+    }
+
+    uint64_t const delta = static_cast<uint64_t>(event.time_stamp - m_last_time);
+    put_varint(m_buffer,
+               delta << demo_format::type_bits(demo_format::version) |
+               static_cast<uint64_t>(event.type));
+    m_last_time = event.time_stamp;
+
+    if (event.type == ServerEvent::PINGU_ACTION_EVENT)
+    {
+      put_varint(m_buffer,
+                 static_cast<uint64_t>(event.pingu_id) << demo_format::action_bits |
+                 static_cast<uint64_t>(event.pingu_action));
+      demo_format::put_float(m_buffer, event.pos.x());
+      demo_format::put_float(m_buffer, event.pos.y());
+    }
+    else if (event.type == ServerEvent::CHECKPOINT_EVENT)
+    {
+      demo_format::put_uint64(m_buffer, event.state_hash);
+    }
+  }
+  else
+  {
+    std::ostringstream out;
+    event.write(out);
+    m_buffer += out.str();
+  }
+
+  if (m_buffer.size() >= block_size)
+  {
+    flush();
+  }
+}
+
+void
+DemoWriter::truncate(int time)
+{
+  auto const mark = std::lower_bound(m_marks.begin(), m_marks.end(), time,
+                                     [](Mark const& lhs, int rhs) { return lhs.time < rhs; });
+  if (mark == m_marks.end())
+    return;
+
+  uint64_t const offset = mark->offset;
+  m_last_time = (mark == m_marks.begin()) ? 0 : std::prev(mark)->time;
+  m_marks.erase(mark, m_marks.end());
+
+  if (offset >= m_written)
+  {
+    // everything to drop is still in the buffer
+    m_buffer.resize(static_cast<size_t>(offset - m_written));
+  }
+  else
+  {
+    m_buffer.clear();
+    m_out.flush();
+
+    std::error_code ec;
+    std::filesystem::resize_file(m_filename, offset, ec);
+    if (ec)
+    {
+      raise_exception(std::runtime_error, m_filename << ": couldn't truncate demo: " << ec.message());
+    }
+
+    m_out.seekp(static_cast<std::streamoff>(offset));
+    m_written = offset;
+  }
+}
+
+void
+DemoWriter::flush()
+{
+  if (m_out && !m_buffer.empty())
+  {
+    m_out.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+    m_out.flush();
+    m_written += m_buffer.size();
+  }
+  m_buffer.clear();
+}
+
+} // namespace pingus
+
+/* EOF */
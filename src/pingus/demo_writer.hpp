@@ -0,0 +1,88 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_PINGUS_PINGUS_DEMO_WRITER_HPP
+#define HEADER_PINGUS_PINGUS_DEMO_WRITER_HPP
+
+#include <fstream>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace pingus {
+
+class ServerEvent;
+
+/** Writes a demo file either in the binary format described in
+    demo_format.hpp or as s-expressions. The events are collected in
+    memory and written out in blocks, the file is complete once the
+    writer is destroyed or flush() got called. */
+class DemoWriter
+{
+public:
+  enum Format { BINARY, TEXT };
+
+private:
+  /** Where the events of a time stamp start in the file */
+  struct Mark
+  {
+    int time;
+    uint64_t offset;
+  };
+
+  std::string m_filename;
+  std::ofstream m_out;
+  Format m_format;
+
+  /** Encoded events not yet written to m_out */
+  std::string m_buffer;
+
+  /** Number of bytes already written to m_out */
+  uint64_t m_written;
+
+  /** Time of the last event, the binary format stores differences */
+  int m_last_time;
+
+  /** One mark for every time stamp that has events, see truncate() */
+  std::vector<Mark> m_marks;
+
+public:
+  /** Check is_open() afterwards to see if the file could be created */
+  DemoWriter(std::string const& filename, Format format,
+             std::string const& levelname, std::string const& checksum, uint32_t seed);
+  ~DemoWriter();
+
+  bool is_open() const;
+
+  /** Events must be written in the order of their time stamps */
+  void write(ServerEvent const& event);
+
+  /** Drop all events at or after time, so that the recording can go
+      on from an earlier state of the game, used when rewinding */
+  void truncate(int time);
+
+  void flush();
+
+private:
+  DemoWriter(DemoWriter const&);
+  DemoWriter& operator=(DemoWriter const&);
+};
+
+} // namespace pingus
+
+#endif
+
+/* EOF */
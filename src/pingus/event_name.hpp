@@ -26,6 +26,7 @@ enum EventName {
   PAUSE_BUTTON,
   FAST_FORWARD_BUTTON,
   SINGLE_STEP_BUTTON,
+  REWIND_BUTTON,
   ARMAGEDDON_BUTTON,
   ESCAPE_BUTTON,
 
@@ -33,6 +33,7 @@ int         tile_size               = 32;
 
 bool        draw_collision_map      = false;
 bool        software_cursor         = false;
+int         demo_checkpoint_interval = 100;
 
 std::string global_username;
 std::string global_email;
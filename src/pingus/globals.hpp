@@ -42,6 +42,7 @@ extern bool        drag_drop_scrolling;
 extern int         tile_size;                       ///< --tile-size
 extern bool        draw_collision_map;              ///<
 extern bool        software_cursor;                 ///< --enable-swcursor
+extern int         demo_checkpoint_interval;        ///< ticks between state hashes recorded in demos, 0 disables them
 
 extern std::string  global_username;                 ///< The name of the currently logged in user
 extern std::string  global_email;                    ///< The email address of the currently logged in user
@@ -17,6 +17,7 @@
 #include "pingus/goal_manager.hpp"
 
 #include "pingus/pingu_holder.hpp"
+#include "pingus/savestate.hpp"
 #include "pingus/server.hpp"
 #include "pingus/world.hpp"
 
@@ -91,6 +92,13 @@ GoalManager::set_abort_goal()
   goal = GT_GAME_ABORTED;
 }
 
+void
+GoalManager::sync_state(SavestateStream& stream)
+{
+  stream.sync(goal);
+  stream.sync(exit_time);
+}
+
 } // namespace pingus
 
 /* EOF */
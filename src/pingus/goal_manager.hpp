@@ -19,6 +19,7 @@
 
 namespace pingus {
 
+class SavestateStream;
 class Server;
 
 /** Class that looks at the server and searches for goal conditions,
@@ -50,6 +51,8 @@ public:
   /** Check for goal conditions and set finished accordingly */
   void update();
 
+  void sync_state(SavestateStream& stream);
+
 private:
   GoalManager (GoalManager const&);
   GoalManager& operator= (GoalManager const&);
@@ -16,12 +16,18 @@
 
 #include "pingus/ground_map.hpp"
 
+#include <algorithm>
+#include <assert.h>
 #include <stdexcept>
+#include <utility>
 
 #include <logmich/log.hpp>
 
 #include "engine/display/scene_context.hpp"
 #include "pingus/collision_map.hpp"
+#include "pingus/collision_mask.hpp"
+#include "pingus/savestate.hpp"
+#include "util/raise_exception.hpp"
 
 namespace pingus {
 
@@ -30,22 +36,48 @@ class MapTile
 private:
   Sprite   sprite;
   Surface  surface;
-  bool sprite_needs_update;
+
+  /** Area of surface that changed since the last get_sprite() */
+  geom::irect dirty_rect;
+
+  /** The surface before the first change, see GroundMap::track_changes() */
+  Surface original;
+  bool changed;
 
 public:
   MapTile();
   ~MapTile();
 
-  void remove(Surface const&, int x, int y, int real_x, int real_y, GroundMap*);
   void put(Surface const&, int x, int y);
 
+  Surface const& get_surface() const { return surface; }
   Sprite const& get_sprite();
+
+  /** Mark the given area, in tile coordinates, as changed */
+  void add_dirty_rect(int x, int y, int w, int h);
+
+  /** Keep a copy of the surface, must be called before the tile
+      gets changed while the GroundMap tracks changes */
+  void remember_original();
+
+  bool is_changed() const { return changed; }
+
+  /** Go back to the surface from before the first change */
+  void revert();
+
+  /** Replace the graphic of the tile */
+  void set_surface(Surface const& surface);
+
+  /** Store or restore all pixels of the tile */
+  void sync_pixels(SavestateStream& stream);
 };
 
 MapTile::MapTile() :
   sprite(),
   surface(),
-  sprite_needs_update(false)
+  dirty_rect(),
+  original(),
+  changed(false)
 {
 }
 
@@ -54,13 +86,24 @@ MapTile::~MapTile()
 }
 
 void
-MapTile::remove(Surface const& src, int x, int y,
-                int real_x, int real_y, GroundMap* parent)
+MapTile::add_dirty_rect(int x, int y, int w, int h)
 {
-  if (surface)
+  geom::irect rect(std::max(0, x), std::max(0, y),
+                   std::min(globals::tile_size, x + w), std::min(globals::tile_size, y + h));
+
+  if (rect.width() <= 0 || rect.height() <= 0)
+    return;
+
+  if (dirty_rect.width() <= 0 || dirty_rect.height() <= 0)
+  {
+    dirty_rect = rect;
+  }
+  else
   {
-    parent->put_alpha_surface(surface, src, x, y, real_x, real_y);
-    sprite_needs_update = true;
+    dirty_rect = geom::irect(std::min(dirty_rect.left(),   rect.left()),
+                             std::min(dirty_rect.top(),    rect.top()),
+                             std::max(dirty_rect.right(),  rect.right()),
+                             std::max(dirty_rect.bottom(), rect.bottom()));
   }
 }
 
@@ -71,21 +114,85 @@ MapTile::put(Surface const& src, int x, int y)
     surface = Surface(globals::tile_size, globals::tile_size);
 
   surface.blit(src, x, y);
-  sprite_needs_update = true;
+  add_dirty_rect(x, y, src.get_width(), src.get_height());
 }
 
-Sprite const&
-MapTile::get_sprite()
+void
+MapTile::remember_original()
 {
-  if (sprite_needs_update)
+  if (!changed)
   {
-    sprite_needs_update = false;
-    return sprite = Sprite(surface);
+    original = surface ? surface.clone() : Surface();
+    changed = true;
   }
+}
+
+void
+MapTile::revert()
+{
+  if (!changed)
+    return;
+
+  surface = original;
+  original = Surface();
+  changed = false;
+
+  if (surface)
+    add_dirty_rect(0, 0, globals::tile_size, globals::tile_size);
+  else
+    sprite = Sprite();
+}
+
+void
+MapTile::set_surface(Surface const& surface_)
+{
+  surface = surface_;
+
+  if (surface)
+    add_dirty_rect(0, 0, globals::tile_size, globals::tile_size);
   else
+    sprite = Sprite();
+}
+
+void
+MapTile::sync_pixels(SavestateStream& stream)
+{
+  if (stream.is_reading())
+  {
+    if (!surface)
+      surface = Surface(globals::tile_size, globals::tile_size);
+    add_dirty_rect(0, 0, globals::tile_size, globals::tile_size);
+  }
+
+  assert(surface);
+
+  surface.lock();
+  uint8_t* const data = surface.get_data();
+  for (int y = 0; y < surface.get_height(); ++y)
+  {
+    stream.sync_bytes(data + y * surface.get_pitch(), static_cast<size_t>(4 * surface.get_width()));
+  }
+  surface.unlock();
+}
+
+Sprite const&
+MapTile::get_sprite()
+{
+  if (dirty_rect.width() > 0 && dirty_rect.height() > 0)
   {
-    return sprite;
+    if (!sprite)
+    {
+      sprite = Sprite(surface);
+    }
+    else
+    {
+      // only upload the changed part instead of recreating the texture
+      sprite.update_surface(surface, dirty_rect);
+    }
+    dirty_rect = geom::irect();
   }
+
+  return sprite;
 }
 
 GroundMap::GroundMap(int width_, int height_) :
@@ -94,7 +201,12 @@ GroundMap::GroundMap(int width_, int height_) :
   width(width_),
   height(height_),
   tile_width(),
-  tile_height()
+  tile_height(),
+  tracking(false),
+  journaling(false),
+  journal_generation(0),
+  journal_marks(),
+  journal()
 {
   colmap.reset(new CollisionMap(width, height));
 
@@ -181,119 +293,130 @@ GroundMap::get_height() const
 }
 
 void
-GroundMap::remove(Surface const& sprovider, int x, int y)
-{
-  // Get the start tile and end tile
-  int start_x = std::max(x / globals::tile_size, 0);
-  int start_y = std::max(y / globals::tile_size, 0);
-  int end_x   = std::min((x + sprovider.get_width()) / globals::tile_size,
-                          (width - 1) / globals::tile_size);
-  int end_y   = std::min((y + sprovider.get_height()) / globals::tile_size,
-                          (height - 1) / globals::tile_size);
-
-  for(int ix = start_x; ix <= end_x; ++ix)
-    for(int iy = start_y; iy <= end_y; ++iy)
-    {
-      get_tile(ix, iy)->remove(sprovider,
-                               x - (ix * globals::tile_size),
-                               y - (iy * globals::tile_size), x, y, this);
-    }
-}
-
-void
-GroundMap::put_alpha_surface(Surface provider, Surface sprovider,
-                             int x_pos, int y_pos, int real_x_arg, int real_y_arg)
+GroundMap::remove(CollisionMask const& mask, int x_pos, int y_pos)
 {
-  if (sprovider.get_surface()->format->BitsPerPixel != 8  &&
-      sprovider.get_surface()->format->BitsPerPixel != 24 &&
-      sprovider.get_surface()->format->BitsPerPixel != 32)
-  {
-    log_error("Image has wrong color depth: {}",
-              static_cast<int>(sprovider.get_surface()->format->BitsPerPixel));
-    return;
-  }
-
-  int swidth  = sprovider.get_width();
-  int twidth  = provider.get_width();
+  Surface const mask_surface = mask.get_surface();
 
-  int spitch = sprovider.get_pitch();
-  int tpitch = provider.get_pitch();
+  int const gfx_w = mask_surface.get_width();
+  int const gfx_h = mask_surface.get_height();
 
-  int start_x = std::max(0, -x_pos);
-  int start_y = std::max(0, -y_pos);
+  // the area touched by either the graphic or the collision part of the mask
+  int const area_w = std::max(gfx_w, mask.get_width());
+  int const area_h = std::max(gfx_h, mask.get_height());
 
-  int end_x = std::min(swidth,  twidth  - x_pos);
-  int end_y = std::min(sprovider.get_height(), provider.get_height() - y_pos);
+  int const start_x = std::max(0, x_pos);
+  int const start_y = std::max(0, y_pos);
+  int const end_x   = std::min(width,  x_pos + area_w);
+  int const end_y   = std::min(height, y_pos + area_h);
 
-  if (end_x - start_x <= 0 || end_y - start_y <= 0)
+  if (end_x <= start_x || end_y <= start_y)
     return;
 
-  provider.lock();
-  sprovider.lock();
+  int const ts = globals::tile_size;
 
-  Uint8* target_buf = provider.get_data();
-  Uint8* source_buf = sprovider.get_data();
-  Uint32 colorkey;
-  if (sprovider.get_surface()->format->BitsPerPixel == 32)
+  // Look up and lock the affected tiles once for the whole edit
+  struct TileRef
   {
-    for (int y = start_y; y < end_y; ++y)
+    MapTile* tile;
+    uint8_t* pixels;
+    int pitch;
+  };
+
+  int const tile_x1 = start_x / ts;
+  int const tile_y1 = start_y / ts;
+  int const tile_x2 = (end_x - 1) / ts;
+  int const tile_y2 = (end_y - 1) / ts;
+  int const tiles_w = tile_x2 - tile_x1 + 1;
+
+  std::vector<TileRef> refs;
+  refs.reserve(static_cast<size_t>(tiles_w * (tile_y2 - tile_y1 + 1)));
+  for (int ty = tile_y1; ty <= tile_y2; ++ty)
+  {
+    for (int tx = tile_x1; tx <= tile_x2; ++tx)
     {
-      Uint8* tptr = target_buf + tpitch*(y+y_pos) + 4*(x_pos + start_x);
-      Uint8* sptr = source_buf + spitch*y + 4*start_x;
-
-      for (int x = start_x; x < end_x; ++x)
+      MapTile* tile = get_tile(tx, ty);
+      Surface surface = tile->get_surface();
+      if (surface)
       {
-        if (sptr[3] == 255 &&
-            colmap->getpixel(real_x_arg+x, real_y_arg+y) != Groundtype::GP_SOLID)
-        {
-          tptr[3] = 0;
-        }
-
-        tptr += 4;
-        sptr += 4;
+        if (journaling)
+          journal_tile(tx, ty);
+        if (tracking)
+          tile->remember_original();
+        surface.lock();
+        refs.push_back(TileRef{tile, surface.get_data(), surface.get_pitch()});
+        tile->add_dirty_rect(x_pos - tx * ts, y_pos - ty * ts, gfx_w, gfx_h);
+      }
+      else
+      {
+        refs.push_back(TileRef{tile, nullptr, 0});
       }
     }
   }
-  else if (SDL_GetColorKey(sprovider.get_surface(), &colorkey) == 0)
+
+  uint8_t const* colmap_data = colmap->get_data();
+
+  for (int y = start_y; y < end_y; ++y)
   {
-    for (int y = start_y; y < end_y; ++y)
+    int const mask_y = y - y_pos;
+    int const tile_y = y / ts;
+    int const local_y = y - tile_y * ts;
+    uint8_t const* colmap_row = colmap_data + y * width;
+    TileRef const* tile_row = refs.data() + (tile_y - tile_y1) * tiles_w;
+
+    // clear the alpha of everything that isn't solid, this has to see
+    // the colmap as it was before this row got removed from it
+    if (mask_y < gfx_h)
     {
-      Uint8* tptr = target_buf + tpitch*(y+y_pos) + 4*(x_pos + start_x);
-      Uint8* sptr = source_buf + spitch*y + start_x;
-
-      for (int x = start_x; x < end_x; ++x)
+      for (CollisionMask::Span const& span : mask.get_gfx_spans(mask_y))
       {
-        if (*sptr != colorkey && colmap->getpixel(real_x_arg+x, real_y_arg+y) != Groundtype::GP_SOLID)
+        int x = std::max(start_x, x_pos + span.x);
+        int const span_end = std::min(end_x, x_pos + span.x + span.len);
+        while (x < span_end)
         {
-          tptr[3] = 0;
+          int const tile_x = x / ts;
+          int const chunk_end = std::min(span_end, (tile_x + 1) * ts);
+          TileRef const& ref = tile_row[tile_x - tile_x1];
+          if (ref.pixels)
+          {
+            uint8_t* alpha = ref.pixels + local_y * ref.pitch + 4 * (x - tile_x * ts) + 3;
+            for (; x < chunk_end; ++x, alpha += 4)
+            {
+              if (colmap_row[x] != Groundtype::GP_SOLID)
+                *alpha = 0;
+            }
+          }
+          x = chunk_end;
         }
-
-        tptr += 4;
-        sptr += 1;
       }
     }
-  }
-  else
-  {
-    // opaque source surface, so we can use the same code for 24bpp and indexed
-    for (int y = start_y; y < end_y; ++y)
-    {
-      Uint8* tptr = target_buf + tpitch*(y+y_pos) + 4*(x_pos + start_x);
 
-      for (int x = start_x; x < end_x; ++x)
+    // then clear the same row of the colmap
+    if (mask_y < mask.get_height())
+    {
+      for (CollisionMask::Span const& span : mask.get_spans(mask_y))
       {
-        if (colmap->getpixel(real_x_arg+x, real_y_arg+y) != Groundtype::GP_SOLID)
+        int const span_start = std::max(start_x, x_pos + span.x);
+        int const span_end   = std::min(end_x,   x_pos + span.x + span.len);
+        if (span_start < span_end)
         {
-          tptr[3] = 0;
+          colmap->remove_span(span_start, y, span_end - span_start);
         }
-
-        tptr += 4;
       }
     }
   }
 
-  sprovider.unlock();
-  provider.unlock();
+  colmap->touch(start_x, start_y,
+                std::min(end_x, x_pos + mask.get_width()),
+                std::min(end_y, y_pos + mask.get_height()));
+
+  for (TileRef const& ref : refs)
+  {
+    if (ref.pixels)
+    {
+      Surface surface = ref.tile->get_surface();
+      surface.unlock();
+    }
+  }
 }
 
 void
@@ -310,6 +433,10 @@ GroundMap::put(Surface const& source, int x, int y)
   for(int ix = start_x; ix < end_x; ++ix)
     for(int iy = start_y; iy < end_y; ++iy)
     {
+      if (journaling)
+        journal_tile(ix, iy);
+      if (tracking)
+        get_tile(ix, iy)->remember_original();
       get_tile(ix, iy)->put(source,
                             x - (ix * globals::tile_size), y - (iy * globals::tile_size));
     }
@@ -327,6 +454,179 @@ GroundMap::get_tile(int x, int y)
   return tiles[y * tile_width + x].get();
 }
 
+void
+GroundMap::track_changes()
+{
+  tracking = true;
+}
+
+void
+GroundMap::sync_state(SavestateStream& stream)
+{
+  assert(tracking);
+
+  colmap->sync_state(stream);
+
+  std::vector<uint32_t> changed_tiles;
+  for (size_t i = 0; i < tiles.size(); ++i)
+  {
+    if (tiles[i]->is_changed())
+      changed_tiles.push_back(static_cast<uint32_t>(i));
+  }
+
+  std::vector<uint32_t> const current_tiles = changed_tiles;
+  stream.sync_size(changed_tiles);
+  for (uint32_t& index : changed_tiles)
+  {
+    stream.sync(index);
+    if (index >= tiles.size())
+    {
+      raise_exception(std::runtime_error, "invalid tile index " << index);
+    }
+  }
+
+  if (stream.is_reading())
+  {
+    // tiles that got changed after the state was taken
+    for (uint32_t index : current_tiles)
+    {
+      if (!std::binary_search(changed_tiles.begin(), changed_tiles.end(), index))
+        tiles[index]->revert();
+    }
+  }
+
+  for (uint32_t index : changed_tiles)
+  {
+    if (stream.is_reading())
+      tiles[index]->remember_original();
+    tiles[index]->sync_pixels(stream);
+  }
+}
+
+void
+GroundMap::sync_terrain(SavestateStream& stream)
+{
+  assert(!tracking);
+
+  colmap->sync_state(stream);
+
+  std::vector<uint32_t> used_tiles;
+  for (size_t i = 0; i < tiles.size(); ++i)
+  {
+    if (tiles[i]->get_surface())
+      used_tiles.push_back(static_cast<uint32_t>(i));
+  }
+
+  stream.sync_size(used_tiles);
+  for (uint32_t& index : used_tiles)
+  {
+    stream.sync(index);
+    if (index >= tiles.size())
+    {
+      raise_exception(std::runtime_error, "invalid tile index " << index);
+    }
+  }
+
+  if (stream.is_reading())
+  {
+    for (auto const& tile : tiles)
+    {
+      tile->set_surface(Surface());
+    }
+  }
+
+  for (uint32_t index : used_tiles)
+  {
+    tiles[index]->sync_pixels(stream);
+  }
+}
+
+void
+GroundMap::clear_terrain()
+{
+  assert(!tracking);
+
+  colmap->fill_rect(Rect(0, 0, width, height), Groundtype::GP_NOTHING);
+  for (auto const& tile : tiles)
+  {
+    tile->set_surface(Surface());
+  }
+}
+
+size_t
+GroundMap::Delta::get_size() const
+{
+  size_t size = 0;
+  for (CollisionMap::ColumnDelta const& column : columns)
+  {
+    size += sizeof(column) + column.spans.size() * sizeof(CollisionMap::ColumnSpan);
+  }
+  for (TileDelta const& tile : tiles)
+  {
+    size += sizeof(tile);
+    if (tile.surface)
+      size += static_cast<size_t>(tile.surface.get_pitch() * tile.surface.get_height());
+  }
+  return size;
+}
+
+void
+GroundMap::start_journal()
+{
+  colmap->start_journal();
+
+  if (!journaling)
+  {
+    journaling = true;
+    journal_marks.assign(tiles.size(), journal_generation);
+    ++journal_generation;
+  }
+}
+
+void
+GroundMap::journal_tile(int x, int y)
+{
+  size_t const index = static_cast<size_t>(y * tile_width + x);
+  if (journal_marks[index] != journal_generation)
+  {
+    journal_marks[index] = journal_generation;
+
+    Surface const& surface = tiles[index]->get_surface();
+    journal.push_back(TileDelta{static_cast<uint32_t>(index),
+                                surface ? surface.clone() : Surface()});
+  }
+}
+
+GroundMap::Delta
+GroundMap::take_journal()
+{
+  ++journal_generation;
+  if (journal_generation == 0)
+  {
+    std::fill(journal_marks.begin(), journal_marks.end(), 0);
+    journal_generation = 1;
+  }
+
+  return Delta{colmap->take_journal(), std::exchange(journal, {})};
+}
+
+void
+GroundMap::undo(Delta const& delta)
+{
+  colmap->undo(delta.columns);
+
+  for (TileDelta const& tile : delta.tiles)
+  {
+    if (tile.index >= tiles.size())
+      continue;
+
+    if (tracking)
+      tiles[tile.index]->remember_original();
+
+    tiles[tile.index]->set_surface(tile.surface);
+  }
+}
+
 } // namespace pingus
 
 /* EOF */
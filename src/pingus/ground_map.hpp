@@ -18,17 +18,21 @@
 #define HEADER_PINGUS_PINGUS_GROUND_MAP_HPP
 
 #include <memory>
+#include <stdint.h>
+#include <vector>
 
 #include "engine/display/surface.hpp"
+#include "pingus/collision_map.hpp"
 #include "pingus/globals.hpp"
 #include "pingus/worldobj.hpp"
 
 namespace pingus {
 
 class SceneContext;
-class CollisionMap;
+class CollisionMask;
 class GroundMap;
 class MapTile;
+class SavestateStream;
 
 /** This map type is the defaulh maptype, it is should be used for the
     most levels. It allows to construct a map, from a set of simple
@@ -36,6 +40,25 @@ class MapTile;
     using to much diskspace. */
 class GroundMap : public WorldObj
 {
+public:
+  /** The graphic a tile had before it got changed */
+  struct TileDelta
+  {
+    uint32_t index;
+    Surface surface;
+  };
+
+  /** The previous content of the terrain that got changed during a
+      stretch of time, see take_journal() */
+  struct Delta
+  {
+    std::vector<CollisionMap::ColumnDelta> columns;
+    std::vector<TileDelta> tiles;
+
+    /** @return the approximate number of bytes used by the delta */
+    size_t get_size() const;
+  };
+
 private:
   std::unique_ptr<CollisionMap> colmap;
 
@@ -50,6 +73,18 @@ private:
   int tile_width;
   int tile_height;
 
+  /** Set by track_changes() */
+  bool tracking;
+
+  /** Set by start_journal() */
+  bool journaling;
+
+  /** Same scheme as in CollisionMap, a tile is in the journal when
+      its mark equals the generation */
+  uint32_t journal_generation;
+  std::vector<uint32_t> journal_marks;
+  std::vector<TileDelta> journal;
+
 public:
   GroundMap(int width, int height);
   ~GroundMap() override;
@@ -64,23 +99,54 @@ public:
   /** Put the gives surface provider onto the given coordinates */
   void put(Surface const&, int x, int y);
 
-  /** Remove the gives surface provider onto the given coordinates
-      (everything non-transparent that isn't Groundtype::GP_Solid
-      is removed from the map) */
-  void remove(Surface const&, int x, int y);
+  /** Remove mask from the graphic and the colmap in a single pass,
+      everything that isn't Groundtype::GP_SOLID is removed */
+  void remove(CollisionMask const& mask, int x, int y);
 
   float z_index() const override { return 0; }
   void set_z_index(float z_index) override {}
   void set_pos(Vector2f const& p) override {}
   Vector2f get_pos() const override { return Vector2f(); }
 
-  /** Low level version of the remove() call, acts on a single tile
-      instead of the complete map-tiles */
-  void put_alpha_surface(Surface provider, Surface sprovider,
-                         int x, int y, int real_x, int real_y);
-
   MapTile* get_tile(int x, int y);
+
+  /** Remember the original graphic of every tile that gets changed
+      from now on, called once the level is set up, so that
+      sync_state() only has to store the tiles that got changed */
+  void track_changes();
+
+  /** Store or restore the colmap and the graphic of the tiles that
+      changed since track_changes() */
+  void sync_state(SavestateStream& stream) override;
+
+  /** Store or restore the colmap and the graphic of all tiles, used
+      to bake the terrain of a level once it is set up, so it doesn't
+      have to be drawn again the next time, see TerrainCache. Must be
+      called before track_changes(). */
+  void sync_terrain(SavestateStream& stream);
+
+  /** Remove all ground and graphics, used to draw the terrain anew
+      when a baked one couldn't be read. Must be called before
+      track_changes(). */
+  void clear_terrain();
+
+  /** Start recording the previous content of the colmap columns and
+      tiles that get changed */
+  void start_journal();
+
+  /** @return the previous content of everything that changed since
+      the last call */
+  Delta take_journal();
+
+  /** Put the terrain back into the state recorded in delta, the
+      tiles take over the surfaces of delta, so it must not be used
+      again afterwards */
+  void undo(Delta const& delta);
+
 private:
+  /** Record the tile in the journal before it gets changed */
+  void journal_tile(int x, int y);
+
   /** Draw the collision map onto the screen */
   void draw_colmap(SceneContext& gc);
 
@@ -0,0 +1,304 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "pingus/level_index.hpp"
+
+#include <stdexcept>
+#include <string.h>
+
+#include <logmich/log.hpp>
+
+#include "pingus/pingus_level.hpp"
+#include "pingus/savestate.hpp"
+#include "util/mapped_file.hpp"
+#include "util/pathname.hpp"
+#include "util/raise_exception.hpp"
+
+namespace pingus {
+
+namespace {
+
+char const magic[8] = { 'P', 'I', 'N', 'G', 'L', 'I', 'D', 'X' };
+
+/** Has to be increased whenever LevelInfo or the way the head is read
+    changes, older indexes get rebuilt then */
+uint32_t const version = 1;
+
+} // namespace
+
+std::mutex LevelIndex::mutex;
+LevelIndex::EntryMap LevelIndex::entries;
+std::string LevelIndex::filename;
+bool LevelIndex::dirty = false;
+LevelIndex::Stats LevelIndex::stats = { 0, 0 };
+
+std::string
+LevelIndex::get_filename()
+{
+  if (System::get_userdir().empty())
+  {
+    return std::string();
+  }
+  else
+  {
+    return System::get_cachedir() + "levels.index";
+  }
+}
+
+void
+LevelIndex::sync_entry(SavestateStream& stream, std::string& path, Entry& entry)
+{
+  stream.sync(path);
+
+  stream.sync(entry.stamp.size);
+  stream.sync(entry.stamp.mtime);
+  stream.sync(entry.stamp.ctime);
+  stream.sync(entry.stamp.inode);
+
+  LevelInfo& info = entry.info;
+  stream.sync(info.resname);
+  stream.sync(info.levelname);
+  stream.sync(info.description);
+  stream.sync(info.author);
+  stream.sync(info.music);
+
+  int width = info.size.width();
+  int height = info.size.height();
+  stream.sync(width);
+  stream.sync(height);
+  info.size = Size(width, height);
+
+  stream.sync(info.time);
+  stream.sync(info.number_of_pingus);
+  stream.sync(info.number_to_save);
+
+  uint64_t count = info.actions.size();
+  stream.sync(count);
+  if (stream.is_reading())
+  {
+    stream.check_size(count);
+    info.actions.clear();
+    for (uint64_t i = 0; i < count; ++i)
+    {
+      std::string name;
+      int value;
+      stream.sync(name);
+      stream.sync(value);
+      info.actions[name] = value;
+    }
+  }
+  else
+  {
+    for (auto& action : info.actions)
+    {
+      std::string name = action.first;
+      stream.sync(name);
+      stream.sync(action.second);
+    }
+  }
+
+  stream.sync(info.checksum);
+  stream.sync(info.file_size);
+  stream.sync(info.thumbnail);
+}
+
+void
+LevelIndex::load()
+{
+  std::string const new_filename = get_filename();
+  if (new_filename == filename)
+    return;
+
+  filename = new_filename;
+  entries.clear();
+  dirty = false;
+
+  if (filename.empty() || !System::exist(filename))
+    return;
+
+  try
+  {
+    MappedFile file(filename);
+
+    uint32_t file_version;
+    if (file.size() < sizeof(magic) + sizeof(file_version) ||
+        memcmp(file.data(), magic, sizeof(magic)) != 0)
+    {
+      raise_exception(std::runtime_error, "not a level index");
+    }
+    memcpy(&file_version, file.data() + sizeof(magic), sizeof(file_version));
+
+    if (file_version != version)
+    {
+      log_info("{}: written by another version, rebuilding it", filename);
+      dirty = true;
+      return;
+    }
+
+    size_t const header_size = sizeof(magic) + sizeof(file_version);
+    SavestateStream stream = SavestateStream::reader(file.data() + header_size,
+                                                     file.size() - header_size);
+
+    uint64_t count;
+    stream.sync(count);
+    stream.check_size(count);
+    for (uint64_t i = 0; i < count; ++i)
+    {
+      std::string path;
+      Entry entry;
+      sync_entry(stream, path, entry);
+      entries[path] = entry;
+    }
+  }
+  catch(std::exception const& err)
+  {
+    log_warn("{}: ignoring level index: {}", filename, err.what());
+    entries.clear();
+    dirty = true;
+  }
+}
+
+LevelInfo
+LevelIndex::get(std::string const& resname)
+{
+  return get(resname, Pathname("levels/" + resname + ".pingus", Pathname::DATA_PATH));
+}
+
+LevelInfo
+LevelIndex::get(std::string const& resname, Pathname const& pathname)
+{
+  std::string const path = pathname.get_sys_path();
+
+  System::FileStamp stamp;
+  if (!System::get_stamp(path, stamp))
+  {
+    raise_exception(std::runtime_error, "Error: " << pathname.str() << ": level not found");
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    load();
+
+    EntryMap::iterator it = entries.find(path);
+    if (it != entries.end() && it->second.stamp == stamp)
+    {
+      stats.hits += 1;
+      LevelInfo info = it->second.info;
+      info.resname = resname;
+      return info;
+    }
+  }
+
+  // parsed without the lock, only the head gets read
+  log_debug("LevelIndex: parsing '{}'", path);
+  PingusLevel plf(resname, pathname);
+
+  Entry entry;
+  entry.stamp = stamp;
+
+  LevelInfo& info = entry.info;
+  info.resname          = resname;
+  info.levelname        = plf.get_levelname();
+  info.description      = plf.get_description();
+  info.author           = plf.get_author();
+  info.music            = plf.get_music();
+  info.size             = plf.get_size();
+  info.time             = plf.get_time();
+  info.number_of_pingus = plf.get_number_of_pingus();
+  info.number_to_save   = plf.get_number_to_save();
+  info.actions          = plf.get_actions();
+  info.checksum         = plf.get_checksum();
+  info.file_size        = plf.get_file_size();
+  if (!System::get_userdir().empty())
+  {
+    info.thumbnail = System::get_cachedir() + "thumbnails/" + info.checksum + ".png";
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  stats.misses += 1;
+  entries[path] = entry;
+  dirty = true;
+  return info;
+}
+
+void
+LevelIndex::flush()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  load();
+
+  if (!dirty || filename.empty())
+    return;
+
+  for (EntryMap::iterator it = entries.begin(); it != entries.end();)
+  {
+    if (!System::exist(it->first))
+      it = entries.erase(it);
+    else
+      ++it;
+  }
+
+  try
+  {
+    Savestate state;
+    SavestateStream stream = SavestateStream::writer(state);
+
+    uint64_t count = entries.size();
+    stream.sync(count);
+    for (auto& it : entries)
+    {
+      std::string path = it.first;
+      sync_entry(stream, path, it.second);
+    }
+
+    std::vector<uint8_t> const& data = state.get_data();
+
+    std::string content;
+    content.reserve(sizeof(magic) + sizeof(version) + data.size());
+    content.append(magic, sizeof(magic));
+    content.append(reinterpret_cast<char const*>(&version), sizeof(version));
+    content.append(reinterpret_cast<char const*>(data.data()), data.size());
+
+    System::create_dir(System::get_cachedir());
+    System::write_file(filename, content);
+    dirty = false;
+  }
+  catch(std::exception const& err)
+  {
+    log_warn("{}: couldn't write level index: {}", filename, err.what());
+  }
+}
+
+void
+LevelIndex::clear()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+
+  entries.clear();
+  filename.clear();
+  dirty = false;
+}
+
+LevelIndex::Stats
+LevelIndex::get_stats()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return stats;
+}
+
+} // namespace pingus
+
+/* EOF */
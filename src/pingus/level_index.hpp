@@ -0,0 +1,142 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_PINGUS_PINGUS_LEVEL_INDEX_HPP
+#define HEADER_PINGUS_PINGUS_LEVEL_INDEX_HPP
+
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "math/size.hpp"
+#include "util/system.hpp"
+
+namespace pingus {
+
+class Pathname;
+class SavestateStream;
+
+/** The head of a level, all that is needed to list it in a menu or
+    on the worldmap */
+struct LevelInfo
+{
+  std::string resname;
+  std::string levelname;
+  std::string description;
+  std::string author;
+  std::string music;
+
+  Size size;
+  int time;
+  int number_of_pingus;
+  int number_to_save;
+
+  std::map<std::string, int> actions;
+
+  std::string checksum;
+  uint64_t file_size;
+
+  /** Where a thumbnail of the level gets cached, the index only keeps
+      the reference, the image isn't rendered by it */
+  std::string thumbnail;
+
+  LevelInfo() :
+    resname(),
+    levelname(),
+    description(),
+    author(),
+    music(),
+    size(),
+    time(0),
+    number_of_pingus(0),
+    number_to_save(0),
+    actions(),
+    checksum(),
+    file_size(0),
+    thumbnail()
+  {}
+};
+
+/** Keeps the heads of all levels that got listed in a file in the
+    cachedir, keyed by the path and stamp of the level file, so that
+    menus and the worldmap can be opened without parsing any level.
+    Only levels whose file changed get parsed again, the full level
+    is loaded through the PLFResMgr once it gets played. */
+class LevelIndex
+{
+public:
+  struct Stats
+  {
+    /** Levels taken from the index */
+    int hits;
+
+    /** Levels that had to be parsed */
+    int misses;
+  };
+
+private:
+  struct Entry
+  {
+    System::FileStamp stamp;
+    LevelInfo info;
+  };
+
+  typedef std::map<std::string, Entry> EntryMap;
+
+  static std::mutex mutex;
+  static EntryMap entries;
+
+  /** The index file entries got read from, empty if none was read */
+  static std::string filename;
+
+  /** Set when entries differ from the file */
+  static bool dirty;
+
+  static Stats stats;
+
+  /** Read the index file, unless it was already read, mutex must be
+      held */
+  static void load();
+
+  static void sync_entry(SavestateStream& stream, std::string& path, Entry& entry);
+
+public:
+  /** @return the head of the level 'snow11-grumbel' etc., throws if
+      the level can't be read */
+  static LevelInfo get(std::string const& resname);
+
+  /** @return the head of the level stored in pathname */
+  static LevelInfo get(std::string const& resname, Pathname const& pathname);
+
+  /** Write the index file if levels were added or changed, levels
+      whose file is gone get dropped, errors are only logged */
+  static void flush();
+
+  /** Forget the entries in memory, the next call reads the file
+      again */
+  static void clear();
+
+  static Stats get_stats();
+
+  /** @return the file the index is stored in */
+  static std::string get_filename();
+};
+
+} // namespace pingus
+
+#endif
+
+/* EOF */
@@ -21,7 +21,6 @@
 #include <logmich/log.hpp>
 
 #include "math/math.hpp"
-#include "pingus/plf_res_mgr.hpp"
 #include "pingus/globals.hpp"
 #include "pingus/savegame_manager.hpp"
 #include "util/raise_exception.hpp"
@@ -55,6 +54,8 @@ Levelset::from_directory(std::string const& title,
     }
   }
 
+  LevelIndex::flush();
+
   return levelset;
 }
 
@@ -126,6 +127,8 @@ Levelset::from_file(Pathname const& pathname)
       }
     }
 
+    LevelIndex::flush();
+
     levelset->refresh();
 
     return levelset;
@@ -185,7 +188,7 @@ Levelset::add_level(std::string const& resname, bool accessible)
     auto level = std::make_unique<Level>();
 
     level->resname    = resname;
-    level->plf        = PLFResMgr::load_plf(level->resname);
+    level->info       = LevelIndex::get(level->resname);
 
     level->accessible = accessible;
     level->finished   = false;
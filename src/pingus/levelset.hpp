@@ -18,7 +18,7 @@
 #define HEADER_PINGUS_PINGUS_LEVELSET_HPP
 
 #include "engine/display/sprite.hpp"
-#include "pingus/pingus_level.hpp"
+#include "pingus/level_index.hpp"
 #include "util/pathname.hpp"
 
 namespace pingus {
@@ -31,13 +31,16 @@ public:
     std::string resname;
     bool accessible;
     bool finished;
-    PingusLevel plf;
+
+    /** The head of the level, the level itself is only loaded once
+        it gets played */
+    LevelInfo info;
 
     Level() :
       resname(),
       accessible(),
       finished(),
-      plf()
+      info()
     {}
   };
 
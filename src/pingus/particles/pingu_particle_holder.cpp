@@ -16,8 +16,11 @@
 
 #include "pingus/particles/pingu_particle_holder.hpp"
 
+#include <cmath>
+
 #include "engine/display/scene_context.hpp"
 #include "pingus/collision_map.hpp"
+#include "pingus/savestate.hpp"
 #include "pingus/world.hpp"
 
 namespace pingus::particles {
@@ -25,13 +28,26 @@ namespace pingus::particles {
 const float x_collision_decrease = 0.3f;
 const float y_collision_decrease = 0.6f;
 
+PinguParticleHolder::PinguParticle::PinguParticle() :
+  livetime(),
+  use_frame2(),
+  pos(),
+  velocity()
+{
+}
+
 PinguParticleHolder::PinguParticle::PinguParticle (int x, int y)
-  : livetime(50 + (rand() % 75)),
-    use_frame2((rand() % 5) == 0),
+  : livetime(),
+    use_frame2(),
     pos(static_cast<float>(x), static_cast<float>(y)),
-    velocity(Math::frand() * 7 - 3.5f,
-             Math::frand() * -9)
+    velocity()
 {
+  // one statement per draw, so the order is the same on every compiler
+  Random& random = WorldObj::get_world()->get_random();
+  livetime   = 50 + random.rand(75);
+  use_frame2 = random.rand(5) == 0;
+  velocity.x = random.frand() * 7 - 3.5f;
+  velocity.y = random.frand() * -9;
 }
 
 PinguParticleHolder::PinguParticleHolder() :
@@ -73,78 +89,54 @@ PinguParticleHolder::update()
     if (!it->livetime)
       continue;
 
-    float tmp_x_add = 0.0f;
-    float tmp_y_add = 0.0f;
+    CollisionMap const* colmap = world->get_colmap();
 
     // Simulated gravity
     it->velocity.y += WorldObj::get_world()->get_gravity();
 
-    if (it->velocity.y > 0)
-    {
-      for (tmp_y_add = it->velocity.y; tmp_y_add >= 1.0f; --tmp_y_add)
-      {
-        if (world->get_colmap()->getpixel(static_cast<int>(it->pos.x), static_cast<int>(it->pos.y)))
-        {
-          it->velocity.y *= -y_collision_decrease;
-          tmp_y_add = -tmp_y_add;
-          --it->pos.y;
-          break;
-        }
-        ++it->pos.y;
-      }
-      it->pos.y += tmp_y_add;
-    }
-    else
+    // Move the particle pixel by pixel, first along y then along x,
+    // and bounce it back from the first pixel that is in the way
+    for (int axis = 1; axis >= 0; --axis)
     {
-      for (tmp_y_add = it->velocity.y; tmp_y_add <= -1.0f; ++tmp_y_add)
-      {
-        if (world->get_colmap()->getpixel(static_cast<int>(it->pos.x), static_cast<int>(it->pos.y)))
-        {
-          it->velocity.y *= -y_collision_decrease;
-          tmp_y_add = -tmp_y_add;
-          ++it->pos.y;
-          break;
-        }
-        --it->pos.y;
-      }
-      it->pos.y += tmp_y_add;
-    }
+      float const velocity = it->velocity[axis];
+      float const dir = (velocity > 0) ? 1.0f : -1.0f;
+      int const steps = static_cast<int>(std::abs(velocity));
 
-    if (it->velocity.x > 0)
-    {
-      for (tmp_x_add = it->velocity.x; tmp_x_add >= 1.0f; --tmp_x_add)
-      {
-        if (world->get_colmap()->getpixel(static_cast<int>(it->pos.x), static_cast<int>(it->pos.y)))
-        {
-          it->velocity.x *= -x_collision_decrease;
-          tmp_x_add = -tmp_x_add;
-          --it->pos.x;
-          break;
-        }
-        ++it->pos.x;
-      }
-      it->pos.x += tmp_x_add;
-    }
-    else
-    {
-      for (tmp_x_add = it->velocity.x; tmp_x_add <= -1.0f; ++tmp_x_add)
+      glm::vec2 step(0.0f, 0.0f);
+      step[axis] = dir;
+
+      CollisionMap::RayHit const hit = colmap->raycast(it->pos, step, steps);
+      it->pos = hit.pos;
+
+      // the fraction of the velocity that is left after the whole
+      // pixels got used up
+      float rest = velocity - dir * static_cast<float>(hit.steps);
+      if (hit.type != Groundtype::GP_NOTHING)
       {
-        if (world->get_colmap()->getpixel(static_cast<int>(it->pos.x), static_cast<int>(it->pos.y)))
-        {
-          it->velocity.x *= -x_collision_decrease;
-          tmp_x_add = -tmp_x_add;
-          ++it->pos.x;
-          break;
-        }
-        --it->pos.x;
+        it->velocity[axis] *= -(axis == 1 ? y_collision_decrease : x_collision_decrease);
+        rest = -rest;
+        it->pos[axis] -= dir;
       }
-      it->pos.x += tmp_x_add;
+      it->pos[axis] += rest;
     }
 
     --it->livetime;
   }
 }
 
+void
+PinguParticleHolder::sync_state(SavestateStream& stream)
+{
+  stream.sync_size(particles);
+  for (PinguParticle& particle : particles)
+  {
+    stream.sync(particle.livetime);
+    stream.sync(particle.use_frame2);
+    stream.sync(particle.pos);
+    stream.sync(particle.velocity);
+  }
+}
+
 void
 PinguParticleHolder::draw (SceneContext& gc)
 {
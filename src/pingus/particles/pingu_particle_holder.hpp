@@ -38,6 +38,7 @@ class PinguParticleHolder : public WorldObj
     /// The velocity of the particle
     glm::vec2 velocity;
 
+    PinguParticle();
     PinguParticle (int x, int y);
   };
 
@@ -57,6 +58,7 @@ public:
 
   /// Let the particle move
   void update() override;
+  void sync_state(SavestateStream& stream) override;
 
   /// Draw the particle with the correct zoom resize
   void draw (SceneContext& gc) override;
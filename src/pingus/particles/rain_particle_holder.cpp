@@ -19,10 +19,22 @@
 #include "engine/display/scene_context.hpp"
 #include "pingus/collision_map.hpp"
 #include "pingus/globals.hpp"
+#include "pingus/savestate.hpp"
 #include "pingus/world.hpp"
 
 namespace pingus::particles {
 
+RainParticleHolder::RainParticle::RainParticle() :
+  alive(),
+  splash(),
+  use_rain2_surf(),
+  splash_counter(),
+  splash_frame(),
+  pos(),
+  xy_mod()
+{
+}
+
 RainParticleHolder::RainParticle::RainParticle(int x, int y) :
   alive(true),
   splash(false),
@@ -32,8 +44,9 @@ RainParticleHolder::RainParticle::RainParticle(int x, int y) :
   pos(static_cast<float>(x), static_cast<float>(y)),
   xy_mod()
 {
-  use_rain2_surf = ((rand() % 3) == 0);
-  xy_mod = 1.0f + Math::frand() * 3.0f;
+  Random& random = WorldObj::get_world()->get_random();
+  use_rain2_surf = (random.rand(3) == 0);
+  xy_mod = 1.0f + random.frand() * 3.0f;
 }
 
 RainParticleHolder::RainParticleHolder() :
@@ -84,7 +97,7 @@ RainParticleHolder::update()
     {
       if ( world->get_colmap()->getpixel(static_cast<int>(it->pos.x), static_cast<int>(it->pos.y)) != Groundtype::GP_NOTHING
            && world->get_colmap()->getpixel(static_cast<int>(it->pos.x), static_cast<int>(it->pos.y)) != Groundtype::GP_OUTOFSCREEN
-           && ((rand() % 2) == 0))
+           && (world->get_random().rand(2) == 0))
       {
         it->splash = true;
       }
@@ -104,6 +117,22 @@ RainParticleHolder::update()
 
 }
 
+void
+RainParticleHolder::sync_state(SavestateStream& stream)
+{
+  stream.sync_size(particles);
+  for (RainParticle& particle : particles)
+  {
+    stream.sync(particle.alive);
+    stream.sync(particle.splash);
+    stream.sync(particle.use_rain2_surf);
+    stream.sync(particle.splash_counter);
+    stream.sync(particle.splash_frame);
+    stream.sync(particle.pos);
+    stream.sync(particle.xy_mod);
+  }
+}
+
 void
 RainParticleHolder::draw (SceneContext& gc)
 {
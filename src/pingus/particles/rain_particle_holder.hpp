@@ -40,6 +40,7 @@ class RainParticleHolder : public WorldObj
     // a modificator for x and y pos
     float xy_mod;
 
+    RainParticle();
     RainParticle(int x, int y);
   };
 
@@ -62,6 +63,7 @@ public:
 
   /// Let the particle move
   void update() override;
+  void sync_state(SavestateStream& stream) override;
 
   /// Draw the particle with the correct zoom resize
   void draw (SceneContext& gc) override;
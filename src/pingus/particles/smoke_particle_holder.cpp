@@ -17,9 +17,20 @@
 #include "pingus/particles/smoke_particle_holder.hpp"
 
 #include "engine/display/scene_context.hpp"
+#include "pingus/savestate.hpp"
+#include "pingus/world.hpp"
 
 namespace pingus::particles {
 
+SmokeParticleHolder::SmokeParticle::SmokeParticle() :
+  time(),
+  livetime(),
+  use_surf2(),
+  pos(),
+  velocity()
+{
+}
+
 SmokeParticleHolder::SmokeParticle::SmokeParticle (float x, float y, float vel_x, float vel_y) :
   time(),
   livetime(),
@@ -27,8 +38,9 @@ SmokeParticleHolder::SmokeParticle::SmokeParticle (float x, float y, float vel_x
   pos(x,y),
   velocity(vel_x, vel_y)
 {
-  time = livetime = 25 + (rand() % 10);
-  use_surf2 = rand() % 2;
+  Random& random = WorldObj::get_world()->get_random();
+  time = livetime = 25 + random.rand(10);
+  use_surf2 = random.rand(2);
 }
 
 SmokeParticleHolder::SmokeParticleHolder()
@@ -69,6 +81,20 @@ SmokeParticleHolder::update()
   }
 }
 
+void
+SmokeParticleHolder::sync_state(SavestateStream& stream)
+{
+  stream.sync_size(particles);
+  for (SmokeParticle& particle : particles)
+  {
+    stream.sync(particle.time);
+    stream.sync(particle.livetime);
+    stream.sync(particle.use_surf2);
+    stream.sync(particle.pos);
+    stream.sync(particle.velocity);
+  }
+}
+
 void
 SmokeParticleHolder::draw (SceneContext& gc)
 {
@@ -36,6 +36,7 @@ class SmokeParticleHolder : public WorldObj
     Vector2f pos;
     glm::vec2 velocity;
 
+    SmokeParticle();
     SmokeParticle(float x, float y, float vel_x, float vel_y);
   };
 
@@ -57,6 +58,7 @@ public:
 
   /// Let the particle move
   void update() override;
+  void sync_state(SavestateStream& stream) override;
 
   /// Draw the particle with the correct zoom resize
   void draw (SceneContext& gc) override;
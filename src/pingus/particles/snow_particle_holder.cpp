@@ -19,18 +19,31 @@
 #include "engine/display/scene_context.hpp"
 #include "pingus/collision_map.hpp"
 #include "pingus/ground_map.hpp"
+#include "pingus/savestate.hpp"
 #include "pingus/world.hpp"
 
 namespace pingus::particles {
 
+SnowParticleHolder::SnowParticle::SnowParticle() :
+  alive(),
+  colliding(),
+  type(SnowParticleHolder::Snow1),
+  pos(),
+  velocity()
+{
+}
+
 SnowParticleHolder::SnowParticle::SnowParticle (int x, int y, bool colliding_) :
   alive(true),
   colliding(colliding_),
   type(SnowParticleHolder::Snow1),
   pos(static_cast<float>(x),static_cast<float>(y)),
-  velocity(0.0f, 1 + (Math::frand() * 3.5f))
+  velocity(0.0f, 0.0f)
 {
-  switch (rand() % 10)
+  Random& random = WorldObj::get_world()->get_random();
+  velocity.y = 1 + (random.frand() * 3.5f);
+
+  switch (random.rand(10))
   {
     case 0:
       type = SnowParticleHolder::Snow1;
@@ -95,7 +108,7 @@ SnowParticleHolder::update()
       continue;
     }
 
-    it->velocity.x += (Math::frand() - 0.5f) / 10;
+    it->velocity.x += (world->get_random().frand() - 0.5f) / 10;
     if (it->colliding)
     {
       int pixel = world->get_colmap()->getpixel(static_cast<int>(it->pos.x()), static_cast<int>(it->pos.y()));
@@ -110,6 +123,20 @@ SnowParticleHolder::update()
   }
 }
 
+void
+SnowParticleHolder::sync_state(SavestateStream& stream)
+{
+  stream.sync_size(particles);
+  for (SnowParticle& particle : particles)
+  {
+    stream.sync(particle.alive);
+    stream.sync(particle.colliding);
+    stream.sync(particle.type);
+    stream.sync(particle.pos);
+    stream.sync(particle.velocity);
+  }
+}
+
 void
 SnowParticleHolder::draw (SceneContext& gc)
 {
@@ -40,6 +40,7 @@ private:
     Vector2f     pos;
     glm::vec2    velocity;
 
+    SnowParticle();
     SnowParticle(int x, int y, bool colliding_);
   };
 
@@ -67,6 +68,7 @@ public:
 
   /// Let the particle move
   void update() override;
+  void sync_state(SavestateStream& stream) override;
 
   /// Draw the particle with the correct zoom resize
   void draw (SceneContext& gc) override;
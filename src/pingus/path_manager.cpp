@@ -16,21 +16,79 @@
 
 #include "pingus/path_manager.hpp"
 
+#include <algorithm>
+#include <filesystem>
 #include <sstream>
+#include <thread>
 
 #include <logmich/log.hpp>
 
 #include "pingus/globals.hpp"
+#include "util/archive.hpp"
 #include "util/pathname.hpp"
 #include "util/system.hpp"
 
 namespace pingus {
 
+namespace {
+
+/** The root index used for files in the archive */
+size_t const archive_root = static_cast<size_t>(-1);
+
+struct RootIndex
+{
+  std::vector<std::string> files;
+  std::vector<std::string> directories;
+};
+
+RootIndex scan_root(std::string const& root)
+{
+  RootIndex index;
+
+  std::filesystem::path const root_path(root);
+  std::error_code ec;
+  std::filesystem::recursive_directory_iterator it(root_path,
+                                                   std::filesystem::directory_options::follow_directory_symlink |
+                                                   std::filesystem::directory_options::skip_permission_denied,
+                                                   ec);
+  for (; !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec))
+  {
+    std::string relative_path = it->path().lexically_relative(root_path).generic_string();
+
+    std::error_code type_ec;
+    if (it->is_directory(type_ec))
+    {
+      index.directories.push_back(std::move(relative_path));
+    }
+    else
+    {
+      index.files.push_back(std::move(relative_path));
+    }
+  }
+
+  if (ec)
+  {
+    log_warn("PathManager: couldn't scan '{}': {}", root, ec.message());
+  }
+
+  return index;
+}
+
+} // namespace
+
 PathManager g_path_manager;
 
+char const* const PathManager::archive_name = "resources.pack";
+
 PathManager::PathManager() :
   m_base_path(),
-  m_paths()
+  m_paths(),
+  m_mutex(),
+  m_indexed(false),
+  m_files(),
+  m_directories(),
+  m_archive(),
+  m_archive_filename()
 {
 }
 
@@ -41,17 +99,354 @@ PathManager::~PathManager()
 void
 PathManager::add_overlay_path(std::string const& path)
 {
+  std::lock_guard<std::mutex> lock(m_mutex);
   m_paths.push_back(System::normalize_path(path));
+  m_indexed = false;
 }
 
 void
 PathManager::set_path(std::string const& path)
 {
+  std::lock_guard<std::mutex> lock(m_mutex);
   m_base_path = path;
+  m_indexed = false;
+}
+
+void
+PathManager::refresh()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_indexed = false;
 }
 
 std::string
 PathManager::complete(std::string const& relative_path)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  std::string key;
+  if (!make_key(relative_path, key))
+  {
+    return complete_uncached(relative_path);
+  }
+
+  update_index();
+
+  auto it = m_files.find(key);
+  if (it != m_files.end())
+  {
+    // the normalized path, "sub/../file" would fail when "sub/" is
+    // missing in the root that has "file"
+    std::string result = Pathname::join(get_root(it->second), key);
+    if (!relative_path.empty() && relative_path.back() == '/' &&
+        !result.empty() && result.back() != '/')
+    {
+      result += '/';
+    }
+    return result;
+  }
+  else
+  {
+    return Pathname::join(m_base_path, relative_path);
+  }
+}
+
+bool
+PathManager::exist(std::string const& relative_path)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  std::string key;
+  if (!make_key(relative_path, key))
+  {
+    return System::exist(complete_uncached(relative_path));
+  }
+
+  update_index();
+
+  return m_files.find(key) != m_files.end();
+}
+
+std::vector<std::string>
+PathManager::opendir(std::string const& relative_path)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  std::string key;
+  if (!make_key(relative_path, key))
+  {
+    std::vector<std::string> result;
+    try
+    {
+      System::Directory lst = System::opendir(complete_uncached(relative_path));
+      for (auto const& entry : lst)
+      {
+        result.push_back(entry.name);
+      }
+    }
+    catch(std::exception const& err)
+    {
+      log_info("{}", err.what());
+    }
+    return result;
+  }
+
+  update_index();
+
+  auto it = m_directories.find(key);
+  if (it != m_directories.end())
+  {
+    return it->second;
+  }
+  else
+  {
+    return {};
+  }
+}
+
+std::vector<std::string>
+PathManager::opendir_recursive(std::string const& relative_path)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  std::string key;
+  if (!make_key(relative_path, key))
+  {
+    std::vector<std::string> result = System::opendir_recursive(complete_uncached(relative_path));
+    std::string const root = System::normalize_path(m_base_path);
+    if (!root.empty())
+    {
+      for (std::string& path : result)
+      {
+        if (path.compare(0, root.size() + 1, root + "/") == 0)
+          path.erase(0, root.size() + 1);
+      }
+    }
+    return result;
+  }
+
+  update_index();
+
+  std::vector<std::string> result;
+  std::vector<std::string> pending{ key };
+  while (!pending.empty())
+  {
+    std::string const dir = std::move(pending.back());
+    pending.pop_back();
+
+    auto it = m_directories.find(dir);
+    if (it == m_directories.end())
+      continue;
+
+    for (std::string const& name : it->second)
+    {
+      std::string path = dir.empty() ? name : dir + "/" + name;
+      if (m_directories.find(path) != m_directories.end())
+      {
+        pending.push_back(std::move(path));
+      }
+      else
+      {
+        result.push_back(std::move(path));
+      }
+    }
+  }
+  return result;
+}
+
+bool
+PathManager::find_in_archive(std::string const& relative_path, std::string_view& data_out)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  std::string key;
+  if (!make_key(relative_path, key))
+  {
+    return false;
+  }
+
+  update_index();
+
+  auto it = m_files.find(key);
+  return (it != m_files.end() &&
+          it->second == archive_root &&
+          m_archive->find(key, data_out));
+}
+
+void
+PathManager::update_index()
+{
+  if (m_indexed)
+    return;
+
+  // scan all roots at once, they are usually on different disks or
+  // directories that are cold in the cache
+  std::vector<std::string> roots;
+  roots.push_back(m_base_path);
+  roots.insert(roots.end(), m_paths.begin(), m_paths.end());
+
+  std::vector<RootIndex> indices(roots.size());
+  {
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < roots.size(); ++i)
+    {
+      threads.emplace_back([&roots, &indices, i] { indices[i] = scan_root(roots[i]); });
+    }
+    for (std::thread& thread : threads)
+    {
+      thread.join();
+    }
+  }
+
+  m_files.clear();
+  m_directories.clear();
+  m_files[""] = 0;
+  m_directories[""];
+
+  std::string const archive_filename = Pathname::join(m_base_path, archive_name);
+  if (archive_filename != m_archive_filename)
+  {
+    m_archive_filename = archive_filename;
+    m_archive.reset();
+
+    std::error_code ec;
+    if (std::filesystem::exists(archive_filename, ec))
+    {
+      try
+      {
+        m_archive = std::make_unique<Archive>(archive_filename);
+      }
+      catch(std::exception const& err)
+      {
+        log_error("PathManager: {}", err.what());
+      }
+    }
+  }
+
+  // later roots override earlier ones, the archive comes right after
+  // the datadir
+  for (size_t i = 0; i < indices.size(); ++i)
+  {
+    for (std::string const& dir : indices[i].directories)
+    {
+      m_files[dir] = i;
+      m_directories[dir];
+    }
+
+    for (std::string const& file : indices[i].files)
+    {
+      m_files[file] = i;
+    }
+
+    if (i == 0 && m_archive)
+    {
+      // a loose file that got edited after the archive was packed
+      // wins, otherwise the edit would silently be ignored
+      std::error_code ec;
+      auto const archive_mtime = std::filesystem::last_write_time(m_archive_filename, ec);
+      int newer = 0;
+
+      for (std::string const& file : m_archive->get_paths())
+      {
+        auto loose = m_files.find(file);
+        if (loose != m_files.end() && loose->second == 0)
+        {
+          std::error_code file_ec;
+          auto const mtime = std::filesystem::last_write_time(Pathname::join(m_base_path, file), file_ec);
+          if (ec || file_ec || mtime > archive_mtime)
+          {
+            newer += 1;
+            continue;
+          }
+        }
+
+        m_files[file] = archive_root;
+
+        for (std::string::size_type slash = file.find('/'); slash != std::string::npos;
+             slash = file.find('/', slash + 1))
+        {
+          std::string const dir = file.substr(0, slash);
+          m_files.emplace(dir, archive_root);
+          m_directories[dir];
+        }
+      }
+
+      if (newer)
+      {
+        log_warn("PathManager: {} files in '{}' are newer than {}, using them instead, "
+                 "rerun extra/pingus-pack to update it", newer, m_base_path, archive_name);
+      }
+    }
+  }
+
+  for (auto const& file : m_files)
+  {
+    if (file.first.empty())
+      continue;
+
+    std::string::size_type const slash = file.first.rfind('/');
+    if (slash == std::string::npos)
+    {
+      m_directories[""].push_back(file.first);
+    }
+    else
+    {
+      m_directories[file.first.substr(0, slash)].push_back(file.first.substr(slash + 1));
+    }
+  }
+
+  for (auto& dir : m_directories)
+  {
+    std::sort(dir.second.begin(), dir.second.end());
+  }
+
+  log_info("PathManager: indexed {} files in {} roots", m_files.size(), roots.size());
+
+  m_indexed = true;
+}
+
+bool
+PathManager::make_key(std::string const& relative_path, std::string& key) const
+{
+  if (m_base_path.empty() && m_paths.empty())
+  {
+    // no datadir, paths are relative to the working directory
+    return false;
+  }
+
+  if (relative_path.find("./") != std::string::npos ||
+      relative_path.find("//") != std::string::npos ||
+      (!relative_path.empty() && relative_path.back() == '.'))
+  {
+    key = System::normalize_path(relative_path);
+  }
+  else
+  {
+    key = relative_path;
+  }
+
+  while (!key.empty() && key.back() == '/')
+  {
+    key.pop_back();
+  }
+
+  if (key == ".")
+  {
+    key.clear();
+  }
+
+  // absolute paths and paths leaving the roots aren't in the index
+  return (key.empty() || key[0] != '/') && key.compare(0, 2, "..") != 0;
+}
+
+std::string const&
+PathManager::get_root(size_t idx) const
+{
+  return (idx == 0 || idx == archive_root) ? m_base_path : m_paths[idx - 1];
+}
+
+std::string
+PathManager::complete_uncached(std::string const& relative_path) const
 {
   for(auto it = m_paths.rbegin(); it != m_paths.rend(); ++it)
   {
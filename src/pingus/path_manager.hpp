@@ -18,21 +18,56 @@
 #define HEADER_PINGUS_PINGUS_PATH_MANAGER_HPP
 
 #include <list>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace pingus {
 
+class Archive;
+
+/** Resolves paths relative to the datadir to the file in the datadir
+    or in the overlay that takes precedence. The datadir and the
+    overlays are scanned once on first use, lookups are then answered
+    from an index without touching the filesystem. Files created or
+    removed later are only seen after refresh().
+
+    A resources.pack archive in the datadir, as written by
+    extra/pingus-pack, takes precedence over the loose files of the
+    datadir, but not over the overlays. Loose files that are newer
+    than the archive are used instead of their packed copy. */
 class PathManager
 {
 private:
   std::string m_base_path;
   std::vector<std::string> m_paths;
 
+  /** Guards the index, lookups can come from any thread */
+  mutable std::mutex m_mutex;
+  bool m_indexed;
+
+  /** The root each file and directory is found in, by the normalized
+      relative path, 0 is the datadir, 1 the first overlay and so on */
+  std::unordered_map<std::string, size_t> m_files;
+
+  /** The sorted names in each directory, merged over all roots */
+  std::unordered_map<std::string, std::vector<std::string> > m_directories;
+
+  /** The archive of the datadir, it is kept across refresh(), so the
+      data handed out by find_in_archive() stays valid */
+  std::unique_ptr<Archive> m_archive;
+  std::string m_archive_filename;
+
 public:
   PathManager();
   ~PathManager();
 
+  /** The name of the resource archive in the datadir */
+  static char const* const archive_name;
+
   /** Adds an overlay path, overlay path are search and used instead
       of the main datadir when a file is found in the same relative
       location */
@@ -48,6 +83,40 @@ public:
   /** Complete a releative path to the absolute path, the returned
       path contains a trailing slash */
   std::string complete(std::string const& relative_path);
+
+  /** @return true if the file or directory exists in any root */
+  bool exist(std::string const& relative_path);
+
+  /** @return the names in the directory, merged over all roots */
+  std::vector<std::string> opendir(std::string const& relative_path);
+
+  /** @return the relative paths of all files below the directory */
+  std::vector<std::string> opendir_recursive(std::string const& relative_path);
+
+  /** @return true if the file is served from the resource archive,
+      data_out then views its content */
+  bool find_in_archive(std::string const& relative_path, std::string_view& data_out);
+
+  /** Scan the datadir and the overlays again, needed after files in
+      them got created or removed */
+  void refresh();
+
+private:
+  /** Build the index if it isn't up to date, m_mutex must be held */
+  void update_index();
+
+  /** @return the index key for relative_path, or false if it can't be
+      answered from the index and has to go to the filesystem */
+  bool make_key(std::string const& relative_path, std::string& key) const;
+
+  /** @return the path of the given root */
+  std::string const& get_root(size_t idx) const;
+
+  std::string complete_uncached(std::string const& relative_path) const;
+
+private:
+  PathManager(PathManager const&);
+  PathManager& operator=(PathManager const&);
 };
 
 extern PathManager g_path_manager;
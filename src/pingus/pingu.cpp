@@ -16,6 +16,8 @@
 
 #include "pingus/pingu.hpp"
 
+#include <algorithm>
+#include <iterator>
 #include <sstream>
 #include <utility>
 
@@ -25,9 +27,13 @@
 #include "pingus/collision_map.hpp"
 #include "pingus/fonts.hpp"
 #include "pingus/globals.hpp"
+#include "pingus/pingu_action_pool.hpp"
+#include "pingus/pingu_grid.hpp"
 #include "pingus/world.hpp"
 #include "pingus/worldobj.hpp"
 #include "pingus/pingu_enums.hpp"
+#include "pingus/savestate.hpp"
+#include "util/raise_exception.hpp"
 
 #include "pingus/actions/angel.hpp"
 #include "pingus/actions/basher.hpp"
@@ -56,11 +62,13 @@ using namespace pingus::actions;
 namespace pingus {
 
 // Init a pingu at the given position while falling
-Pingu::Pingu(unsigned int arg_id, Vector2f const& arg_pos, int owner) :
-  action(),
-  countdown_action(),
-  wall_action(),
-  fall_action(),
+Pingu::Pingu(unsigned int arg_id, Vector2f const& arg_pos, int owner, PinguActionPool& pool) :
+  action_pool(pool),
+  action(nullptr),
+  action_type(ActionName::FALLER),
+  countdown_action(nullptr),
+  wall_action(nullptr),
+  fall_action(nullptr),
   previous_action(ActionName::FALLER),
   id(arg_id),
   action_time(-1),
@@ -69,6 +77,7 @@ Pingu::Pingu(unsigned int arg_id, Vector2f const& arg_pos, int owner) :
   pos_x(arg_pos.x()),
   pos_y(arg_pos.y()),
   velocity(0, 0),
+  grid(nullptr),
   direction()
 {
   direction.left();
@@ -80,6 +89,34 @@ Pingu::Pingu(unsigned int arg_id, Vector2f const& arg_pos, int owner) :
 
 Pingu::~Pingu()
 {
+  destroy_actions();
+}
+
+void
+Pingu::destroy_actions()
+{
+  PinguAction* const acts[] = { action, countdown_action, wall_action, fall_action };
+  action = countdown_action = wall_action = fall_action = nullptr;
+
+  for (size_t i = 0; i < std::size(acts); ++i)
+  {
+    // destroy each action only once, even if multiple slots refer to it
+    if (acts[i] && std::find(acts, acts + i, acts[i]) == acts + i)
+      action_pool.destroy(acts[i]);
+  }
+}
+
+void
+Pingu::release_action(PinguAction* act)
+{
+  if (act &&
+      act != action &&
+      act != countdown_action &&
+      act != wall_action &&
+      act != fall_action)
+  {
+    action_pool.destroy(act);
+  }
 }
 
 unsigned int
@@ -99,12 +136,16 @@ void
 Pingu::set_x (float x)
 {
   pos_x = x;
+  if (grid)
+    grid->update(this);
 }
 
 void
 Pingu::set_y (float y)
 {
   pos_y = y;
+  if (grid)
+    grid->update(this);
 }
 
 void
@@ -150,7 +191,7 @@ Pingu::request_set_action(ActionName::Enum action_name)
     switch (PinguAction::get_activation_mode(action_name))
     {
       case INSTANT:
-        if (action_name == action->get_type())
+        if (action_name == action_type)
         {
           log_debug("Pingu: Already have action");
           ret_val = false;
@@ -177,7 +218,9 @@ Pingu::request_set_action(ActionName::Enum action_name)
         else
         {
           log_debug("Setting wall action");
+          PinguAction* old_action = wall_action;
           wall_action = create_action(action_name);
+          release_action(old_action);
           ret_val = true;
         }
         break;
@@ -191,7 +234,9 @@ Pingu::request_set_action(ActionName::Enum action_name)
         else
         {
           log_debug("Setting fall action");
+          PinguAction* old_action = fall_action;
           fall_action = create_action(action_name);
+          release_action(old_action);
           ret_val = true;
         }
         break;
@@ -207,9 +252,10 @@ Pingu::request_set_action(ActionName::Enum action_name)
 
           log_debug("Setting countdown action");
           // We set the action and start the countdown
-          std::shared_ptr<PinguAction> act = create_action(action_name);
-          action_time = act->activation_time();
-          countdown_action = act;
+          PinguAction* old_action = countdown_action;
+          countdown_action = create_action(action_name);
+          action_time = countdown_action->activation_time();
+          release_action(old_action);
           ret_val = true;
         }
         break;
@@ -233,13 +279,18 @@ Pingu::set_action (ActionName::Enum action_name)
 
 // Sets an action without any checking
 void
-Pingu::set_action(std::shared_ptr<PinguAction> act)
+Pingu::set_action(PinguAction* act)
 {
   assert(act);
 
-  previous_action = action->get_type();
+  previous_action = action_type;
 
-  action = std::move(act);
+  // like before the old action is gone right away, so an action that
+  // replaces itself must not touch its members afterwards
+  PinguAction* old_action = action;
+  action = act;
+  action_type = act->get_type();
+  release_action(old_action);
 }
 
 bool
@@ -333,13 +384,115 @@ Pingu::update()
   if (action_time == 0 && countdown_action)
   {
     set_action(countdown_action);
-    // Reset the countdown action handlers
-    countdown_action = std::shared_ptr<PinguAction>();
+    // Reset the countdown action handlers, the action itself lives on
+    // in the action slot
+    countdown_action = nullptr;
     action_time = -1;
     return;
   }
 
-  action->update();
+  update_action();
+}
+
+void
+Pingu::sync_state(SavestateStream& stream)
+{
+  // a slot either holds its own action or shares the action of an
+  // earlier slot, which is stored as the index of that slot
+  PinguAction** const slots[] = { &action, &countdown_action, &wall_action, &fall_action };
+
+  if (stream.is_reading())
+    destroy_actions();
+
+  for (size_t i = 0; i < std::size(slots); ++i)
+  {
+    int shared = -1;
+    int type = -1;
+
+    if (!stream.is_reading() && *slots[i])
+    {
+      for (size_t j = 0; j < i && shared == -1; ++j)
+      {
+        if (*slots[j] == *slots[i])
+          shared = static_cast<int>(j);
+      }
+
+      if (shared == -1)
+        type = (*slots[i])->get_type();
+    }
+
+    stream.sync(shared);
+    stream.sync(type);
+
+    if (shared != -1)
+    {
+      if (shared < 0 || static_cast<size_t>(shared) >= i)
+        raise_exception(std::runtime_error, "invalid action slot " << shared);
+
+      *slots[i] = *slots[shared];
+    }
+    else if (type != -1)
+    {
+      if (stream.is_reading())
+      {
+        // constructors might move the pingu, the position is restored
+        // below
+        if (type >= 0 && type <= ActionName::WALKER)
+          *slots[i] = try_create_action(static_cast<ActionName::Enum>(type));
+
+        if (!*slots[i])
+          raise_exception(std::runtime_error, "invalid action type " << type);
+      }
+
+      (*slots[i])->sync_state(stream);
+    }
+  }
+
+  if (!action)
+    raise_exception(std::runtime_error, "pingu without action");
+
+  action_type = action->get_type();
+
+  stream.sync(previous_action);
+  stream.sync(action_time);
+  stream.sync(status);
+  stream.sync(pos_x);
+  stream.sync(pos_y);
+  stream.sync(velocity);
+  stream.sync(direction);
+}
+
+void
+Pingu::update_action()
+{
+  // Call update() on the concrete class, the action classes are
+  // final, so these are direct calls the compiler can inline, instead
+  // of an indirect call through the vtable for every pingu
+  switch (action_type)
+  {
+    case ActionName::ANGEL:     static_cast<Angel*>(action)->update();     break;
+    case ActionName::BASHER:    static_cast<Basher*>(action)->update();    break;
+    case ActionName::BLOCKER:   static_cast<Blocker*>(action)->update();   break;
+    case ActionName::BOARDER:   static_cast<Boarder*>(action)->update();   break;
+    case ActionName::BOMBER:    static_cast<Bomber*>(action)->update();    break;
+    case ActionName::BRIDGER:   static_cast<Bridger*>(action)->update();   break;
+    case ActionName::CLIMBER:   static_cast<Climber*>(action)->update();   break;
+    case ActionName::DIGGER:    static_cast<Digger*>(action)->update();    break;
+    case ActionName::DROWN:     static_cast<Drown*>(action)->update();     break;
+    case ActionName::EXITER:    static_cast<Exiter*>(action)->update();    break;
+    case ActionName::FALLER:    static_cast<Faller*>(action)->update();    break;
+    case ActionName::FLOATER:   static_cast<Floater*>(action)->update();   break;
+    case ActionName::JUMPER:    static_cast<Jumper*>(action)->update();    break;
+    case ActionName::LASERKILL: static_cast<LaserKill*>(action)->update(); break;
+    case ActionName::MINER:     static_cast<Miner*>(action)->update();     break;
+    case ActionName::SLIDER:    static_cast<Slider*>(action)->update();    break;
+    case ActionName::SMASHED:   static_cast<Smashed*>(action)->update();   break;
+    case ActionName::SPLASHED:  static_cast<Splashed*>(action)->update();  break;
+    case ActionName::SUPERMAN:  static_cast<Superman*>(action)->update();  break;
+    case ActionName::WAITER:    static_cast<Waiter*>(action)->update();    break;
+    case ActionName::WALKER:    static_cast<Walker*>(action)->update();    break;
+    default:                    action->update();                          break;
+  }
 }
 
 // Draws the pingu on the screen with the given offset
@@ -398,7 +551,7 @@ Pingu::get_name()
 ActionName::Enum
 Pingu::get_action()
 {
-  return action->get_type();
+  return action_type;
 }
 
 void
@@ -407,7 +560,7 @@ Pingu::apply_force (glm::vec2 const& arg_v)
   velocity += arg_v;
   // Moving the pingu on pixel up, so that the force can take effect
   // FIXME: this should be handled by a state-machine
-  pos_y -= 1;
+  set_y(pos_y - 1);
 }
 
 Vector2f
@@ -442,33 +595,41 @@ Pingu::catchable()
   return action->catchable();
 }
 
-std::shared_ptr<PinguAction>
+PinguAction*
 Pingu::create_action(ActionName::Enum action_)
+{
+  PinguAction* act = try_create_action(action_);
+  assert(act && "Invalid action name provied");
+  return act;
+}
+
+PinguAction*
+Pingu::try_create_action(ActionName::Enum action_)
 {
   switch(action_)
   {
-    case ActionName::ANGEL:     return std::make_shared<Angel>(this);
-    case ActionName::BASHER:    return std::make_shared<Basher>(this);
-    case ActionName::BLOCKER:   return std::make_shared<Blocker>(this);
-    case ActionName::BOARDER:   return std::make_shared<Boarder>(this);
-    case ActionName::BOMBER:    return std::make_shared<Bomber>(this);
-    case ActionName::BRIDGER:   return std::make_shared<Bridger>(this);
-    case ActionName::CLIMBER:   return std::make_shared<Climber>(this);
-    case ActionName::DIGGER:    return std::make_shared<Digger>(this);
-    case ActionName::DROWN:     return std::make_shared<Drown>(this);
-    case ActionName::EXITER:    return std::make_shared<Exiter>(this);
-    case ActionName::FALLER:    return std::make_shared<Faller>(this);
-    case ActionName::FLOATER:   return std::make_shared<Floater>(this);
-    case ActionName::JUMPER:    return std::make_shared<Jumper>(this);
-    case ActionName::LASERKILL: return std::make_shared<LaserKill>(this);
-    case ActionName::MINER:     return std::make_shared<Miner>(this);
-    case ActionName::SLIDER:    return std::make_shared<Slider>(this);
-    case ActionName::SMASHED:   return std::make_shared<Smashed>(this);
-    case ActionName::SPLASHED:  return std::make_shared<Splashed>(this);
-    case ActionName::SUPERMAN:  return std::make_shared<Superman>(this);
-    case ActionName::WAITER:    return std::make_shared<Waiter>(this);
-    case ActionName::WALKER:    return std::make_shared<Walker>(this);
-    default: assert(false && "Invalid action name provied"); return {};
+    case ActionName::ANGEL:     return action_pool.create<Angel>(ActionName::ANGEL, this);
+    case ActionName::BASHER:    return action_pool.create<Basher>(ActionName::BASHER, this);
+    case ActionName::BLOCKER:   return action_pool.create<Blocker>(ActionName::BLOCKER, this);
+    case ActionName::BOARDER:   return action_pool.create<Boarder>(ActionName::BOARDER, this);
+    case ActionName::BOMBER:    return action_pool.create<Bomber>(ActionName::BOMBER, this);
+    case ActionName::BRIDGER:   return action_pool.create<Bridger>(ActionName::BRIDGER, this);
+    case ActionName::CLIMBER:   return action_pool.create<Climber>(ActionName::CLIMBER, this);
+    case ActionName::DIGGER:    return action_pool.create<Digger>(ActionName::DIGGER, this);
+    case ActionName::DROWN:     return action_pool.create<Drown>(ActionName::DROWN, this);
+    case ActionName::EXITER:    return action_pool.create<Exiter>(ActionName::EXITER, this);
+    case ActionName::FALLER:    return action_pool.create<Faller>(ActionName::FALLER, this);
+    case ActionName::FLOATER:   return action_pool.create<Floater>(ActionName::FLOATER, this);
+    case ActionName::JUMPER:    return action_pool.create<Jumper>(ActionName::JUMPER, this);
+    case ActionName::LASERKILL: return action_pool.create<LaserKill>(ActionName::LASERKILL, this);
+    case ActionName::MINER:     return action_pool.create<Miner>(ActionName::MINER, this);
+    case ActionName::SLIDER:    return action_pool.create<Slider>(ActionName::SLIDER, this);
+    case ActionName::SMASHED:   return action_pool.create<Smashed>(ActionName::SMASHED, this);
+    case ActionName::SPLASHED:  return action_pool.create<Splashed>(ActionName::SPLASHED, this);
+    case ActionName::SUPERMAN:  return action_pool.create<Superman>(ActionName::SUPERMAN, this);
+    case ActionName::WAITER:    return action_pool.create<Waiter>(ActionName::WAITER, this);
+    case ActionName::WALKER:    return action_pool.create<Walker>(ActionName::WALKER, this);
+    default: return nullptr;
   }
 }
 
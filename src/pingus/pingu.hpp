@@ -17,7 +17,6 @@
 #ifndef HEADER_PINGUS_PINGUS_PINGU_HPP
 #define HEADER_PINGUS_PINGUS_PINGU_HPP
 
-#include <memory>
 #include <glm/glm.hpp>
 
 #include "math/vector2f.hpp"
@@ -43,18 +42,29 @@ public:
   enum PinguStatus { PS_ALIVE, PS_EXITED, PS_DEAD };
 
 private:
+  /** The pool all actions of this pingu are created from */
+  PinguActionPool& action_pool;
+
+  /* The action slots own their actions, a slot might refer to the
+     same action as another slot, e.g. a floater is both fall_action
+     and action while floating. An action gets destroyed once no slot
+     refers to it anymore, see release_action(). */
+
   /** The primary action which is currently in use */
-  std::shared_ptr<PinguAction> action;
+  PinguAction* action;
+
+  /** The type of action, cached as it is asked for all the time */
+  ActionName::Enum action_type;
 
   /** A secondary action which will turn active after a given amount of time
       The only example is currently the bomber. */
-  std::shared_ptr<PinguAction> countdown_action;
+  PinguAction* countdown_action;
 
   /** the action that gets triggered when the pingu hits a wall */
-  std::shared_ptr<PinguAction> wall_action;
+  PinguAction* wall_action;
 
   /** the action that gets triggered when the pingu falls */
-  std::shared_ptr<PinguAction> fall_action;
+  PinguAction* fall_action;
 
   /** The previous_action contains the action type that was in action
       before action got applied, its here to enable action to behave
@@ -79,10 +89,27 @@ private:
 
   glm::vec2 velocity;
 
+  /** The grid that indexes this pingu, informed on every position
+      change, nullptr when the pingu isn't active */
+  PinguGrid* grid;
+
 private:
-  void set_action(std::shared_ptr<PinguAction>);
+  void set_action(PinguAction*);
+
+  /** Run the update() of the current action */
+  void update_action();
 
-  std::shared_ptr<PinguAction> create_action(ActionName::Enum action);
+  PinguAction* create_action(ActionName::Enum action);
+
+  /** @return a new action of the given type, or nullptr if there is
+      no action class for it, e.g. for ActionName::TELEPORTED */
+  PinguAction* try_create_action(ActionName::Enum action);
+
+  /** Destroy act unless one of the action slots still refers to it */
+  void release_action(PinguAction* act);
+
+  /** Destroy the actions of all slots */
+  void destroy_actions();
 
 public:
 
@@ -92,8 +119,9 @@ public:
   /** Creates a new Pingu at the given coordinates
       @param arg_id The uniq id of the pingu
       @param pos The start position of the pingu
-      @param owner The owner id of the pingu (used for multiplayer) */
-  Pingu(unsigned int arg_id, Vector2f const& pos, int owner);
+      @param owner The owner id of the pingu (used for multiplayer)
+      @param pool The pool to create the actions from, must outlive the pingu */
+  Pingu(unsigned int arg_id, Vector2f const& pos, int owner, PinguActionPool& pool);
 
   /** Destruct the pingu... */
   ~Pingu();
@@ -146,6 +174,9 @@ public:
   /// Set the pingu to the given coordinates
   void set_pos (Vector2f const& arg_pos);
 
+  /** Used by PinguGrid to register itself with the pingu */
+  void set_grid(PinguGrid* grid_) { grid = grid_; }
+
   glm::vec2 get_velocity() const { return velocity; }
   void set_velocity (glm::vec2 const& velocity_);
 
@@ -168,9 +199,9 @@ public:
   /// set the fall action if we have one
   bool request_fall_action();
 
-  PinguAction* get_wall_action() { return wall_action.get(); }
+  PinguAction* get_wall_action() { return wall_action; }
 
-  PinguAction* get_fall_action() { return fall_action.get(); }
+  PinguAction* get_fall_action() { return fall_action; }
 
   /** Returns the `color' of the colmap in the walking direction
       Examples:
@@ -192,6 +223,10 @@ public:
 
   void update();
 
+  /** Store or restore the pingu together with its actions, id and
+      owner are set by the constructor and not part of the state */
+  void sync_state(SavestateStream& stream);
+
   /** Indicate if the pingu's speed is above the deadly velocity */
   //bool is_tumbling () const;
 
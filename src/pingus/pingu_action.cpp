@@ -54,8 +54,19 @@ int
 PinguAction::rel_getpixel (int x, int y)
 {
   // FIXME: Inline me
-  return WorldObj::get_world()->get_colmap()->getpixel(static_cast<int>(pingu->get_x() + static_cast<float>((x * pingu->direction))),
-                                                       static_cast<int>(pingu->get_y() - static_cast<float>(y)));
+  return WorldObj::get_world()->get_colmap()->getpixel(rel_x(x), rel_y(y));
+}
+
+int
+PinguAction::rel_x (int x) const
+{
+  return static_cast<int>(pingu->get_x() + static_cast<float>((x * pingu->direction)));
+}
+
+int
+PinguAction::rel_y (int y) const
+{
+  return static_cast<int>(pingu->get_y() - static_cast<float>(y));
 }
 
 char
@@ -76,21 +87,12 @@ PinguAction::head_collision_on_walk (int x, int y)
 bool
 PinguAction::collision_on_walk (int x, int y)
 {
-  bool collision = false;
-  int pixel = Groundtype::GP_NOTHING;
-
-  for (int pingu_y = 0; pingu_y <= pingu_height; ++pingu_y)
-  {
-    pixel = rel_getpixel(x, y + pingu_y);
-
-    if (pixel != Groundtype::GP_NOTHING && pixel != Groundtype::GP_BRIDGE)
-    {
-      collision = true;
-      break;
-    }
-  }
-
-  return collision;
+  // the pingu covers the rows from its feet at y up to its head at
+  // y + pingu_height, bridges are no obstacle
+  return !WorldObj::get_world()->get_colmap()->is_clear(rel_x(x),
+                                                         rel_y(y + pingu_height),
+                                                         rel_y(y) + 1,
+                                                         Groundtype::GP_BRIDGE);
 }
 
 std::string
@@ -57,12 +57,21 @@ public:
   */
   int  rel_getpixel (int x, int y);
 
+  /** @return the colmap coordinates that rel_getpixel() would use for
+      the relative position x, y */
+  int rel_x (int x) const;
+  int rel_y (int y) const;
+
   /** Checks if this action allows to be overwritten with the given new action */
   virtual bool change_allowed (ActionName::Enum action) { return true; }
 
   /// The "AI" of the pingu.
   virtual void update() = 0;
 
+  /** Store or restore the members that change during update(), the
+      action gets created by its constructor before it is restored */
+  virtual void sync_state(SavestateStream& stream) {}
+
   /** Draws the action */
   virtual void draw (SceneContext& gc) =0;
 
@@ -0,0 +1,60 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "pingus/pingu_action_pool.hpp"
+
+#include <logmich/log.hpp>
+
+namespace pingus {
+
+PinguActionPool::PinguActionPool() :
+  free_blocks(),
+  num_blocks(0)
+{
+}
+
+PinguActionPool::~PinguActionPool()
+{
+  int num_free = 0;
+  for (std::vector<void*>& blocks : free_blocks)
+  {
+    for (void* mem : blocks)
+    {
+      ::operator delete(mem);
+    }
+    num_free += static_cast<int>(blocks.size());
+  }
+
+  if (num_free != num_blocks)
+  {
+    log_error("{} actions still alive on destruction", num_blocks - num_free);
+  }
+}
+
+void
+PinguActionPool::destroy(PinguAction* action)
+{
+  // neither the type nor the address of the complete object are
+  // available once the destructor ran
+  ActionName::Enum const type = action->get_type();
+  void* mem = dynamic_cast<void*>(action);
+  action->~PinguAction();
+  free_blocks[type].push_back(mem);
+}
+
+} // namespace pingus
+
+/* EOF */
@@ -0,0 +1,96 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_PINGUS_PINGUS_PINGU_ACTION_POOL_HPP
+#define HEADER_PINGUS_PINGUS_PINGU_ACTION_POOL_HPP
+
+#include <array>
+#include <assert.h>
+#include <new>
+#include <vector>
+
+#include "pingus/action_name.hpp"
+#include "pingus/pingu_action.hpp"
+
+namespace pingus {
+
+/** Recycles the memory of PinguActions, pingus switch between walker
+    and faller all the time and would otherwise allocate a new action
+    on each switch. Each action type gets its own free list, as each
+    type is implemented by exactly one class, all blocks in a list
+    have the same size. The pool must outlive all actions created
+    from it.
+
+    @brief Free lists for PinguAction objects */
+class PinguActionPool
+{
+private:
+  std::array<std::vector<void*>, ActionName::WALKER + 1> free_blocks;
+
+  /** Number of blocks allocated from the heap, used to check for
+      leaks on destruction */
+  int num_blocks;
+
+public:
+  PinguActionPool();
+  ~PinguActionPool();
+
+  /** Construct an action of class T, which has to implement the
+      action type, in a recycled block */
+  template<typename T>
+  PinguAction* create(ActionName::Enum type, Pingu* pingu)
+  {
+    std::vector<void*>& blocks = free_blocks[type];
+
+    void* mem;
+    if (blocks.empty())
+    {
+      mem = ::operator new(sizeof(T));
+      num_blocks += 1;
+    }
+    else
+    {
+      mem = blocks.back();
+      blocks.pop_back();
+    }
+
+    try
+    {
+      PinguAction* action = new (mem) T(pingu);
+      assert(action->get_type() == type);
+      return action;
+    }
+    catch(...)
+    {
+      blocks.push_back(mem);
+      throw;
+    }
+  }
+
+  /** Destroy the action and keep its memory for the next action of
+      the same type */
+  void destroy(PinguAction* action);
+
+private:
+  PinguActionPool(PinguActionPool const&);
+  PinguActionPool& operator=(PinguActionPool const&);
+};
+
+} // namespace pingus
+
+#endif
+
+/* EOF */
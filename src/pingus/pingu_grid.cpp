@@ -0,0 +1,184 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "pingus/pingu_grid.hpp"
+
+#include <algorithm>
+#include <assert.h>
+
+#include "pingus/pingu.hpp"
+
+namespace pingus {
+
+PinguGrid::PinguGrid(int width, int height, int cell_size_) :
+  cell_size(cell_size_),
+  columns(std::max(1, (width  + cell_size_ - 1) / cell_size_)),
+  rows   (std::max(1, (height + cell_size_ - 1) / cell_size_)),
+  cells(static_cast<size_t>(columns * rows)),
+  pingu_cell()
+{
+  assert(cell_size > 0);
+}
+
+int
+PinguGrid::cell_x(float x) const
+{
+  // written so that NaN ends up in the first cell as well
+  if (!(x >= 0.0f))
+    return 0;
+  else if (x >= static_cast<float>(columns * cell_size))
+    return columns - 1;
+  else
+    return static_cast<int>(x) / cell_size;
+}
+
+int
+PinguGrid::cell_y(float y) const
+{
+  if (!(y >= 0.0f))
+    return 0;
+  else if (y >= static_cast<float>(rows * cell_size))
+    return rows - 1;
+  else
+    return static_cast<int>(y) / cell_size;
+}
+
+int
+PinguGrid::cell_index(Pingu const* pingu) const
+{
+  return cell_y(pingu->get_y()) * columns + cell_x(pingu->get_x());
+}
+
+void
+PinguGrid::add(Pingu* pingu)
+{
+  unsigned int const id = pingu->get_id();
+  if (id >= pingu_cell.size())
+    pingu_cell.resize(id + 1, -1);
+
+  assert(pingu_cell[id] == -1);
+
+  int const cell = cell_index(pingu);
+  cells[static_cast<size_t>(cell)].push_back(pingu);
+  pingu_cell[id] = cell;
+
+  pingu->set_grid(this);
+}
+
+void
+PinguGrid::remove(Pingu* pingu)
+{
+  int& cell = pingu_cell[pingu->get_id()];
+  assert(cell != -1);
+
+  std::vector<Pingu*>& bucket = cells[static_cast<size_t>(cell)];
+  auto it = std::find(bucket.begin(), bucket.end(), pingu);
+  assert(it != bucket.end());
+  *it = bucket.back();
+  bucket.pop_back();
+
+  cell = -1;
+  pingu->set_grid(nullptr);
+}
+
+void
+PinguGrid::clear()
+{
+  for (std::vector<Pingu*>& bucket : cells)
+  {
+    for (Pingu* pingu : bucket)
+    {
+      pingu->set_grid(nullptr);
+    }
+    bucket.clear();
+  }
+
+  pingu_cell.clear();
+}
+
+void
+PinguGrid::update(Pingu* pingu)
+{
+  int& cell = pingu_cell[pingu->get_id()];
+  int const new_cell = cell_index(pingu);
+
+  if (new_cell != cell)
+  {
+    std::vector<Pingu*>& bucket = cells[static_cast<size_t>(cell)];
+    auto it = std::find(bucket.begin(), bucket.end(), pingu);
+    assert(it != bucket.end());
+    *it = bucket.back();
+    bucket.pop_back();
+
+    cells[static_cast<size_t>(new_cell)].push_back(pingu);
+    cell = new_cell;
+  }
+}
+
+void
+PinguGrid::query_rect(float x1, float y1, float x2, float y2, std::vector<Pingu*>& result) const
+{
+  result.clear();
+
+  int const cx1 = cell_x(x1);
+  int const cx2 = cell_x(x2);
+  int const cy1 = cell_y(y1);
+  int const cy2 = cell_y(y2);
+
+  for (int cy = cy1; cy <= cy2; ++cy)
+  {
+    for (int cx = cx1; cx <= cx2; ++cx)
+    {
+      for (Pingu* pingu : cells[static_cast<size_t>(cy * columns + cx)])
+      {
+        if (pingu->get_x() >= x1 && pingu->get_x() <= x2 &&
+            pingu->get_y() >= y1 && pingu->get_y() <= y2)
+        {
+          result.push_back(pingu);
+        }
+      }
+    }
+  }
+
+  // cells are unordered, but callers expect the update order of the
+  // PinguHolder, otherwise traps would resolve differently than
+  // before and break demos
+  std::sort(result.begin(), result.end(),
+            [](Pingu const* lhs, Pingu const* rhs) {
+              return lhs->get_id() < rhs->get_id();
+            });
+}
+
+void
+PinguGrid::query_radius(Vector2f const& pos, float radius, std::vector<Pingu*>& result) const
+{
+  query_rect(pos.x() - radius, pos.y() - radius,
+             pos.x() + radius, pos.y() + radius,
+             result);
+
+  float const radius2 = radius * radius;
+  result.erase(std::remove_if(result.begin(), result.end(),
+                              [&](Pingu const* pingu) {
+                                float const dx = pingu->get_x() - pos.x();
+                                float const dy = pingu->get_y() - pos.y();
+                                return dx * dx + dy * dy > radius2;
+                              }),
+               result.end());
+}
+
+} // namespace pingus
+
+/* EOF */
@@ -0,0 +1,90 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_PINGUS_PINGUS_PINGU_GRID_HPP
+#define HEADER_PINGUS_PINGUS_PINGU_GRID_HPP
+
+#include <vector>
+
+#include "math/vector2f.hpp"
+
+namespace pingus {
+
+class Pingu;
+
+/** A uniform grid over the world that buckets the active pingus by
+    their position, so that traps and blockers only have to look at
+    the pingus near them instead of at all of them. Pingus outside of
+    the world are kept in the border cells. The grid is updated
+    incrementally whenever a pingu changes its position, so queries
+    are always exact.
+
+    @brief Spatial index for pingu proximity queries */
+class PinguGrid
+{
+private:
+  int cell_size;
+  int columns;
+  int rows;
+
+  /** The pingus in each cell, in no particular order */
+  std::vector<std::vector<Pingu*> > cells;
+
+  /** The cell of each pingu, indexed by pingu id, -1 if the pingu
+      isn't in the grid */
+  std::vector<int> pingu_cell;
+
+public:
+  /** @param width, height  the size of the world
+      @param cell_size      the edge length of a cell in pixel */
+  PinguGrid(int width, int height, int cell_size = 64);
+
+  /** Insert a pingu, the pingu will keep the grid informed about
+      its position changes until it gets removed */
+  void add(Pingu* pingu);
+
+  /** Remove a pingu from the grid, used when it dies or exits */
+  void remove(Pingu* pingu);
+
+  /** Move the pingu into the cell matching its current position */
+  void update(Pingu* pingu);
+
+  /** Remove all pingus from the grid */
+  void clear();
+
+  /** Collect the pingus whose position lies inside the given
+      rectangle, borders included. The result is ordered by id, which
+      is the order in which the PinguHolder updates them. */
+  void query_rect(float x1, float y1, float x2, float y2, std::vector<Pingu*>& result) const;
+
+  /** Collect the pingus whose position is at most radius away from
+      pos, ordered by id */
+  void query_radius(Vector2f const& pos, float radius, std::vector<Pingu*>& result) const;
+
+private:
+  int cell_x(float x) const;
+  int cell_y(float y) const;
+  int cell_index(Pingu const* pingu) const;
+
+  PinguGrid(PinguGrid const&);
+  PinguGrid& operator=(PinguGrid const&);
+};
+
+} // namespace pingus
+
+#endif
+
+/* EOF */
@@ -16,24 +16,31 @@
 
 #include "pingus/pingu_holder.hpp"
 
+#include <algorithm>
+#include <memory>
+
 #include "pingus/pingu.hpp"
 #include "pingus/pingus_level.hpp"
+#include "pingus/savestate.hpp"
+#include "util/raise_exception.hpp"
 
 namespace pingus {
 
 PinguHolder::PinguHolder(PingusLevel const& plf) :
   number_of_allowed(plf.get_number_of_pingus()),
   number_of_exited(0),
+  action_pool(),
+  pingu_storage(),
   all_pingus(),
-  pingus()
+  pingus(),
+  grid(plf.get_size().width(), plf.get_size().height()),
+  profiling(false),
+  action_profiles()
 {
 }
 
 PinguHolder::~PinguHolder()
 {
-  for(std::vector<Pingu*>::iterator i = all_pingus.begin();
-      i != all_pingus.end(); ++i)
-    delete *i;
 }
 
 Pingu*
@@ -43,13 +50,13 @@ PinguHolder::create_pingu (Vector2f const& pos, int owner_id)
   {
     // We use all_pingus.size() as pingu_id, so that id == array
     // index
-    Pingu* pingu = new Pingu(static_cast<unsigned int>(all_pingus.size()), pos, owner_id);
+    Pingu* pingu = make_pingu(static_cast<unsigned int>(all_pingus.size()), pos, owner_id);
 
-    // This list will deleted
     all_pingus.push_back (pingu);
 
     // This list holds the active pingus
     pingus.push_back(pingu);
+    grid.add(pingu);
 
     return pingu;
   }
@@ -59,16 +66,31 @@ PinguHolder::create_pingu (Vector2f const& pos, int owner_id)
   }
 }
 
+Pingu*
+PinguHolder::make_pingu(unsigned int id, Vector2f const& pos, int owner_id)
+{
+  if (id < pingu_storage.size())
+  {
+    // left over from before a savestate got loaded, it is constructed
+    // anew in the same place, so that pointers to it stay valid
+    Pingu* pingu = &pingu_storage[id];
+    std::destroy_at(pingu);
+    return std::construct_at(pingu, id, pos, owner_id, action_pool);
+  }
+  else
+  {
+    return &pingu_storage.emplace_back(id, pos, owner_id, action_pool);
+  }
+}
+
 void
 PinguHolder::draw (SceneContext& gc)
 {
   // Draw all walkers
-  for(std::list<Pingu*>::iterator pingu = pingus.begin();
-      pingu != pingus.end();
-      ++pingu)
+  for (Pingu* pingu : pingus)
   {
-    if ((*pingu)->get_action() == ActionName::WALKER)
-      (*pingu)->draw (gc);
+    if (pingu->get_action() == ActionName::WALKER)
+      pingu->draw (gc);
   }
 
   // Draw all non-walkers, so that they are easier spotable
@@ -78,42 +100,116 @@ PinguHolder::draw (SceneContext& gc)
   // FIMME: uglyness. Either we rip this code out again or fix the
   // FIXME: bridger so that it looks higher and better with walkers
   // FIXME: behind him.
-  for(std::list<Pingu*>::iterator pingu = pingus.begin();
-      pingu != pingus.end();
-      ++pingu)
+  for (Pingu* pingu : pingus)
   {
-    if ((*pingu)->get_action() != ActionName::WALKER)
-      (*pingu)->draw (gc);
+    if (pingu->get_action() != ActionName::WALKER)
+      pingu->draw (gc);
   }
 }
 
 void
 PinguHolder::update()
 {
-  PinguIter pingu = pingus.begin();
-
-  while(pingu != pingus.end())
+  // Pingus are removed right away and in order, as the remaining
+  // pingus see the vector while they update (e.g. blockers) and the
+  // update order is part of the game logic that demos depend on
+  size_t i = 0;
+  while (i < pingus.size())
   {
-    (*pingu)->update();
+    Pingu* pingu = pingus[i];
 
-    // FIXME: The draw-loop is not the place for things like this,
-    // this belongs in the update loop
-    if ((*pingu)->get_status() == Pingu::PS_DEAD)
+    if (profiling)
     {
-      // Removing the dead pingu and setting the iterator back to
-      // the correct possition, no memory hole since pingus will
-      // keep track of the allocated Pingus
-      pingu = pingus.erase(pingu);
+      // the time is booked to the action the update started with
+      ActionProfile& profile = action_profiles[pingu->get_action()];
+      auto const start = std::chrono::steady_clock::now();
+      pingu->update();
+      profile.time += std::chrono::steady_clock::now() - start;
+      profile.updates += 1;
     }
-    else if ((*pingu)->get_status() == Pingu::PS_EXITED)
+    else
+    {
+      pingu->update();
+    }
+
+    if (pingu->get_status() == Pingu::PS_DEAD)
+    {
+      grid.remove(pingu);
+      pingus.erase(pingus.begin() + static_cast<std::ptrdiff_t>(i));
+    }
+    else if (pingu->get_status() == Pingu::PS_EXITED)
     {
       number_of_exited += 1;
-      pingu = pingus.erase(pingu);
+      grid.remove(pingu);
+      pingus.erase(pingus.begin() + static_cast<std::ptrdiff_t>(i));
     }
     else
     {
-      // move to the next Pingu
-      ++pingu;
+      ++i;
+    }
+  }
+}
+
+void
+PinguHolder::sync_state(SavestateStream& stream)
+{
+  stream.sync(number_of_exited);
+
+  uint64_t count = all_pingus.size();
+  stream.sync(count);
+
+  if (stream.is_reading())
+  {
+    if (count > static_cast<uint64_t>(std::max(0, number_of_allowed)))
+      raise_exception(std::runtime_error, "more pingus than allowed: " << count);
+
+    grid.clear();
+    pingus.clear();
+    all_pingus.clear();
+  }
+
+  for (unsigned int id = 0; id < count; ++id)
+  {
+    int owner_id = stream.is_reading() ? 0 : all_pingus[id]->get_owner();
+    stream.sync(owner_id);
+
+    if (stream.is_reading())
+    {
+      all_pingus.push_back(make_pingu(id, Vector2f(), owner_id));
+    }
+
+    all_pingus[id]->sync_state(stream);
+  }
+
+  // the ids of the active pingus in update order
+  std::vector<unsigned int> active_ids;
+  for (Pingu* pingu : pingus)
+  {
+    active_ids.push_back(pingu->get_id());
+  }
+
+  stream.sync_size(active_ids);
+  for (unsigned int& id : active_ids)
+  {
+    stream.sync(id);
+  }
+
+  if (stream.is_reading())
+  {
+    // pingus released after the state was taken stay in the storage
+    // until their id is used again, someone might still point to them
+    for (size_t id = all_pingus.size(); id < pingu_storage.size(); ++id)
+    {
+      pingu_storage[id].set_status(Pingu::PS_DEAD);
+    }
+
+    for (unsigned int id : active_ids)
+    {
+      if (id >= all_pingus.size())
+        raise_exception(std::runtime_error, "invalid pingu id " << id);
+
+      pingus.push_back(all_pingus[id]);
+      grid.add(all_pingus[id]);
     }
   }
 }
@@ -138,6 +234,22 @@ PinguHolder::get_pingu(unsigned int id_) const
   }
 }
 
+std::vector<Pingu*>
+PinguHolder::query_rect(float x1, float y1, float x2, float y2) const
+{
+  std::vector<Pingu*> result;
+  grid.query_rect(x1, y1, x2, y2, result);
+  return result;
+}
+
+std::vector<Pingu*>
+PinguHolder::query_radius(Vector2f const& pos, float radius) const
+{
+  std::vector<Pingu*> result;
+  grid.query_radius(pos, radius, result);
+  return result;
+}
+
 float
 PinguHolder::z_index() const
 {
@@ -17,21 +17,35 @@
 #ifndef HEADER_PINGUS_PINGUS_PINGU_HOLDER_HPP
 #define HEADER_PINGUS_PINGUS_PINGU_HOLDER_HPP
 
-#include <list>
-
+#include <array>
+#include <chrono>
+#include <deque>
+#include <span>
+#include <vector>
+
+#include "pingus/pingu.hpp"
+#include "pingus/pingu_action_pool.hpp"
+#include "pingus/pingu_grid.hpp"
 #include "pingus/worldobj.hpp"
 #include "math/vector2f.hpp"
 
 namespace pingus {
 
 class PingusLevel;
-class Pingu;
-
-typedef std::list<Pingu*>::iterator PinguIter;
 
 /** This class holds all the penguins in the world */
 class PinguHolder : public WorldObj
 {
+public:
+  /** The time spent in the updates of one action type */
+  struct ActionProfile
+  {
+    int updates = 0;
+    std::chrono::nanoseconds time = {};
+  };
+
+  using ActionProfiles = std::array<ActionProfile, ActionName::WALKER + 1>;
+
 private:
   /** The total number of pingus that will get released in this
       level */
@@ -42,13 +56,28 @@ private:
       each time they are requested. */
   int number_of_exited;
 
-  /** This vector holds all pingus which are ever allocated in the
-      world, its used to free them all on the end of this class. */
+  /** Recycles the actions of all pingus, declared before the storage
+      so that it outlives the pingus */
+  PinguActionPool action_pool;
+
+  /** Storage for all pingus which are ever allocated in the world,
+      a deque never moves its elements, so pointers stay valid, even
+      across loading a savestate */
+  std::deque<Pingu> pingu_storage;
+
+  /** All pingus ever released, indexed by their id */
   std::vector<Pingu*> all_pingus;
 
-  /** A list holding all Pingus, the PinguHolder itself has only the
-      active (not dead) ones */
-  std::list<Pingu*> pingus;
+  /** The active (not dead or exited) pingus in update order */
+  std::vector<Pingu*> pingus;
+
+  /** Spatial index over the active pingus */
+  PinguGrid grid;
+
+  /** Measure the time spent per action type, off by default as the
+      clock isn't free */
+  bool profiling;
+  ActionProfiles action_profiles;
 
 public:
   PinguHolder(PingusLevel const&);
@@ -63,6 +92,10 @@ public:
       PinguAction::update()) */
   void update() override;
 
+  /** Store or restore all pingus, when reading the pingus get
+      recreated, so pointers to them become invalid */
+  void sync_state(SavestateStream& stream) override;
+
   /** The z-pos at which the pingus gets draw.
       @return 50 */
   float z_index() const override;
@@ -107,12 +140,32 @@ public:
   /** @return the id of the last pingu + 1 */
   unsigned int get_end_id() const;
 
-  // FIXME: Dirty cruft, needs cleanup
-  std::list<Pingu*>::iterator  begin() { return pingus.begin(); }
-  std::list<Pingu*>::iterator  end()   { return pingus.end(); }
-  std::list<Pingu*>::size_type size()  { return pingus.size(); }
+  /** @return the active pingus in update order, the span becomes
+      invalid when pingus are created or removed, so it must not be
+      kept across updates */
+  std::span<Pingu* const> get_active() const { return pingus; }
+
+  /** Start or stop measuring the time spent per action type */
+  void set_profiling(bool value) { profiling = value; }
+
+  /** @return the time spent per action type, indexed by
+      ActionName::Enum, only filled while profiling is enabled */
+  ActionProfiles const& get_action_profiles() const { return action_profiles; }
+
+  /** @return the active pingus whose position lies inside the given
+      rectangle, borders included, in update order. Callers are
+      expected to keep their own exact test, this only narrows down
+      the candidates. */
+  std::vector<Pingu*> query_rect(float x1, float y1, float x2, float y2) const;
+
+  /** @return the active pingus whose position is at most radius away
+      from pos, in update order */
+  std::vector<Pingu*> query_radius(Vector2f const& pos, float radius) const;
 
 private:
+  /** Construct the pingu with the given id in pingu_storage */
+  Pingu* make_pingu(unsigned int id, Vector2f const& pos, int owner_id);
+
   PinguHolder (PinguHolder const&);
   PinguHolder& operator= (PinguHolder const&);
 };
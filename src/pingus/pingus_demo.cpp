@@ -14,10 +14,15 @@
 // You should have received a copy of the GNU General Public License
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
+
 #include "pingus/pingus_demo.hpp"
 
+#include <limits>
 #include <stdexcept>
 
+#include <logmich/log.hpp>
+
+#include "pingus/demo_format.hpp"
 #include "util/reader.hpp"
 #include "util/pathname.hpp"
 #include "util/raise_exception.hpp"
@@ -27,7 +32,51 @@ namespace pingus {
 PingusDemo::PingusDemo(Pathname const& pathname) :
   m_levelname(),
   m_checksum(),
-  m_events()
+  m_seed(0),
+  m_binary(false),
+  m_version(0),
+  m_file(pathname.get_sys_path()),
+  m_events_start(0),
+  m_pos(0),
+  m_time(0),
+  m_events(),
+  m_next_event(0)
+{
+  if (demo_format::has_magic(m_file.data(), m_file.size()))
+  {
+    m_binary = true;
+    read_binary_header(pathname);
+  }
+  else
+  {
+    // the parser reads the file on its own
+    m_file = MappedFile();
+    read_text(pathname);
+  }
+}
+
+void
+PingusDemo::read_binary_header(Pathname const& pathname)
+{
+  m_pos = demo_format::magic_size;
+
+  if (m_pos >= m_file.size() ||
+      m_file.data()[m_pos] < 1 || m_file.data()[m_pos] > demo_format::version)
+  {
+    raise_exception(std::runtime_error, "'" << pathname.str() << "', unsupported demo version");
+  }
+  m_version = m_file.data()[m_pos];
+  m_pos += 1;
+
+  m_levelname = read_string();
+  m_checksum  = read_string();
+  m_seed      = read_uint32();
+
+  m_events_start = m_pos;
+}
+
+void
+PingusDemo::read_text(Pathname const& pathname)
 {
   auto lines = ReaderDocument::parse_many(pathname.get_sys_path());
 
@@ -46,6 +95,12 @@ PingusDemo::PingusDemo(Pathname const& pathname) :
       }
 
       reader.read("checksum", m_checksum);
+
+      int seed = 0;
+      if (reader.read("seed", seed))
+      {
+        m_seed = static_cast<uint32_t>(seed);
+      }
     }
 
     for(auto i = lines.begin() + 1; i != lines.end(); ++i)
@@ -58,6 +113,156 @@ PingusDemo::PingusDemo(Pathname const& pathname) :
   }
 }
 
+bool
+PingusDemo::read_event(ServerEvent& event)
+{
+  if (!m_binary)
+  {
+    if (m_next_event == m_events.size())
+      return false;
+
+    event = m_events[m_next_event++];
+    return true;
+  }
+
+  if (m_pos == m_file.size())
+    return false;
+
+  try
+  {
+    read_binary_event(event);
+    return true;
+  }
+  catch(std::exception const& err)
+  {
+    // the tail of a demo gets lost when the game crashes or the disk
+    // is full while recording, play back everything before it
+    log_warn("demo of '{}' is broken: {}, ending playback there", m_levelname, err.what());
+    m_pos = m_file.size();
+    return false;
+  }
+}
+
+void
+PingusDemo::read_binary_event(ServerEvent& event)
+{
+
+  int const type_bits = demo_format::type_bits(m_version);
+  uint64_t const head = read_varint();
+  uint64_t const delta = head >> type_bits;
+  uint64_t const type = head & ((1u << type_bits) - 1);
+  if (type > ServerEvent::CHECKPOINT_EVENT)
+  {
+    raise_exception(std::runtime_error, "invalid event type in demo at byte " << m_pos);
+  }
+
+  if (delta > static_cast<uint64_t>(std::numeric_limits<int>::max() - m_time))
+  {
+    raise_exception(std::runtime_error, "invalid time in demo at byte " << m_pos);
+  }
+
+  m_time += static_cast<int>(delta);
+
+  event = ServerEvent();
+  event.type = static_cast<ServerEvent::Type>(type);
+  event.time_stamp = m_time;
+
+  if (event.type == ServerEvent::PINGU_ACTION_EVENT)
+  {
+    uint64_t const packed = read_varint();
+    uint64_t const action = packed & ((1u << demo_format::action_bits) - 1);
+    if (action > ActionName::WALKER || (packed >> demo_format::action_bits) > UINT32_MAX)
+    {
+      raise_exception(std::runtime_error, "invalid pingu action in demo at byte " << m_pos);
+    }
+
+    event.pingu_id = static_cast<unsigned int>(packed >> demo_format::action_bits);
+    event.pingu_action = static_cast<ActionName::Enum>(action);
+
+    uint32_t x = read_uint32();
+    uint32_t y = read_uint32();
+    float fx;
+    float fy;
+    memcpy(&fx, &x, sizeof(fx));
+    memcpy(&fy, &y, sizeof(fy));
+    event.pos = Vector2f(fx, fy);
+  }
+  else if (event.type == ServerEvent::CHECKPOINT_EVENT)
+  {
+    uint64_t const low = read_uint32();
+    uint64_t const high = read_uint32();
+    event.state_hash = low | high << 32;
+  }
+}
+
+void
+PingusDemo::reset()
+{
+  m_pos = m_events_start;
+  m_time = 0;
+  m_next_event = 0;
+}
+
+std::vector<ServerEvent>
+PingusDemo::get_events()
+{
+  reset();
+
+  std::vector<ServerEvent> events;
+  ServerEvent event;
+  while (read_event(event))
+  {
+    events.push_back(event);
+  }
+
+  reset();
+  return events;
+}
+
+uint64_t
+PingusDemo::read_varint()
+{
+  uint64_t value;
+  if (!get_varint(m_file.data(), m_file.size(), m_pos, value))
+  {
+    if (m_pos >= m_file.size())
+      raise_exception(std::runtime_error, "unexpected end of demo");
+    else
+      raise_exception(std::runtime_error, "invalid varint in demo at byte " << m_pos);
+  }
+  return value;
+}
+
+uint32_t
+PingusDemo::read_uint32()
+{
+  if (m_file.size() - m_pos < 4)
+  {
+    raise_exception(std::runtime_error, "unexpected end of demo");
+  }
+
+  uint8_t const* p = m_file.data() + m_pos;
+  m_pos += 4;
+  return static_cast<uint32_t>(p[0]) |
+    static_cast<uint32_t>(p[1]) << 8 |
+    static_cast<uint32_t>(p[2]) << 16 |
+    static_cast<uint32_t>(p[3]) << 24;
+}
+
+std::string
+PingusDemo::read_string()
+{
+  uint64_t const size = read_varint();
+  if (size > m_file.size() - m_pos)
+  {
+    raise_exception(std::runtime_error, "unexpected end of demo");
+  }
+
+  std::string value(reinterpret_cast<char const*>(m_file.data() + m_pos), static_cast<size_t>(size));
+  m_pos += static_cast<size_t>(size);
+  return value;
+}
+
 } // namespace pingus
 
 /* EOF */
@@ -17,30 +17,85 @@
 #ifndef HEADER_PINGUS_PINGUS_PINGUS_DEMO_HPP
 #define HEADER_PINGUS_PINGUS_PINGUS_DEMO_HPP
 
+#include <stdint.h>
 #include <vector>
 
 #include "pingus/server_event.hpp"
+#include "util/mapped_file.hpp"
 
 namespace pingus {
 
 class Pathname;
 
+/** Reads a demo file, either in the binary format (see
+    demo_format.hpp) or as s-expressions. Binary demos are memory
+    mapped and decoded one event at a time, text demos are parsed as a
+    whole when opened. */
 class PingusDemo
 {
 private:
   std::string m_levelname;
   std::string m_checksum;
+  uint32_t m_seed;
+
+  bool m_binary;
+
+  /** Version of the binary format */
+  uint8_t m_version;
+
+  /** The file content of a binary demo */
+  MappedFile m_file;
+
+  /** Offset of the first event in m_file */
+  size_t m_events_start;
+
+  /** Read position in m_file */
+  size_t m_pos;
+
+  /** Time of the last event read from m_file */
+  int m_time;
+
+  /** The events of a text demo */
   std::vector<ServerEvent> m_events;
 
+  /** Index of the next event in m_events */
+  size_t m_next_event;
+
 public:
   PingusDemo(Pathname const& pathname);
 
   std::string get_levelname() const { return m_levelname; }
   std::string get_checksum() const { return m_checksum; }
 
-  std::vector<ServerEvent> get_events() const { return m_events; }
+  /** @return the seed of the World random number generator, 0 for old
+      demos that didn't record one */
+  uint32_t get_seed() const { return m_seed; }
+
+  bool is_binary() const { return m_binary; }
+
+  /** Read the next event, a broken binary demo ends at the first
+      event that can't be read
+
+      @return false when there are no more events */
+  bool read_event(ServerEvent& event);
+
+  /** Start reading from the first event again */
+  void reset();
+
+  /** @return all the events of the demo, resets the read position */
+  std::vector<ServerEvent> get_events();
 
 private:
+  void read_binary_header(Pathname const& pathname);
+  void read_text(Pathname const& pathname);
+
+  /** Decode the event at m_pos, throws if the data is broken */
+  void read_binary_event(ServerEvent& event);
+
+  uint64_t read_varint();
+  uint32_t read_uint32();
+  std::string read_string();
+
   PingusDemo (PingusDemo const&);
   PingusDemo& operator= (PingusDemo const&);
 };
@@ -16,18 +16,139 @@
 
 #include "pingus/pingus_level.hpp"
 
+#include <ctype.h>
+#include <sstream>
 #include <stdexcept>
+#include <string_view>
 
 #include <logmich/log.hpp>
 
 #include "pingus/globals.hpp"
 #include "pingus/pingus_level_impl.hpp"
+#include "util/mapped_file.hpp"
 #include "util/pathname.hpp"
 #include "util/raise_exception.hpp"
 #include "util/system.hpp"
 
 namespace pingus {
 
+namespace {
+
+/** @return the position of the first character at or after pos that
+    isn't whitespace or part of a comment */
+size_t skip_space(std::string_view text, size_t pos)
+{
+  while (pos < text.size())
+  {
+    if (isspace(static_cast<unsigned char>(text[pos])))
+    {
+      pos += 1;
+    }
+    else if (text[pos] == ';')
+    {
+      pos = text.find('\n', pos);
+      if (pos == std::string_view::npos)
+        return text.size();
+    }
+    else
+    {
+      break;
+    }
+  }
+  return pos;
+}
+
+/** @return the symbol starting at pos */
+std::string_view symbol_at(std::string_view text, size_t pos)
+{
+  size_t const end = text.find_first_of(" \t\r\n();\"", pos);
+  return text.substr(pos, end == std::string_view::npos ? std::string_view::npos : end - pos);
+}
+
+/** @return the position after the list starting at pos, or npos if
+    it isn't closed */
+size_t skip_list(std::string_view text, size_t pos)
+{
+  int depth = 0;
+  while (pos < text.size())
+  {
+    char const c = text[pos];
+    if (c == '"')
+    {
+      pos += 1;
+      while (pos < text.size() && text[pos] != '"')
+        pos += (text[pos] == '\\') ? 2 : 1;
+
+      if (pos >= text.size())
+        return std::string_view::npos;
+    }
+    else if (c == ';')
+    {
+      pos = text.find('\n', pos);
+      if (pos == std::string_view::npos)
+        return pos;
+    }
+    else if (c == '(')
+    {
+      depth += 1;
+    }
+    else if (c == ')')
+    {
+      depth -= 1;
+      if (depth == 0)
+        return pos + 1;
+    }
+    pos += 1;
+  }
+  return std::string_view::npos;
+}
+
+/** Copy the (pingus-level ...) in text to out, leaving out the
+    (objects ...) section, so that the head can be parsed without the
+    body, which makes up most of a level.
+
+    @return false if text isn't laid out like a level file */
+bool strip_objects(std::string_view text, std::string& out)
+{
+  size_t pos = skip_space(text, 0);
+  if (pos >= text.size() || text[pos] != '(')
+    return false;
+
+  pos = skip_space(text, pos + 1);
+  if (symbol_at(text, pos) != "pingus-level")
+    return false;
+
+  out = "(pingus-level";
+  pos += std::string_view("pingus-level").size();
+
+  while (true)
+  {
+    pos = skip_space(text, pos);
+    if (pos >= text.size())
+      return false;
+    else if (text[pos] == ')')
+      break;
+    else if (text[pos] != '(')
+      return false;
+
+    size_t const end = skip_list(text, pos);
+    if (end == std::string_view::npos)
+      return false;
+
+    if (symbol_at(text, skip_space(text, pos + 1)) != "objects")
+    {
+      out += ' ';
+      out.append(text.substr(pos, end - pos));
+    }
+    pos = end;
+  }
+
+  out += ')';
+  return true;
+}
+
+} // namespace
+
 PingusLevel::PingusLevel() :
   impl(new PingusLevelImpl())
 {
@@ -51,22 +172,55 @@ PingusLevel::get_checksum() const
   return impl->checksum;
 }
 
+size_t
+PingusLevel::get_file_size() const
+{
+  return impl->file_size;
+}
+
 void
 PingusLevel::load(std::string const& resname,
                   Pathname const& pathname)
 {
+  MappedFile file(pathname.get_sys_path());
+  std::string_view const text(reinterpret_cast<char const*>(file.data()), file.size());
+
+  // cached by the stamp of the file, so unchanged levels aren't
+  // hashed on every load
   impl->checksum = System::checksum(pathname);
+  impl->file_size = file.size();
 
   impl->resname = resname;
-  impl->doc = prio::ReaderDocument::from_file(pathname.get_sys_path());
+  impl->pathname = pathname;
 
-  if (impl->doc.get_name() != "pingus-level")
+  std::string head_text;
+  if (strip_objects(text, head_text))
+  {
+    std::istringstream in(head_text);
+    read_head(ReaderDocument::from_stream(in, pathname.get_sys_path()), pathname);
+    impl->text = text;
+    impl->objects_loaded = false;
+  }
+  else
+  {
+    // not laid out as expected, so parse everything right away
+    std::istringstream in{std::string(text)};
+    impl->doc = ReaderDocument::from_stream(in, pathname.get_sys_path());
+    read_head(impl->doc, pathname);
+    impl->doc.get_mapping().read("objects", impl->objects);
+  }
+}
+
+void
+PingusLevel::read_head(ReaderDocument const& doc, Pathname const& pathname)
+{
+  if (doc.get_name() != "pingus-level")
   {
     raise_exception(std::runtime_error, "Error: " << pathname.str() << ": not a 'pingus-level' file");
   }
   else
   {
-    ReaderMapping reader = impl->doc.get_mapping();
+    ReaderMapping reader = doc.get_mapping();
 
     int version;
     if (reader.read("version", version))
@@ -115,11 +269,23 @@ PingusLevel::load(std::string const& resname,
                         "Error: (pingus-level head actions) not found in '" << pathname.str() << "'");
       }
     }
-
-    reader.read("objects", impl->objects);
   }
 }
 
+void
+PingusLevel::load_objects() const
+{
+  log_info("loading objects: {}", impl->pathname.str());
+
+  // parsed from the content the head was read from, the file might
+  // have changed in the meantime
+  std::istringstream in(std::move(impl->text));
+  impl->text = std::string();
+  impl->doc = ReaderDocument::from_stream(in, impl->pathname.get_sys_path());
+  impl->doc.get_mapping().read("objects", impl->objects);
+  impl->objects_loaded = true;
+}
+
 std::string const&
 PingusLevel::get_levelname() const
 {
@@ -177,6 +343,11 @@ PingusLevel::get_music() const
 ReaderCollection const&
 PingusLevel::get_objects() const
 {
+  std::lock_guard<std::mutex> lock(impl->objects_mutex);
+  if (!impl->objects_loaded)
+  {
+    load_objects();
+  }
   return impl->objects;
 }
 
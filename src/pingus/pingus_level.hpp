@@ -41,6 +41,9 @@ public:
   /** Returns a short checksum for the level file */
   std::string get_checksum() const;
 
+  /** Returns the size of the level file in bytes */
+  size_t get_file_size() const;
+
   /** Returns the name of the current level, {\em not} the level file name. */
   std::string const& get_levelname() const;
 
@@ -74,7 +77,9 @@ public:
   /** Returns the light to be used in this level */
   Color const& get_ambient_light() const;
 
-  /** Returns the body of this file */
+  /** Returns the body of this file. Only the head is parsed when the
+      level is loaded, the body is parsed on the first call, from the
+      content the head was read from. */
   ReaderCollection const& get_objects() const;
 
   /** Return the 'resource name' of the level ('snow22-grumbel', etc. ) */
@@ -84,6 +89,13 @@ private:
   void load(std::string const& resname,
             Pathname const& pathname);
 
+  /** Read the metadata from the (head) of doc */
+  void read_head(ReaderDocument const& doc, Pathname const& pathname);
+
+  /** Parse the whole file and read the objects, needs to be called
+      with impl->objects_mutex locked */
+  void load_objects() const;
+
 protected:
   std::shared_ptr<PingusLevelImpl> impl;
 };
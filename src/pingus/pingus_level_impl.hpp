@@ -19,7 +19,10 @@
 
 #include "math/color.hpp"
 #include "math/size.hpp"
+#include "util/pathname.hpp"
+#include "util/reader.hpp"
 #include <map>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -32,6 +35,11 @@ public:
   PingusLevelImpl() :
     doc(),
     objects(),
+    objects_mutex(),
+    objects_loaded(true),
+    pathname(),
+    text(),
+    file_size(0),
     resname(),
     checksum(),
     levelname(),
@@ -46,9 +54,25 @@ public:
     music()
   {}
 
+  /** The document the objects are read from, only kept once the
+      objects got loaded */
   ReaderDocument doc;
   ReaderCollection objects;
 
+  /** The objects are parsed on the first call to
+      PingusLevel::get_objects(), which may come from several
+      threads */
+  std::mutex objects_mutex;
+  bool objects_loaded;
+
+  /** The file the level was loaded from */
+  Pathname pathname;
+
+  /** The content of the file, kept until the objects got parsed from
+      it, so that they always match the head */
+  std::string text;
+  size_t file_size;
+
   std::string resname;
 
   std::string checksum;
@@ -68,6 +92,10 @@ public:
 
   std::string author;
   std::string music;
+
+private:
+  PingusLevelImpl(PingusLevelImpl const&);
+  PingusLevelImpl& operator=(PingusLevelImpl const&);
 };
 
 } // namespace pingus
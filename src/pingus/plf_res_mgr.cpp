@@ -16,70 +16,168 @@
 
 #include "pingus/plf_res_mgr.hpp"
 
+#include <algorithm>
+#include <vector>
+
 #include <logmich/log.hpp>
 
 #include "pingus/globals.hpp"
+#include "util/file_watcher.hpp"
 #include "util/pathname.hpp"
 #include "util/system.hpp"
 
 namespace pingus {
 
+// the watcher is defined last so it gets destroyed first, its thread
+// calls back into the other members
+std::mutex PLFResMgr::mutex;
 PLFResMgr::PLFMap PLFResMgr::plf_map;
+size_t PLFResMgr::max_file_bytes = 16 * 1024 * 1024;
+size_t PLFResMgr::file_bytes = 0;
+uint64_t PLFResMgr::clock = 0;
+PLFResMgr::Stats PLFResMgr::stats = { 0, 0, 0, 0, 0, 0 };
+std::unique_ptr<FileWatcher> PLFResMgr::watcher;
 
 PingusLevel
 PLFResMgr::load_plf_raw(std::string const& res_name,
                         Pathname const& pathname)
 {
-  log_info("PLFResMgr: '{}' -> '{}'", res_name, pathname.str());
+  std::lock_guard<std::mutex> lock(mutex);
+
+  clock += 1;
 
   PLFMap::iterator i = plf_map.find(res_name);
+  if (i != plf_map.end())
+  { // File in cache is up to date, the watcher would have dropped it otherwise
+    log_debug("PLFResMgr: Loading level from CACHE: '{}'", res_name);
 
-  if (i == plf_map.end())
+    stats.hits += 1;
+    i->second.last_use = clock;
+    return i->second.plf;
+  }
+  else
   { // Entry not cached, so load it and add it to cache
     log_info("loading level from DISK: '{}' -> '{}'", res_name, pathname.str());
 
-    PingusLevel plf(res_name, pathname);
+    stats.misses += 1;
+
+    if (!watcher)
+    {
+      watcher = std::make_unique<FileWatcher>(&PLFResMgr::on_file_changed);
+    }
 
-    PLFEntry entry;
-    entry.plf   = plf;
-    entry.mtime = pathname.mtime();
+    // watch before loading, so that no change gets lost in between
+    std::string filename = pathname.get_sys_path();
+    watcher->watch(filename);
 
-    plf_map[res_name]  = entry;
+    PLFEntry entry{ PingusLevel(res_name, pathname), std::move(filename), clock };
+    file_bytes += entry.plf.get_file_size();
+    plf_map[res_name] = entry;
 
-    // FIXME: leaking pointers to the outsite work is not such a good
-    // idea, could lead to trouble sooner or later
+    evict();
 
     return entry.plf;
   }
-  else
+}
+
+void
+PLFResMgr::on_file_changed(std::string const& filename)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+
+  for (PLFMap::iterator it = plf_map.begin(); it != plf_map.end();)
   {
-    uint64_t current_mtime = pathname.mtime();
-    if (current_mtime != i->second.mtime)
+    if (filename.empty() || it->second.filename == filename)
     {
-      log_info("PLFResMgr: level changed on DISK, reloading: '{}' -> '{}'", res_name, pathname.str());
+      log_info("PLFResMgr: level changed on DISK: '{}'", it->second.filename);
 
-      // Reload the file since it has changed on disk
-      PingusLevel plf(res_name, pathname);
-      PLFEntry entry;
+      stats.invalidations += 1;
+      erase(it++);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+}
 
-      entry.plf   = plf;
-      entry.mtime = pathname.mtime();
+void
+PLFResMgr::erase(PLFMap::iterator it)
+{
+  std::string const filename = it->second.filename;
 
-      plf_map[res_name]  = entry;
+  file_bytes -= it->second.plf.get_file_size();
+  plf_map.erase(it);
 
-      // FIXME: leaking pointers to the outsite work is not such a good
-      // idea, could lead to trouble sooner or later
-      return entry.plf;
-    }
-    else
-    { // File in cache is up to date, everything is all ready, return it
-      log_info("PLFResMgr: Loading level from CACHE: '{}' -> '{}'", res_name, pathname.str());
+  if (watcher &&
+      std::none_of(plf_map.begin(), plf_map.end(),
+                   [&filename](auto const& entry) { return entry.second.filename == filename; }))
+  {
+    watcher->unwatch(filename);
+  }
+}
 
-      return i->second.plf;
-    }
+void
+PLFResMgr::evict()
+{
+  if (file_bytes <= max_file_bytes)
+    return;
+
+  std::vector<PLFMap::iterator> entries;
+  for (PLFMap::iterator it = plf_map.begin(); it != plf_map.end(); ++it)
+  {
+    entries.push_back(it);
+  }
+
+  std::sort(entries.begin(), entries.end(),
+            [](auto const& lhs, auto const& rhs) {
+              return lhs->second.last_use < rhs->second.last_use;
+            });
+
+  // the most recently used level stays, even when it is over budget
+  for (size_t i = 0; file_bytes > max_file_bytes && i + 1 < entries.size(); ++i)
+  {
+    log_debug("PLFResMgr: evicting '{}'", entries[i]->first);
+
+    stats.evictions += 1;
+    erase(entries[i]);
   }
 }
 
+void
+PLFResMgr::set_max_file_bytes(size_t max_file_bytes_)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+
+  max_file_bytes = max_file_bytes_;
+  evict();
+}
+
+void
+PLFResMgr::clear()
+{
+  std::unique_ptr<FileWatcher> old_watcher;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    plf_map.clear();
+    file_bytes = 0;
+    old_watcher = std::move(watcher);
+  }
+  // destroyed without the lock, its thread might be waiting for it
+}
+
+PLFResMgr::Stats
+PLFResMgr::get_stats()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+
+  Stats result = stats;
+  result.size = plf_map.size();
+  result.file_bytes = file_bytes;
+  return result;
+}
+
 PingusLevel
 PLFResMgr::load_plf_from_filename(Pathname const& pathname)
 {
@@ -17,33 +17,78 @@
 #ifndef HEADER_PINGUS_PINGUS_PLF_RES_MGR_HPP
 #define HEADER_PINGUS_PINGUS_PLF_RES_MGR_HPP
 
+#include <memory>
+#include <mutex>
+
 #include "pingus/pingus_level.hpp"
-#include <SDL.h>
 
 namespace pingus {
 
+class FileWatcher;
 class Pathname;
 
+/** Caches the loaded levels by their resource name. The level files
+    are watched for changes in the background, so a cache hit needs
+    no access to the filesystem. The cache is bounded by the size of
+    the level files, the least recently used level is dropped
+    first. */
 class PLFResMgr
 {
+public:
+  struct Stats
+  {
+    int hits;
+    int misses;
+    int evictions;
+
+    /** Levels dropped because their file changed */
+    int invalidations;
+
+    size_t size;
+
+    /** Size of the files the cached levels were loaded from */
+    size_t file_bytes;
+  };
+
 private:
   struct PLFEntry
   {
     PingusLevel plf;
-    uint64_t mtime;
 
-    PLFEntry() :
-      plf(),
-      mtime()
-    {}
+    /** The file the level was loaded from, as it is watched */
+    std::string filename;
+
+    uint64_t last_use;
   };
 
   typedef std::map<std::string, PLFEntry> PLFMap;
-  static  PLFMap plf_map;
+
+  static std::mutex mutex;
+  static PLFMap plf_map;
+  static std::unique_ptr<FileWatcher> watcher;
+
+  static size_t max_file_bytes;
+  static size_t file_bytes;
+  static uint64_t clock;
+  static Stats stats;
+
   /** Loads PLF from filename and stores it under 'res_name' in the
       map */
   static PingusLevel load_plf_raw(std::string const& res_name,
                                   Pathname const& pathname);
+
+  /** Drop the levels loaded from filename, all of them if it is
+      empty, called by the FileWatcher */
+  static void on_file_changed(std::string const& filename);
+
+  /** Remove the entry and stop watching its file if no other entry
+      uses it, mutex must be held */
+  static void erase(PLFMap::iterator it);
+
+  /** Drop the least recently used levels until the cache fits into
+      max_file_bytes, mutex must be held */
+  static void evict();
+
 public:
   /** @returns a handle to the PLF, which the caller *must not* delete
 
@@ -56,6 +101,18 @@ public:
 
       @param filename The filename of the plf, aka "../data/levels/snow11-grumbel.pingus" */
   static PingusLevel load_plf_from_filename(Pathname const& filename);
+
+  /** Set the budget for the cached levels, levels over budget get
+      evicted right away. The budget counts the size of the level
+      files on disk, not the memory of the parsed levels. That is
+      larger once the objects of a level got parsed, but grows with
+      the file size. */
+  static void set_max_file_bytes(size_t max_file_bytes);
+
+  /** Drop all levels and stop watching their files */
+  static void clear();
+
+  static Stats get_stats();
 };
 
 } // namespace pingus
@@ -27,7 +27,8 @@ namespace pingus {
 
 ResourceManager::ResourceManager() :
   m_cache(),
-  m_resources()
+  m_resources(),
+  m_mutex()
 {
 }
 
@@ -38,6 +39,8 @@ ResourceManager::~ResourceManager()
 std::vector<std::string>
 ResourceManager::get_section(std::string const& name)
 {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
   std::vector<std::string> lst;
 
   for (auto i = m_resources.begin(); i != m_resources.end(); ++i)
@@ -57,6 +60,8 @@ ResourceManager::add_resources_from_directory(Pathname const& path)
   assert(path.get_type() == Pathname::DATA_PATH);
 
   auto files = path.opendir_recursive();
+
+  std::lock_guard<std::mutex> lock(m_mutex);
   for(auto it = files.begin(); it != files.end(); ++it)
   {
     if (it->has_extension(".sprite") ||
@@ -123,6 +128,8 @@ ResourceManager::get_sprite_description_from_file(std::string const& resname)
 SpriteDescription*
 ResourceManager::get_sprite_description(std::string const& name)
 {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
   auto i = m_cache.find(name);
   if (i != m_cache.end())
   {
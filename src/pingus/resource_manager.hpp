@@ -20,6 +20,7 @@
 #include <map>
 #include <set>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -37,6 +38,10 @@ private:
   Resources m_cache;
   std::set<std::string> m_resources;
 
+  /** Guards m_cache and m_resources, the ResourceManager is shared
+      between all threads that simulate a World */
+  std::mutex m_mutex;
+
 public:
   ResourceManager();
   ~ResourceManager();
@@ -0,0 +1,128 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "pingus/rewind_buffer.hpp"
+
+#include <logmich/log.hpp>
+
+#include "pingus/server.hpp"
+#include "pingus/world.hpp"
+
+namespace pingus {
+
+RewindBuffer::RewindBuffer(Server& server, size_t budget, int interval) :
+  m_server(server),
+  m_budget(budget),
+  m_interval(interval),
+  m_snapshots(),
+  m_size(0)
+{
+  m_server.get_world()->get_gfx_map()->start_journal();
+  take_snapshot();
+}
+
+RewindBuffer::~RewindBuffer()
+{
+}
+
+void
+RewindBuffer::update()
+{
+  if (m_server.get_time() - m_snapshots.back().state.get_time() >= m_interval)
+  {
+    take_snapshot();
+  }
+}
+
+void
+RewindBuffer::take_snapshot()
+{
+  GroundMap* gfx_map = m_server.get_world()->get_gfx_map();
+
+  // everything changed since the last snapshot, with its content at
+  // the time of that snapshot
+  if (!m_snapshots.empty())
+  {
+    Snapshot& last = m_snapshots.back();
+    last.delta = gfx_map->take_journal();
+
+    size_t const delta_size = last.delta.get_size();
+    last.size += delta_size;
+    m_size += delta_size;
+  }
+
+  Savestate state = m_server.save_state(false);
+  size_t const state_size = state.get_data().size();
+  m_snapshots.push_back(Snapshot{std::move(state), GroundMap::Delta(), state_size});
+  m_size += state_size;
+
+  while (m_size > m_budget && m_snapshots.size() > 1)
+  {
+    m_size -= m_snapshots.front().size;
+    m_snapshots.pop_front();
+  }
+}
+
+bool
+RewindBuffer::rewind(int ticks)
+{
+  int const target = m_server.get_time() - ticks;
+
+  size_t idx = m_snapshots.size() - 1;
+  while (idx > 0 && m_snapshots[idx].state.get_time() > target)
+  {
+    --idx;
+  }
+
+  if (m_snapshots[idx].state.get_time() == m_server.get_time())
+  {
+    return false;
+  }
+
+  GroundMap* gfx_map = m_server.get_world()->get_gfx_map();
+
+  // recreating the pingu actions might change the terrain, that goes
+  // into the current journal and is undone with it
+  m_server.load_state(m_snapshots[idx].state);
+
+  gfx_map->undo(gfx_map->take_journal());
+  while (m_snapshots.size() > idx + 1)
+  {
+    m_size -= m_snapshots.back().size;
+    m_snapshots.pop_back();
+
+    Snapshot& last = m_snapshots.back();
+    gfx_map->undo(last.delta);
+
+    size_t const delta_size = last.delta.get_size();
+    last.delta = GroundMap::Delta();
+    last.size -= delta_size;
+    m_size -= delta_size;
+  }
+
+  log_info("rewound to time {}", m_server.get_time());
+  return true;
+}
+
+int
+RewindBuffer::get_oldest_time() const
+{
+  return m_snapshots.front().state.get_time();
+}
+
+} // namespace pingus
+
+/* EOF */
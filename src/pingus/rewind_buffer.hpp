@@ -0,0 +1,97 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_PINGUS_PINGUS_REWIND_BUFFER_HPP
+#define HEADER_PINGUS_PINGUS_REWIND_BUFFER_HPP
+
+#include <deque>
+
+#include "pingus/ground_map.hpp"
+#include "pingus/savestate.hpp"
+
+namespace pingus {
+
+class Server;
+
+/** Keeps the recent past of a running game, so that the player can
+    go back a few seconds without restarting the level.
+
+    Every interval ticks a Savestate without the terrain is taken, the
+    terrain isn't stored as a whole, instead the GroundMap journals
+    the previous content of the colmap columns and tiles that get
+    changed. Going back applies these journals in reverse order. The
+    oldest snapshots are dropped once the memory budget is exceeded.
+
+    @brief Bounded history of a Server for rewinding */
+class RewindBuffer
+{
+private:
+  struct Snapshot
+  {
+    /** The state without the terrain */
+    Savestate state;
+
+    /** The terrain at the time of the state, for everything that got
+        changed until the next snapshot */
+    GroundMap::Delta delta;
+
+    /** Bytes used by state and delta */
+    size_t size;
+  };
+
+  Server& m_server;
+
+  /** Maximum number of bytes used by the snapshots */
+  size_t m_budget;
+
+  /** Number of ticks between two snapshots */
+  int m_interval;
+
+  std::deque<Snapshot> m_snapshots;
+  size_t m_size;
+
+public:
+  /** Takes the first snapshot right away */
+  RewindBuffer(Server& server, size_t budget, int interval);
+  ~RewindBuffer();
+
+  /** Call after every tick of the server */
+  void update();
+
+  /** Go back to the latest snapshot that is at least ticks old, or
+      to the oldest one if the history doesn't reach back that far
+
+      @return false if there is nothing to go back to */
+  bool rewind(int ticks);
+
+  /** @return the time of the oldest snapshot */
+  int get_oldest_time() const;
+
+  /** @return the number of bytes used by the snapshots */
+  size_t get_size() const { return m_size; }
+
+private:
+  void take_snapshot();
+
+  RewindBuffer(RewindBuffer const&);
+  RewindBuffer& operator=(RewindBuffer const&);
+};
+
+} // namespace pingus
+
+#endif
+
+/* EOF */
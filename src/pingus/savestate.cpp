@@ -0,0 +1,184 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "pingus/savestate.hpp"
+
+#include <string.h>
+
+#include "engine/display/sprite.hpp"
+#include "pingus/direction.hpp"
+#include "pingus/state_sprite.hpp"
+#include "util/raise_exception.hpp"
+
+namespace pingus {
+
+SavestateStream::SavestateStream(Savestate* out, uint8_t const* in, size_t in_size, bool reading,
+                                 uint64_t* hash) :
+  m_out(out),
+  m_in(in),
+  m_in_size(in_size),
+  m_reading(reading),
+  m_pos(0),
+  m_hash(hash)
+{
+}
+
+SavestateStream
+SavestateStream::writer(Savestate& state)
+{
+  return SavestateStream(&state, nullptr, 0, false, nullptr);
+}
+
+SavestateStream
+SavestateStream::reader(Savestate const& state)
+{
+  return SavestateStream(nullptr, state.data.data(), state.data.size(), true, nullptr);
+}
+
+SavestateStream
+SavestateStream::reader(uint8_t const* data, size_t size)
+{
+  return SavestateStream(nullptr, data, size, true, nullptr);
+}
+
+SavestateStream
+SavestateStream::hasher(uint64_t& hash)
+{
+  return SavestateStream(nullptr, nullptr, 0, false, &hash);
+}
+
+bool
+SavestateStream::at_end() const
+{
+  return !m_reading || m_pos == m_in_size;
+}
+
+void
+SavestateStream::sync_bytes(void* data, size_t size)
+{
+  if (m_reading)
+  {
+    if (size > m_in_size - m_pos)
+    {
+      raise_exception(std::runtime_error, "unexpected end of savestate at byte " << m_pos);
+    }
+
+    memcpy(data, m_in + m_pos, size);
+    m_pos += size;
+  }
+  else if (m_hash)
+  {
+    // FNV-1a, the states are small enough for a bytewise hash
+    uint8_t const* bytes = static_cast<uint8_t const*>(data);
+    uint64_t hash = *m_hash;
+    for (size_t i = 0; i < size; ++i)
+    {
+      hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+    }
+    *m_hash = hash;
+  }
+  else
+  {
+    uint8_t const* bytes = static_cast<uint8_t const*>(data);
+    m_out->data.insert(m_out->data.end(), bytes, bytes + size);
+  }
+}
+
+void
+SavestateStream::check_size(uint64_t count) const
+{
+  // every element takes up at least one byte
+  if (m_reading && count > m_in_size - m_pos)
+  {
+    raise_exception(std::runtime_error, "invalid element count " << count << " in savestate");
+  }
+}
+
+void
+SavestateStream::sync(std::string& value)
+{
+  uint64_t size = value.size();
+  sync(size);
+  if (is_reading())
+  {
+    check_size(size);
+    value.resize(static_cast<size_t>(size));
+  }
+  sync_bytes(value.data(), value.size());
+}
+
+void
+SavestateStream::sync(Vector2f& value)
+{
+  float x = value.x();
+  float y = value.y();
+  sync(x);
+  sync(y);
+  value = Vector2f(x, y);
+}
+
+void
+SavestateStream::sync(glm::vec2& value)
+{
+  sync(value.x);
+  sync(value.y);
+}
+
+void
+SavestateStream::sync(Direction& value)
+{
+  int dir = value;
+  sync(dir);
+  if (is_reading())
+  {
+    if (dir == Direction::LEFT)
+      value.left();
+    else if (dir == Direction::RIGHT)
+      value.right();
+    else
+      value = Direction();
+  }
+}
+
+void
+SavestateStream::sync(Sprite& sprite)
+{
+  if (m_hash)
+    return;
+
+  Sprite::State state = sprite.get_state();
+  sync(state.frame);
+  sync(state.tick_count);
+  sync(state.loop);
+  sync(state.loop_last_cycle);
+  sync(state.finished);
+  sprite.set_state(state);
+}
+
+void
+SavestateStream::sync(StateSprite& sprite)
+{
+  // the states are loaded by the constructor of the owner, so both
+  // sides have the same set of sprites
+  for (auto& it : sprite)
+  {
+    sync(it.second);
+  }
+}
+
+} // namespace pingus
+
+/* EOF */
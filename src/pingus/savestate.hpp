@@ -0,0 +1,159 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_PINGUS_PINGUS_SAVESTATE_HPP
+#define HEADER_PINGUS_PINGUS_SAVESTATE_HPP
+
+#include <stdint.h>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "math/vector2f.hpp"
+
+namespace pingus {
+
+class Direction;
+class Sprite;
+class StateSprite;
+
+/** The complete simulation state of a Server, taken between two
+    ticks. Loading it into a Server of the same level continues the
+    game exactly as if it had been played up to that tick, which
+    allows to seek in demos without replaying them from the start.
+
+    @brief Snapshot of a running game */
+class Savestate
+{
+private:
+  friend class SavestateStream;
+
+  /** The game time at which the state was taken */
+  int time;
+
+  std::vector<uint8_t> data;
+
+public:
+  Savestate() : time(0), data() {}
+  Savestate(int time_, std::vector<uint8_t> data_) : time(time_), data(std::move(data_)) {}
+
+  int get_time() const { return time; }
+
+  /** @return the serialized state, it can be stored and turned back
+      into a Savestate together with the time */
+  std::vector<uint8_t> const& get_data() const { return data; }
+};
+
+/** Reads or writes the state of objects from or to a Savestate. The
+    objects implement a single sync_state() function that passes all
+    their members to sync(), which is used in both directions, so the
+    order of the reads can't drift apart from the order of the
+    writes. Only values are stored, objects have to exist already or
+    get recreated by their owner before their state is read.
+
+    @brief Serializer for Savestates */
+class SavestateStream
+{
+private:
+  /** The state that is written to, nullptr when reading */
+  Savestate* m_out;
+
+  /** The data that is read from, nullptr when writing */
+  uint8_t const* m_in;
+  size_t m_in_size;
+  bool m_reading;
+
+  /** Read position in m_in */
+  size_t m_pos;
+
+  /** The hash the data is folded into, nullptr unless hashing */
+  uint64_t* m_hash;
+
+public:
+  /** Create a stream that appends to state */
+  static SavestateStream writer(Savestate& state);
+
+  /** Create a stream that reads state from the beginning */
+  static SavestateStream reader(Savestate const& state);
+
+  /** Create a stream that reads size bytes of data, which has to stay
+      valid while the stream is used, e.g. the contents of a mapped
+      file */
+  static SavestateStream reader(uint8_t const* data, size_t size);
+
+  /** Create a stream that folds everything written into hash instead
+      of storing it, used to compare states without keeping them */
+  static SavestateStream hasher(uint64_t& hash);
+
+  bool is_reading() const { return m_reading; }
+  bool is_hashing() const { return m_hash != nullptr; }
+
+  /** @return true if all data of the state has been read */
+  bool at_end() const;
+
+  template<typename T>
+  void sync(T& value)
+  {
+    static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>,
+                  "sync() needs an overload for this type");
+    sync_bytes(&value, sizeof(value));
+  }
+
+  void sync(std::string& value);
+  void sync(Vector2f& value);
+  void sync(glm::vec2& value);
+  void sync(Direction& value);
+
+  /** Sync the animation state of the sprite, the graphics itself
+      aren't part of the state. Sprites are left out of hashes, as
+      they only animate when graphics got loaded, anything relevant
+      to the game shows up elsewhere in the state. */
+  void sync(Sprite& sprite);
+  void sync(StateSprite& sprite);
+
+  /** Sync the number of elements of values, when reading the vector
+      gets resized and the elements have to be synced by the caller */
+  template<typename T>
+  void sync_size(std::vector<T>& values)
+  {
+    uint64_t size = values.size();
+    sync(size);
+    if (is_reading())
+    {
+      check_size(size);
+      values.resize(static_cast<size_t>(size));
+    }
+  }
+
+  /** Sync the given number of raw bytes */
+  void sync_bytes(void* data, size_t size);
+
+  /** Throw if the state can't contain count more elements, used to
+      reject broken sizes before allocating for them */
+  void check_size(uint64_t count) const;
+
+private:
+  SavestateStream(Savestate* out, uint8_t const* in, size_t in_size, bool reading, uint64_t* hash);
+};
+
+} // namespace pingus
+
+#endif
+
+/* EOF */
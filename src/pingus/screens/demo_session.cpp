@@ -36,6 +36,14 @@
 
 namespace pingus {
 
+namespace {
+
+/** Number of ticks between two keyframes, seeking has to simulate at
+    most this many ticks */
+int const keyframe_interval = 250;
+
+} // namespace
+
 class BButton : public pingus::gui::SurfaceButton
 {
 private:
@@ -76,7 +84,9 @@ DemoSession::DemoSession(Pathname const& pathname_) :
   pathname(pathname_),
   server(),
   demo(),
-  events(),
+  next_event(),
+  has_next_event(false),
+  keyframes(),
   pcounter(),
   playfield(),
   small_map(),
@@ -89,9 +99,7 @@ DemoSession::DemoSession(Pathname const& pathname_) :
   // Load Demo file
   demo = std::unique_ptr<PingusDemo>(new PingusDemo(pathname));
 
-  events = demo->get_events();
-  // Reverse the vector so that we can use pop_back()
-  std::reverse(events.begin(), events.end());
+  reset_events(0);
 
   // Create server
   PingusLevel plf(Pathname("levels/" + demo->get_levelname()  + ".pingus", Pathname::DATA_PATH));
@@ -102,7 +110,8 @@ DemoSession::DemoSession(Pathname const& pathname_) :
              demo->get_checksum(), plf.get_checksum());
   }
 
-  server   = std::unique_ptr<Server>(new Server(plf, false));
+  server   = std::unique_ptr<Server>(new Server(plf, false, demo->get_seed()));
+  keyframes.push_back(server->save_state());
 
   // Create GUI
   pcounter = gui_manager->create<PingusCounter>(server.get());
@@ -193,37 +202,50 @@ DemoSession::update(float delta)
 void
 DemoSession::update_demo()
 {
-  while(!events.empty() && events.back().time_stamp == server->get_time())
+  while(has_next_event && next_event.time_stamp == server->get_time())
   {
-    ServerEvent& event = events.back();
-
     if ((false))
     {
       std::cout << "Sending: ";
-      event.write(std::cout);
+      next_event.write(std::cout);
     }
 
-    event.send(server.get());
-    events.pop_back();
+    next_event.send(server.get());
+    has_next_event = demo->read_event(next_event);
   }
 
   // Check for unexpected things (might happen if the demo file is broken)
-  if (!events.empty() && events.back().time_stamp < server->get_time())
+  if (has_next_event && next_event.time_stamp < server->get_time())
+  {
+    log_info("DemoPlayer Bug: We missed a timestamp: {}", next_event.time_stamp);
+  }
+
+  int const time = server->get_time();
+  if (time % keyframe_interval == 0 &&
+      static_cast<size_t>(time / keyframe_interval) == keyframes.size())
+  {
+    keyframes.push_back(server->save_state());
+  }
+}
+
+void
+DemoSession::reset_events(int time)
+{
+  demo->reset();
+  do
   {
-    log_info("DemoPlayer Bug: We missed a timestamp: {}", events.back().time_stamp);
+    has_next_event = demo->read_event(next_event);
   }
+  while (has_next_event && next_event.time_stamp <= time);
 }
 
 void
 DemoSession::on_pause_press()
 {
-  if ((false))
+  if ((false) && has_next_event)
   {
-    for(std::vector<ServerEvent>::iterator i = events.begin(); i != events.end(); ++i)
-    {
-      std::cout << "Event: ";
-      i->write(std::cout);
-    }
+    std::cout << "Next event: ";
+    next_event.write(std::cout);
   }
 
   pause = !pause;
@@ -234,7 +256,7 @@ void
 DemoSession::on_fast_forward_press()
 {
   if (0)
-    log_info("Fast Forward Pressed: {} {}", events.size(), server->get_time());
+    log_info("Fast Forward Pressed: {} {}", has_next_event, server->get_time());
 
   fast_forward = !fast_forward;
 }
@@ -247,6 +269,18 @@ DemoSession::on_escape_press()
   ScreenManager::instance()->pop_screen();
 }
 
+void
+DemoSession::on_action_up_press()
+{
+  seek(std::max(server->get_time() - keyframe_interval, 0));
+}
+
+void
+DemoSession::on_action_down_press()
+{
+  seek(server->get_time() + keyframe_interval);
+}
+
 void
 DemoSession::on_scroller_move(float x, float y)
 {
@@ -258,7 +292,24 @@ DemoSession::on_scroller_move(float x, float y)
 void
 DemoSession::restart()
 {
-  ScreenManager::instance()->replace_screen(std::make_shared<DemoSession>(pathname));
+  seek(0);
+}
+
+void
+DemoSession::seek(int time)
+{
+  size_t const idx = std::min(static_cast<size_t>(std::max(time, 0) / keyframe_interval),
+                              keyframes.size() - 1);
+  Savestate const& keyframe = keyframes[idx];
+
+  server->load_state(keyframe);
+  reset_events(keyframe.get_time());
+
+  while (server->get_time() < time && !server->is_finished())
+  {
+    server->update();
+    update_demo();
+  }
 }
 
 void
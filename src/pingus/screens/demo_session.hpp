@@ -21,6 +21,7 @@
 #include <vector>
 
 #include "engine/screen/gui_screen.hpp"
+#include "pingus/savestate.hpp"
 #include "pingus/server_event.hpp"
 #include "util/pathname.hpp"
 #include "fwd.hpp"
@@ -37,7 +38,14 @@ private:
 
   std::unique_ptr<Server>     server;
   std::unique_ptr<PingusDemo> demo;
-  std::vector<ServerEvent>  events;
+
+  /** The next event of the demo that has to be sent */
+  ServerEvent next_event;
+  bool has_next_event;
+
+  /** Savestates taken every keyframe_interval ticks during playback,
+      keyframes[i] holds the state at tick i * keyframe_interval */
+  std::vector<Savestate> keyframes;
 
   PingusCounter* pcounter;
   Playfield*     playfield;
@@ -64,9 +72,15 @@ public:
   void on_pause_press() override;
   void on_fast_forward_press() override;
   void on_escape_press() override;
+  void on_action_up_press() override;
+  void on_action_down_press() override;
 
   void restart();
 
+  /** Jump to the given tick of the demo, this restores the closest
+      keyframe before time and simulates the remaining ticks */
+  void seek(int time);
+
   void on_scroller_move(float x, float y);
 
   bool is_pause() const { return pause; }
@@ -75,6 +89,9 @@ public:
   void resize(Size const& size) override;
 
 private:
+  /** Position the demo on the first event after time */
+  void reset_events(int time);
+
   DemoSession (DemoSession const&);
   DemoSession& operator= (DemoSession const&);
 };
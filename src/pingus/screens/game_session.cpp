@@ -32,16 +32,31 @@
 #include "pingus/event_name.hpp"
 #include "pingus/globals.hpp"
 #include "pingus/pingu_holder.hpp"
+#include "pingus/rewind_buffer.hpp"
 #include "pingus/savegame_manager.hpp"
 #include "pingus/screens/result_screen.hpp"
 #include "pingus/world.hpp"
 
 namespace pingus {
 
+namespace {
+
+/** Milliseconds of game time between two rewind snapshots */
+int const rewind_interval = 500;
+
+/** Milliseconds of game time a press of the rewind button goes back */
+int const rewind_step = 2000;
+
+/** Memory the rewind snapshots may use */
+size_t const rewind_budget = 32 * 1024 * 1024;
+
+} // namespace
+
 GameSession::GameSession(PingusLevel const& arg_plf, bool arg_show_result_screen) :
   plf(arg_plf),
   show_result_screen(arg_show_result_screen),
   server(),
+  rewind_buffer(),
   world_delay(),
   button_panel(),
   pcounter(),
@@ -54,7 +69,9 @@ GameSession::GameSession(PingusLevel const& arg_plf, bool arg_show_result_screen
   fast_forward(false),
   single_step(false)
 {
-  server = std::unique_ptr<Server>(new Server(plf, true));
+  server = std::unique_ptr<Server>(new Server(plf, true, Random::random_seed()));
+  rewind_buffer = std::make_unique<RewindBuffer>(*server, rewind_budget,
+                                                 rewind_interval / globals::game_speed);
 
   // the world is initially on time
   world_delay = 0;
@@ -142,11 +159,15 @@ GameSession::update_server(float delta)
         if (fast_forward)
         {
           for (int i = 0; i < globals::fast_forward_time_scale; ++i)
+          {
             server->update();
+            rewind_buffer->update();
+          }
         }
         else
         {
           server->update();
+          rewind_buffer->update();
         }
       }
 
@@ -277,6 +298,15 @@ GameSession::on_single_step_press()
   single_step = true;
 }
 
+void
+GameSession::on_rewind_press()
+{
+  if (!server->is_finished())
+  {
+    rewind_buffer->rewind(rewind_step / globals::game_speed);
+  }
+}
+
 void
 GameSession::on_fast_forward_press()
 {
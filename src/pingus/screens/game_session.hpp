@@ -39,6 +39,9 @@ private:
   /// The server
   std::unique_ptr<Server> server;
 
+  /// The recent past of the server, for stepping back
+  std::unique_ptr<RewindBuffer> rewind_buffer;
+
   int world_delay; ///< how many milliseconds is the world behind the actual time
 
   // -- Client stuff
@@ -79,6 +82,7 @@ public:
 
   void on_pause_press() override;
   void on_single_step_press() override;
+  void on_rewind_press() override;
   void on_fast_forward_press() override;
   void on_fast_forward_release() override;
   void on_armageddon_press() override;
@@ -30,6 +30,7 @@
 #include "pingus/fonts.hpp"
 #include "pingus/gettext.h"
 #include "pingus/globals.hpp"
+#include "pingus/plf_res_mgr.hpp"
 #include "pingus/screens/start_screen.hpp"
 #include "util/system.hpp"
 
@@ -336,11 +337,11 @@ public:
         // draw levelname
         if (globals::developer_mode)
         {
-          gc.print_left(pingus::fonts::chalk_normal, Vector2i(list_rect.left() + 40, y+4), levelset->get_level(i)->plf.get_resname());
+          gc.print_left(pingus::fonts::chalk_normal, Vector2i(list_rect.left() + 40, y+4), levelset->get_level(i)->resname);
         }
         else
         {
-          gc.print_left(pingus::fonts::chalk_normal, Vector2i(list_rect.left() + 40, y+4), _(levelset->get_level(i)->plf.get_levelname()));
+          gc.print_left(pingus::fonts::chalk_normal, Vector2i(list_rect.left() + 40, y+4), _(levelset->get_level(i)->info.levelname));
         }
 
         // draw icon
@@ -420,9 +421,17 @@ public:
     on_pointer_move(x, y);
     if (current_level != -1)
     {
-      if (levelset->get_level(current_level)->accessible)
+      Levelset::Level* level = levelset->get_level(current_level);
+      if (level->accessible)
       {
-        ScreenManager::instance()->push_screen(std::make_shared<StartScreen>(levelset->get_level(current_level)->plf));
+        try
+        {
+          ScreenManager::instance()->push_screen(std::make_shared<StartScreen>(PLFResMgr::load_plf(level->resname)));
+        }
+        catch(std::exception const& err)
+        {
+          log_error("failed to load: {}: {}", level->resname, err.what());
+        }
       }
     }
   }
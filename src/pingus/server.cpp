@@ -16,15 +16,16 @@
 
 #include "pingus/server.hpp"
 
-#include <fstream>
 #include <time.h>
 
 #include <logmich/log.hpp>
 
+#include "pingus/demo_writer.hpp"
+#include "pingus/globals.hpp"
 #include "pingus/goal_manager.hpp"
 #include "pingus/pingu.hpp"
 #include "pingus/world.hpp"
-#include "util/writer.hpp"
+#include "util/raise_exception.hpp"
 #include "util/system.hpp"
 
 namespace pingus {
@@ -43,7 +44,7 @@ std::string get_date_string()
   return std::string(buffer);
 }
 
-std::unique_ptr<std::ostream> get_demostream(PingusLevel const& plf)
+std::unique_ptr<DemoWriter> get_demostream(PingusLevel const& plf, uint32_t seed)
 {
   std::string flat_levelname = plf.get_resname();
 
@@ -54,47 +55,41 @@ std::unique_ptr<std::ostream> get_demostream(PingusLevel const& plf)
 
   std::string filename = System::get_userdir() + "demos/" + flat_levelname + "-" + get_date_string() + ".pingus-demo";
 
-  std::unique_ptr<std::ofstream> out(new std::ofstream(filename.c_str()));
+  auto out = std::make_unique<DemoWriter>(filename, DemoWriter::BINARY,
+                                          plf.get_resname(), plf.get_checksum(), seed);
 
-  if (!(*out))
+  if (!out->is_open())
   {
     log_error("DemoRecorder: Error: Couldn't write DemoFile '{}', demo recording will be disabled", filename);
-    return std::unique_ptr<std::ostream>();
+    return std::unique_ptr<DemoWriter>();
   }
   else
   {
     log_info("DemoRecorder: Writing demo to: {}", filename);
-
-    // Write file header
-    Writer writer(*out);
-    writer.begin_mapping("level");
-    writer.write("name", plf.get_resname());
-    writer.write("checksum", plf.get_checksum());
-    writer.end_mapping();
-    *out << std::endl;
-    return std::unique_ptr<std::ostream>(out.release());
+    return out;
   }
 }
 
 } // namespace
 
-Server::Server(PingusLevel const& arg_plf, bool record_demo) :
+Server::Server(PingusLevel const& arg_plf, bool record_demo, uint32_t seed) :
   plf(arg_plf),
-  world(new World (plf)),
+  world(new World (plf, seed)),
   action_holder (plf),
   goal_manager(new GoalManager(this)),
-  demostream()
+  demostream(),
+  first_desync(-1)
 {
   if (record_demo)
   {
-    demostream = get_demostream(plf);
+    demostream = get_demostream(plf, seed);
   }
 }
 
 Server::~Server()
 {
   if (demostream) // FIXME: Any better place to put this?
-    (*demostream) << "(end (time " << get_time() << "))" << std::endl;
+    demostream->write(ServerEvent::make_end_event(get_time()));
 }
 
 World*
@@ -108,6 +103,23 @@ Server::update()
 {
   world->update();
   goal_manager->update();
+
+  if (demostream && globals::demo_checkpoint_interval > 0 &&
+      get_time() % globals::demo_checkpoint_interval == 0)
+  {
+    record(ServerEvent::make_checkpoint_event(get_time(), world->get_state_hash()));
+  }
+}
+
+void
+Server::check_state_hash(int time, uint64_t state_hash)
+{
+  if (first_desync == -1 && time == get_time() &&
+      world->get_state_hash() != state_hash)
+  {
+    first_desync = time;
+    log_error("replay diverged from the demo at tick {}", time);
+  }
 }
 
 void
@@ -136,7 +148,7 @@ void
 Server::record(ServerEvent const& event)
 {
   if (demostream)
-    event.write(*demostream);
+    demostream->write(event);
 }
 
 bool
@@ -164,6 +176,60 @@ Server::send_finish_event()
   goal_manager->set_abort_goal();
 }
 
+Savestate
+Server::save_state(bool with_terrain)
+{
+  Savestate state(get_time(), {});
+  SavestateStream stream = SavestateStream::writer(state);
+  sync_state(stream, with_terrain);
+  return state;
+}
+
+void
+Server::load_state(Savestate const& state)
+{
+  if (demostream)
+  {
+    // the events after the state are undone along with the game, the
+    // recording goes on from the state
+    try
+    {
+      demostream->truncate(state.get_time());
+    }
+    catch(std::exception const& err)
+    {
+      log_error("Server: {}, demo recording ends at time {}", err.what(), get_time());
+      demostream.reset();
+    }
+  }
+
+  SavestateStream stream = SavestateStream::reader(state);
+  sync_state(stream, false);
+
+  if (!stream.at_end())
+  {
+    raise_exception(std::runtime_error, "trailing data in savestate");
+  }
+}
+
+void
+Server::sync_state(SavestateStream& stream, bool with_terrain)
+{
+  std::string checksum = plf.get_checksum();
+  stream.sync(checksum);
+  if (checksum != plf.get_checksum())
+  {
+    raise_exception(std::runtime_error, "savestate was taken from a different level");
+  }
+
+  // when reading this comes from the state itself
+  stream.sync(with_terrain);
+
+  action_holder.sync_state(stream);
+  goal_manager->sync_state(stream);
+  world->sync_state(stream, with_terrain);
+}
+
 } // namespace pingus
 
 /* EOF */
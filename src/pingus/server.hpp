@@ -19,6 +19,7 @@
 
 #include "pingus/action_holder.hpp"
 #include "pingus/pingus_level.hpp"
+#include "pingus/savestate.hpp"
 #include "pingus/server_event.hpp"
 #include <memory>
 
@@ -26,7 +27,7 @@ namespace pingus {
 
 class Pingu;
 class World;
-class DemoRecorder;
+class DemoWriter;
 class GoalManager;
 
 /** A abstract server-like class */
@@ -40,10 +41,15 @@ protected:
   ActionHolder action_holder;
 
   std::unique_ptr<GoalManager>  goal_manager;
-  std::unique_ptr<std::ostream> demostream;
+  std::unique_ptr<DemoWriter>   demostream;
+
+  /** The first time at which check_state_hash() failed, -1 if never */
+  int first_desync;
 
 public:
-  Server(PingusLevel const& arg_plf, bool record_demo);
+  /** @param seed seed for the random number generator of the World,
+      it gets recorded in the demo so it can be replayed exactly */
+  Server(PingusLevel const& arg_plf, bool record_demo, uint32_t seed);
   ~Server();
 
   void update();
@@ -65,8 +71,29 @@ public:
   void send_armageddon_event();
   void send_pingu_action_event(Pingu* pingu, ActionName::Enum action);
 
+  /** Compare the state of the world with a hash recorded at the same
+      time in a demo, the first mismatch gets logged and remembered */
+  void check_state_hash(int time, uint64_t state_hash);
+
+  /** @return the time at which the world first diverged from the
+      demo that is played back, -1 if it didn't */
+  int get_first_desync() const { return first_desync; }
+
+  /** Take a snapshot of the complete simulation state
+
+      @param with_terrain if false the colmap and ground graphics are
+      left out, the caller has to restore them on its own */
+  Savestate save_state(bool with_terrain = true);
+
+  /** Restore a snapshot taken with save_state(), the state must come
+      from a Server running the same level. When recording a demo the
+      events recorded after the state are dropped from it, so the demo
+      describes the game as it continues from the state. */
+  void load_state(Savestate const& state);
+
 private:
   void record(ServerEvent const& event);
+  void sync_state(SavestateStream& stream, bool with_terrain);
 
   Server (Server const&);
   Server& operator= (Server const&);
@@ -16,6 +16,8 @@
 
 #include "pingus/server_event.hpp"
 
+#include <stdlib.h>
+
 #include <logmich/log.hpp>
 
 #include "pingus/pingu.hpp"
@@ -32,7 +34,8 @@ ServerEvent::ServerEvent() :
   time_stamp(0),
   pingu_id(0),
   pos(),
-  pingu_action(ActionName::WALKER)
+  pingu_action(ActionName::WALKER),
+  state_hash(0)
 {
 }
 
@@ -41,7 +44,8 @@ ServerEvent::ServerEvent(ReaderObject const& reader_object) :
   time_stamp(0),
   pingu_id(0),
   pos(),
-  pingu_action(ActionName::WALKER)
+  pingu_action(ActionName::WALKER),
+  state_hash(0)
 {
   ReaderMapping reader = reader_object.get_mapping();
   if (reader_object.get_name() == "armageddon")
@@ -59,6 +63,15 @@ ServerEvent::ServerEvent(ReaderObject const& reader_object) :
     type = FINISH_EVENT;
     reader.read("time", time_stamp);
   }
+  else if (reader_object.get_name() == "checkpoint")
+  {
+    type = CHECKPOINT_EVENT;
+    reader.read("time", time_stamp);
+
+    std::string hash_str;
+    reader.read("hash", hash_str);
+    state_hash = std::strtoull(hash_str.c_str(), nullptr, 16);
+  }
   else if (reader_object.get_name() == "pingu-action")
   {
     type = PINGU_ACTION_EVENT;
@@ -93,6 +106,15 @@ ServerEvent::write(std::ostream& out) const
       out << "(finish (time " << time_stamp << "))" << std::endl;
       break;
 
+    case END_EVENT:
+      out << "(end (time " << time_stamp << "))" << std::endl;
+      break;
+
+    case CHECKPOINT_EVENT:
+      out << "(checkpoint (time " << time_stamp << ") "
+          << "(hash \"" << std::hex << state_hash << std::dec << "\"))" << std::endl;
+      break;
+
     case PINGU_ACTION_EVENT:
       out << "(pingu-action "
           << "(time " << time_stamp << ") "
@@ -147,6 +169,16 @@ ServerEvent::make_pingu_action_event(int t, unsigned int id, Vector2f const& pos
   return event;
 }
 
+ServerEvent
+ServerEvent::make_checkpoint_event(int t, uint64_t state_hash)
+{
+  ServerEvent event;
+  event.type       = CHECKPOINT_EVENT;
+  event.time_stamp = t;
+  event.state_hash = state_hash;
+  return event;
+}
+
 void
 ServerEvent::send(Server* server)
 {
@@ -164,6 +196,10 @@ ServerEvent::send(Server* server)
       // do nothing
       break;
 
+    case CHECKPOINT_EVENT:
+      server->check_state_hash(time_stamp, state_hash);
+      break;
+
     case PINGU_ACTION_EVENT:
     {
       Pingu* pingu = server->get_world()->get_pingus()->get_pingu(pingu_id);
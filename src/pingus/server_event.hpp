@@ -17,6 +17,8 @@
 #ifndef HEADER_PINGUS_PINGUS_SERVER_EVENT_HPP
 #define HEADER_PINGUS_PINGUS_SERVER_EVENT_HPP
 
+#include <stdint.h>
+
 #include "math/vector2f.hpp"
 #include "pingus/action_name.hpp"
 
@@ -36,7 +38,8 @@ public:
   enum Type { ARMAGEDDON_EVENT,
               FINISH_EVENT,
               END_EVENT,
-              PINGU_ACTION_EVENT };
+              PINGU_ACTION_EVENT,
+              CHECKPOINT_EVENT };
 
   /** The type of event */
   Type type;
@@ -54,6 +57,9 @@ public:
   /** action name */
   ActionName::Enum pingu_action;
 
+  /** World::get_state_hash() at the time of a checkpoint event */
+  uint64_t state_hash;
+
   ServerEvent();
 
   /** Construct an server event from an xml subtree */
@@ -81,6 +87,10 @@ public:
   /** The pingu action event is triggered whenever the user applies an
       action to a Pingu */
   static ServerEvent make_pingu_action_event(int t, unsigned int id, Vector2f const& pos, ActionName::Enum action);
+
+  /** The checkpoint event holds the state hash of the world, so that a
+      replay can tell when it no longer matches the recording */
+  static ServerEvent make_checkpoint_event(int time, uint64_t state_hash);
 };
 
 } // namespace pingus
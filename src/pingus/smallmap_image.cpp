@@ -16,6 +16,8 @@
 
 #include "pingus/smallmap_image.hpp"
 
+#include <algorithm>
+
 #include "pingus/collision_map.hpp"
 #include "pingus/server.hpp"
 #include "pingus/world.hpp"
@@ -46,7 +48,16 @@ SmallMapImage::update (float delta)
 
     if (colmap_serial != colmap->get_serial())
     {
-      update_surface();
+      colmap_serial = colmap->get_serial();
+
+      canvas.lock();
+      for (Rect const& rect : colmap->take_changes())
+      {
+        update_area(rect);
+      }
+      canvas.unlock();
+
+      sur = Sprite(canvas.clone());
     }
   }
 }
@@ -68,13 +79,26 @@ SmallMapImage::get_surface()
 void
 SmallMapImage::update_surface()
 {
-  unsigned char* cbuffer;
-
   CollisionMap* colmap = server->get_world()->get_colmap();
 
   colmap_serial = colmap->get_serial();
+  colmap->take_changes();
 
   canvas.lock();
+  update_area(Rect(0, 0, colmap->get_width(), colmap->get_height()));
+  canvas.unlock();
+
+  // FIXME: surface -> clone -> displayFormat leaves room for
+  // optimizations, clone isn't really needed
+  sur = Sprite(canvas.clone());
+}
+
+void
+SmallMapImage::update_area(Rect const& rect)
+{
+  unsigned char* cbuffer;
+
+  CollisionMap* colmap = server->get_world()->get_colmap();
 
   cbuffer = canvas.get_data();
 
@@ -87,14 +111,20 @@ SmallMapImage::update_surface()
 
   assert(width < cmap_width && height < cmap_height);
 
+  // the canvas pixels whose colmap sample lies in rect
+  int const x1 = (rect.left()   * width  + cmap_width  - 1) / cmap_width;
+  int const y1 = (rect.top()    * height + cmap_height - 1) / cmap_height;
+  int const x2 = std::min(width,  (rect.right()  * width  + cmap_width  - 1) / cmap_width);
+  int const y2 = std::min(height, (rect.bottom() * height + cmap_height - 1) / cmap_height);
+
   const int red   = 0;
   const int green = 1;
   const int blue  = 2;
   const int alpha = 3;
 
-  for(int y = 0; y < height; ++y)
+  for(int y = y1; y < y2; ++y)
   {
-    for (int x = 0; x < width; ++x)
+    for (int x = x1; x < x2; ++x)
     {
       // Index on the smallmap canvas
       int i = y * pitch + 4 * x;
@@ -140,12 +170,6 @@ SmallMapImage::update_surface()
       }
     }
   }
-
-  canvas.unlock();
-
-  // FIXME: surface -> clone -> displayFormat leaves room for
-  // optimizations, clone isn't really needed
-  sur = Sprite(canvas.clone());
 }
 
 } // namespace pingus
@@ -19,6 +19,7 @@
 
 #include "engine/display/sprite.hpp"
 #include "engine/display/surface.hpp"
+#include "math/rect.hpp"
 
 namespace pingus {
 
@@ -53,6 +54,11 @@ public:
   void update_surface();
 
 private:
+  /** Redraw the part of the locked canvas that shows rect of the
+      colmap */
+  void update_area(Rect const& rect);
+
+
   SmallMapImage (SmallMapImage const&);
   SmallMapImage& operator= (SmallMapImage const&);
 };
@@ -40,6 +40,9 @@ public:
   void load(int state, std::string const& name);
   void load(int state, Sprite const&);
   Sprite& operator[](int state);
+
+  Sprites::iterator begin() { return sprites.begin(); }
+  Sprites::iterator end() { return sprites.end(); }
 };
 
 } // namespace pingus
@@ -0,0 +1,301 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "pingus/terrain_cache.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <stdexcept>
+#include <string.h>
+#include <string_view>
+#include <vector>
+
+#include <logmich/log.hpp>
+
+#include "engine/display/sprite_description.hpp"
+#include "pingus/globals.hpp"
+#include "pingus/ground_map.hpp"
+#include "pingus/pingus_level.hpp"
+#include "pingus/resource.hpp"
+#include "util/hash.hpp"
+#include "util/pathname.hpp"
+#include "util/raise_exception.hpp"
+#include "util/system.hpp"
+
+namespace pingus {
+
+namespace {
+
+char const magic[8] = { 'P', 'I', 'N', 'G', 'B', 'A', 'K', 'E' };
+
+/** Has to be increased whenever the way the terrain gets drawn or
+    stored changes, so that older bakes get ignored */
+uint32_t const version = 1;
+
+/** The file starts with the magic, the version and the hash of the
+    rest, which is written with a SavestateStream. Numbers are in the
+    native byte order, the cache never leaves the machine. */
+size_t const header_size = sizeof(magic) + sizeof(version) + sizeof(uint64_t);
+
+/** Fold the state of the file at path into hash, the content for
+    files from the resource archive, the location and modification
+    time otherwise, as hashing all loose files would cost about as
+    much as loading them */
+uint64_t stamp(Pathname const& path, uint64_t hash)
+{
+  std::string_view data;
+  if (path.find_in_archive(data))
+  {
+    return hash64(data.data(), data.size(), hash);
+  }
+  else
+  {
+    std::string const sys_path = path.get_sys_path();
+    uint64_t const mtime = System::get_mtime(sys_path);
+    hash = hash64(sys_path.data(), sys_path.size(), hash);
+    return hash64(&mtime, sizeof(mtime), hash);
+  }
+}
+
+/** @return a hash over the current state of all files the resources
+    are loaded from */
+uint64_t get_fingerprint(std::vector<ResDescriptor> const& resources)
+{
+  uint64_t hash = 0;
+  for (ResDescriptor const& res : resources)
+  {
+    int const modifier = res.modifier;
+    hash = hash64(res.res_name.data(), res.res_name.size(), hash);
+    hash = hash64(&modifier, sizeof(modifier), hash);
+
+    // the .sprite takes precedence over the image, so a new one
+    // changes the resource as well
+    hash = stamp(Pathname("images/" + res.res_name + ".sprite", Pathname::DATA_PATH), hash);
+
+    SpriteDescription* desc = Resource::load_sprite_desc(res.res_name);
+    if (desc)
+    {
+      hash = stamp(desc->filename, hash);
+    }
+  }
+  return hash;
+}
+
+/** Sync everything in front of the terrain */
+void sync_header(SavestateStream& stream, std::string& checksum, int& tile_size,
+                 int& width, int& height, std::vector<ResDescriptor>& resources,
+                 uint64_t& fingerprint)
+{
+  stream.sync(checksum);
+  stream.sync(tile_size);
+  stream.sync(width);
+  stream.sync(height);
+
+  stream.sync_size(resources);
+  for (ResDescriptor& res : resources)
+  {
+    stream.sync(res.res_name);
+    stream.sync(res.modifier);
+  }
+
+  stream.sync(fingerprint);
+}
+
+/** @return the part of the filename that is the same for all bakes
+    of a level, levels without a resname are told apart by their
+    checksum only, so their older bakes are never pruned */
+std::string get_level_key(PingusLevel const& plf)
+{
+  std::string const& resname = plf.get_resname();
+  if (resname.empty())
+    return plf.get_checksum();
+  else
+    return hash_to_string(hash64(resname.data(), resname.size()));
+}
+
+/** Delete the bakes of the same level other than filename, they
+    belong to older versions of the level file or other tile sizes
+    and would never be used again */
+void prune(PingusLevel const& plf, std::string const& filename)
+{
+  std::string const prefix = get_level_key(plf) + "-";
+  std::filesystem::path const keep = std::filesystem::path(filename).filename();
+
+  std::error_code ec;
+  for (auto const& entry : std::filesystem::directory_iterator(System::get_cachedir() + "terrain/", ec))
+  {
+    std::string const name = entry.path().filename().string();
+    if (name.size() < 5 || name.compare(name.size() - 5, 5, ".bake") != 0 ||
+        entry.path().filename() == keep)
+      continue;
+
+    // bakes from before the level key was part of the name have only
+    // the checksum and tile size
+    bool const old_layout = std::count(name.begin(), name.end(), '-') == 1;
+    if (old_layout || name.compare(0, prefix.size(), prefix) == 0)
+    {
+      log_debug("{}: pruning outdated bake", entry.path().string());
+      std::filesystem::remove(entry.path(), ec);
+    }
+  }
+}
+
+} // namespace
+
+TerrainCache::TerrainCache(MappedFile file, SavestateStream const& stream) :
+  m_file(std::move(file)),
+  m_stream(stream)
+{
+}
+
+std::string
+TerrainCache::get_filename(PingusLevel const& plf)
+{
+  std::string const checksum = plf.get_checksum();
+  if (System::get_userdir().empty() || checksum.empty())
+  {
+    return std::string();
+  }
+  else
+  {
+    return System::get_cachedir() + "terrain/" + get_level_key(plf) + "-" + checksum + "-" +
+      std::to_string(globals::tile_size) + ".bake";
+  }
+}
+
+std::unique_ptr<TerrainCache>
+TerrainCache::find(PingusLevel const& plf, int width, int height)
+{
+  std::string const filename = get_filename(plf);
+  if (filename.empty() || !System::exist(filename))
+  {
+    return {};
+  }
+
+  try
+  {
+    MappedFile file(filename);
+
+    uint32_t file_version;
+    uint64_t hash;
+    if (file.size() < header_size ||
+        memcmp(file.data(), magic, sizeof(magic)) != 0)
+    {
+      raise_exception(std::runtime_error, "not a baked terrain");
+    }
+    memcpy(&file_version, file.data() + sizeof(magic), sizeof(file_version));
+    memcpy(&hash, file.data() + sizeof(magic) + sizeof(file_version), sizeof(hash));
+
+    if (file_version != version)
+    {
+      log_debug("{}: baked by another version", filename);
+      return {};
+    }
+
+    if (hash64(file.data() + header_size, file.size() - header_size) != hash)
+    {
+      raise_exception(std::runtime_error, "checksum mismatch");
+    }
+
+    SavestateStream stream = SavestateStream::reader(file.data() + header_size,
+                                                     file.size() - header_size);
+
+    std::string checksum;
+    int tile_size;
+    int baked_width;
+    int baked_height;
+    std::vector<ResDescriptor> resources;
+    uint64_t fingerprint;
+    sync_header(stream, checksum, tile_size, baked_width, baked_height, resources, fingerprint);
+
+    if (checksum != plf.get_checksum() ||
+        tile_size != globals::tile_size ||
+        baked_width != width ||
+        baked_height != height ||
+        fingerprint != get_fingerprint(resources))
+    {
+      log_info("{}: outdated, drawing the terrain", filename);
+      return {};
+    }
+
+    return std::unique_ptr<TerrainCache>(new TerrainCache(std::move(file), stream));
+  }
+  catch(std::exception const& err)
+  {
+    log_warn("{}: ignoring baked terrain: {}", filename, err.what());
+    return {};
+  }
+}
+
+void
+TerrainCache::store(PingusLevel const& plf, GroundMap& gfx_map,
+                    std::set<ResDescriptor> const& resources_)
+{
+  std::string const filename = get_filename(plf);
+  if (filename.empty())
+    return;
+
+  try
+  {
+    Savestate state;
+    SavestateStream stream = SavestateStream::writer(state);
+
+    std::string checksum = plf.get_checksum();
+    int tile_size = globals::tile_size;
+    int width = gfx_map.get_width();
+    int height = gfx_map.get_height();
+    std::vector<ResDescriptor> resources(resources_.begin(), resources_.end());
+    uint64_t fingerprint = get_fingerprint(resources);
+    sync_header(stream, checksum, tile_size, width, height, resources, fingerprint);
+
+    gfx_map.sync_terrain(stream);
+
+    std::vector<uint8_t> const& data = state.get_data();
+    uint64_t const hash = hash64(data.data(), data.size());
+
+    std::string content;
+    content.reserve(header_size + data.size());
+    content.append(magic, sizeof(magic));
+    content.append(reinterpret_cast<char const*>(&version), sizeof(version));
+    content.append(reinterpret_cast<char const*>(&hash), sizeof(hash));
+    content.append(reinterpret_cast<char const*>(data.data()), data.size());
+
+    System::create_dir(System::get_cachedir() + "terrain/");
+    System::write_file(filename, content);
+
+    prune(plf, filename);
+  }
+  catch(std::exception const& err)
+  {
+    log_warn("{}: couldn't bake terrain: {}", filename, err.what());
+  }
+}
+
+void
+TerrainCache::adopt(GroundMap& gfx_map)
+{
+  SavestateStream stream = m_stream;
+  gfx_map.sync_terrain(stream);
+
+  if (!stream.at_end())
+  {
+    raise_exception(std::runtime_error, "trailing data after baked terrain");
+  }
+}
+
+} // namespace pingus
+
+/* EOF */
@@ -0,0 +1,84 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_PINGUS_PINGUS_TERRAIN_CACHE_HPP
+#define HEADER_PINGUS_PINGUS_TERRAIN_CACHE_HPP
+
+#include <memory>
+#include <set>
+#include <string>
+
+#include "pingus/res_descriptor.hpp"
+#include "pingus/savestate.hpp"
+#include "util/mapped_file.hpp"
+
+namespace pingus {
+
+class GroundMap;
+class PingusLevel;
+
+/** The terrain of a level as it is after all groundpieces got drawn,
+    baked into a file in the cache directory the first time the level
+    is played. Later starts map that file and take the colmap and
+    tiles over from it, instead of loading and blitting every
+    groundpiece again.
+
+    A baked terrain is only used when the level file, the size of
+    the tiles and every resource the terrain got drawn from are
+    unchanged, anything else silently falls back to drawing the
+    terrain and bakes it anew. Only the latest bake of each level is
+    kept, older ones get deleted when a new one is stored. */
+class TerrainCache
+{
+private:
+  MappedFile m_file;
+
+  /** Positioned at the terrain data in m_file */
+  SavestateStream m_stream;
+
+public:
+  /** @return the baked terrain of plf, or nullptr if there is none
+      or it is outdated */
+  static std::unique_ptr<TerrainCache> find(PingusLevel const& plf, int width, int height);
+
+  /** Bake the terrain of plf, which got drawn from resources, and
+      delete the other bakes of the same level, errors are only
+      logged, as the cache is optional */
+  static void store(PingusLevel const& plf, GroundMap& gfx_map,
+                    std::set<ResDescriptor> const& resources);
+
+  /** @return the file the terrain of plf is baked into, empty if
+      there is no place for it */
+  static std::string get_filename(PingusLevel const& plf);
+
+  /** Replace the terrain of gfx_map with the baked one, gfx_map must
+      not track changes yet. Throws std::runtime_error if the baked
+      terrain turns out to be broken, gfx_map has to be cleared and
+      drawn anew then. */
+  void adopt(GroundMap& gfx_map);
+
+private:
+  TerrainCache(MappedFile file, SavestateStream const& stream);
+
+  TerrainCache(TerrainCache const&);
+  TerrainCache& operator=(TerrainCache const&);
+};
+
+} // namespace pingus
+
+#endif
+
+/* EOF */
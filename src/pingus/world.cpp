@@ -23,6 +23,7 @@
 #include "engine/display/scene_context.hpp"
 #include "engine/sound/sound.hpp"
 #include "pingus/collision_map.hpp"
+#include "pingus/collision_mask.hpp"
 #include "pingus/ground_map.hpp"
 #include "pingus/particles/pingu_particle_holder.hpp"
 #include "pingus/particles/rain_particle_holder.hpp"
@@ -31,12 +32,16 @@
 #include "pingus/pingu.hpp"
 #include "pingus/pingu_holder.hpp"
 #include "pingus/pingus_level.hpp"
+#include "pingus/savestate.hpp"
+#include "pingus/terrain_cache.hpp"
 #include "pingus/worldobj_factory.hpp"
 #include "pingus/worldobjs/entrance.hpp"
+#include "pingus/worldobjs/groundpiece.hpp"
+#include "util/raise_exception.hpp"
 
 namespace pingus {
 
-World::World(PingusLevel const& plf) :
+World::World(PingusLevel const& plf, uint32_t seed) :
   ambient_light(Color(plf.get_ambient_light())),
   gfx_map(new GroundMap(plf.get_size().width(), plf.get_size().height())),
   game_time(0),
@@ -49,7 +54,9 @@ World::World(PingusLevel const& plf) :
   snow_particle_holder(),
   pingus(new PinguHolder(plf)),
   colmap(gfx_map->get_colmap()),
-  gravitational_acceleration(0.2f)
+  gravitational_acceleration(0.2f),
+  random(seed),
+  loading_state(false)
 {
   WorldObj::set_world(this);
 
@@ -80,6 +87,15 @@ World::add_object (WorldObj* obj)
 void
 World::init_worldobjs(PingusLevel const& plf)
 {
+  // groundpieces only draw the terrain, which can be taken from an
+  // earlier start of the level instead
+  std::unique_ptr<TerrainCache> baked = TerrainCache::find(plf, gfx_map->get_width(),
+                                                           gfx_map->get_height());
+
+  // records what the terrain gets drawn from, which includes the
+  // masks some objects create in their constructor
+  CollisionMask::Recorder recorder;
+
   for (auto const& reader_object : plf.get_objects().get_objects())
   {
     std::vector<WorldObj*> objs = WorldObjFactory::instance().create(reader_object);
@@ -120,8 +136,38 @@ World::init_worldobjs(PingusLevel const& plf)
   // objects want to do
   for(auto obj = world_obj.begin(); obj != world_obj.end(); ++obj)
   {
-    (*obj)->on_startup();
+    if (!baked || !dynamic_cast<worldobjs::Groundpiece*>(*obj))
+      (*obj)->on_startup();
   }
+
+  if (baked)
+  {
+    try
+    {
+      baked->adopt(*gfx_map);
+    }
+    catch(std::exception const& err)
+    {
+      log_warn("{}: ignoring baked terrain: {}", TerrainCache::get_filename(plf), err.what());
+      baked.reset();
+
+      // draw everything again, the other objects are interleaved with
+      // the groundpieces, drawing them twice changes nothing else
+      gfx_map->clear_terrain();
+      for(auto obj = world_obj.begin(); obj != world_obj.end(); ++obj)
+      {
+        (*obj)->on_startup();
+      }
+    }
+  }
+
+  if (!baked)
+  {
+    TerrainCache::store(plf, *gfx_map, recorder.get_resources());
+  }
+
+  // from here on only changes done by the game have to go into savestates
+  gfx_map->track_changes();
 }
 
 World::~World()
@@ -129,6 +175,9 @@ World::~World()
   for (auto it = world_obj.begin(); it != world_obj.end(); ++it) {
     delete *it;
   }
+
+  // release the masks of level specific groundpieces
+  CollisionMask::cleanup_cache();
 }
 
 void
@@ -160,6 +209,10 @@ World::update()
 {
   WorldObj::set_world(this);
 
+  // all terrain edits of a tick count as a single change of the
+  // colmap, so the smallmap and colmap view only see the result
+  colmap->begin_batch();
+
   game_time += 1;
 
   if (do_armageddon)
@@ -195,6 +248,8 @@ World::update()
     // needs to catch pingus.
     (*obj)->update();
   }
+
+  colmap->end_batch();
 }
 
 PinguHolder*
@@ -246,6 +301,9 @@ World::get_gfx_map() const
 void
 World::play_sound(std::string const& name, Vector2f const& pos, float volume)
 {
+  if (loading_state)
+    return;
+
   // FIXME: Stereo is for the moment disabled
   /*
     Vector2f center = view->get_center();
@@ -269,13 +327,15 @@ World::get_pingu (Vector2f const& pos)
   Pingu* current_pingu = nullptr;
   float distance = -1.0;
 
-  for (PinguIter i = pingus->begin(); i != pingus->end(); ++i) {
-    if ((*i)->is_over(pos.x(), pos.y()))
+  // is_over() tests against the center, which is at most 16 pixel
+  // away from pos (above it, or to the side for climbers)
+  for (Pingu* pingu : pingus->query_rect(pos.x() - 32, pos.y() - 16, pos.x() + 32, pos.y() + 32)) {
+    if (pingu->is_over(pos.x(), pos.y()))
     {
-      if (distance == -1.0f || distance >= (*i)->dist(pos.x(), pos.y()))
+      if (distance == -1.0f || distance >= pingu->dist(pos.x(), pos.y()))
       {
-        current_pingu = (*i);
-        distance = (*i)->dist(pos.x(), pos.y());
+        current_pingu = pingu;
+        distance = pingu->dist(pos.x(), pos.y());
       }
     }
   }
@@ -303,8 +363,50 @@ World::put(CollisionMask const& mask, int x, int y, Groundtype::GPType type)
 void
 World::remove(CollisionMask const& mask, int x, int y)
 {
-  gfx_map->remove(mask.get_surface(), x, y);
-  colmap->remove(mask, x, y);
+  gfx_map->remove(mask, x, y);
+}
+
+uint64_t
+World::get_state_hash()
+{
+  uint64_t hash = colmap->get_hash();
+  SavestateStream stream = SavestateStream::hasher(hash);
+  sync_state(stream, false);
+  return hash;
+}
+
+void
+World::sync_state(SavestateStream& stream, bool with_terrain)
+{
+  WorldObj::set_world(this);
+
+  stream.sync(game_time);
+  stream.sync(do_armageddon);
+  stream.sync(armageddon_count);
+
+  uint64_t random_state = random.get_state();
+  stream.sync(random_state);
+  random.set_state(random_state);
+
+  uint64_t num_objs = world_obj.size();
+  stream.sync(num_objs);
+  if (num_objs != world_obj.size())
+  {
+    raise_exception(std::runtime_error, "savestate has " << num_objs << " objects, the world " << world_obj.size());
+  }
+
+  loading_state = stream.is_reading();
+  for (WorldObj* obj : world_obj)
+  {
+    if (obj != gfx_map)
+      obj->sync_state(stream);
+  }
+  loading_state = false;
+
+  // the terrain comes last, as recreating the pingu actions can
+  // change it, the basher starts bashing in its constructor
+  if (with_terrain)
+    gfx_map->sync_state(stream);
 }
 
 WorldObj*
@@ -20,6 +20,7 @@
 #include <string>
 #include <vector>
 
+#include "math/random.hpp"
 #include "math/vector2i.hpp"
 #include "pingus/collision_mask.hpp"
 #include "pingus/groundtype.hpp"
@@ -67,8 +68,16 @@ private:
   /** Acceleration due to gravity in the world */
   const float gravitational_acceleration;
 
+  /** Source of all randomness in the world, seeded so that a game
+      can be replayed exactly from a demo */
+  Random random;
+
+  /** Set while a savestate gets loaded, recreating the pingu actions
+      must not make any noise */
+  bool loading_state;
+
 public:
-  World(PingusLevel const& level);
+  World(PingusLevel const& level, uint32_t seed);
   virtual ~World();
 
   /** Add an object to the world, obj needs to be new'ed the World
@@ -102,8 +111,11 @@ public:
   GroundMap* get_gfx_map() const;
 
   void put(int x, int y, Groundtype::GPType p = Groundtype::GP_GROUND);
+
   void put(CollisionMask const&, int x, int y, Groundtype::GPType);
 
+  /** Remove the mask from the graphic and the colmap right away, in
+      a single pass, see GroundMap::remove() */
   void remove(CollisionMask const&, int x, int y);
 
   WorldObj* get_worldobj(std::string const& id);
@@ -141,6 +153,24 @@ public:
   /** Get the acceleration due to gravity in the world */
   float get_gravity() const;
 
+  /** @return the random number generator of this world, WorldObjs
+      must use it instead of rand() to keep demos reproducible */
+  Random& get_random() { return random; }
+
+  /** Store or restore the state of the world and all its objects,
+      the world has to be created from the same level as the one the
+      state was taken from
+
+      @param with_terrain if false the GroundMap is left out, its
+      changes have to be tracked separately, see RewindBuffer */
+  void sync_state(SavestateStream& stream, bool with_terrain = true);
+
+  /** @return a hash of the current state of the game, the colmap,
+      the pingus and all world objects, but not the graphics of the
+      ground. Two runs that produce the same hashes at the same times
+      behaved the same. */
+  uint64_t get_state_hash();
+
   /** Returns the start pos for the given player */
   Vector2i get_start_pos(int player_id) const;
 
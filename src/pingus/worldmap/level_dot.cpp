@@ -16,6 +16,8 @@
 
 #include "pingus/worldmap/level_dot.hpp"
 
+#include <logmich/log.hpp>
+
 #include "engine/display/drawing_context.hpp"
 #include "engine/input/control.hpp"
 #include "engine/screen/screen_manager.hpp"
@@ -36,18 +38,18 @@ LevelDot::LevelDot(ReaderMapping const& reader) :
   inaccessible_dot_sur("core/worldmap/dot_invalid"),
   highlight_green_dot_sur("core/worldmap/dot_green_hl"),
   highlight_red_dot_sur("core/worldmap/dot_red_hl"),
-  plf()
+  info()
 {
   std::string resname;
   reader.read("levelname", resname);
 
-  plf = PLFResMgr::load_plf(resname);
+  info = LevelIndex::get(resname);
 }
 
 void
 LevelDot::draw(DrawingContext& gc)
 {
-  Savegame* const savegame = SavegameManager::instance()->get(plf.get_resname());
+  Savegame* const savegame = SavegameManager::instance()->get(info.resname);
   if (savegame && (savegame->get_status() == Savegame::FINISHED ||
                    savegame->get_status() == Savegame::ACCESSIBLE))
   {
@@ -79,7 +81,7 @@ LevelDot::draw_hover(DrawingContext& gc)
     gc.print_center(pingus::fonts::pingus_small,
                     Vector2i(static_cast<int>(m_pos.x()),
                              static_cast<int>(m_pos.y()) - 44),
-                    _(get_plf().get_levelname()),
+                    _(info.levelname),
                     10000);
   }
   else
@@ -95,7 +97,7 @@ LevelDot::draw_hover(DrawingContext& gc)
   {
     gc.print_center(pingus::fonts::pingus_small,
                     Vector2i(static_cast<int>(m_pos.x()), static_cast<int>(m_pos.y()) - 70),
-                    get_plf().get_resname(),
+                    info.resname,
                     10000);
   }
 }
@@ -108,30 +110,37 @@ LevelDot::update(float delta)
 void
 LevelDot::on_click()
 {
-  ScreenManager::instance()->push_screen(std::make_shared<StartScreen>(plf));
+  try
+  {
+    ScreenManager::instance()->push_screen(std::make_shared<StartScreen>(PLFResMgr::load_plf(info.resname)));
+  }
+  catch(std::exception const& err)
+  {
+    log_error("failed to load: {}: {}", info.resname, err.what());
+  }
 }
 
 bool
 LevelDot::is_finished() const
 {
-  Savegame* savegame = SavegameManager::instance()->get(plf.get_resname());
+  Savegame* savegame = SavegameManager::instance()->get(info.resname);
   return savegame && savegame->get_status() == Savegame::FINISHED;
 }
 
 bool
 LevelDot::is_accessible() const
 {
-  Savegame* const savegame = SavegameManager::instance()->get(plf.get_resname());
+  Savegame* const savegame = SavegameManager::instance()->get(info.resname);
   return savegame && savegame->get_status() != Savegame::NONE;
 }
 
 void
 LevelDot::unlock()
 {
-  Savegame* const savegame = SavegameManager::instance()->get(plf.get_resname());
+  Savegame* const savegame = SavegameManager::instance()->get(info.resname);
   if (savegame == nullptr || savegame->get_status() == Savegame::NONE)
   {
-    Savegame savegame_(plf.get_resname(),
+    Savegame savegame_(info.resname,
                        Savegame::ACCESSIBLE,
                        0,
                        0);
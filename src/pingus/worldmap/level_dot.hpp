@@ -18,7 +18,7 @@
 #define HEADER_PINGUS_PINGUS_WORLDMAP_LEVEL_DOT_HPP
 
 #include "engine/display/sprite.hpp"
-#include "pingus/pingus_level.hpp"
+#include "pingus/level_index.hpp"
 #include "pingus/worldmap/dot.hpp"
 
 namespace pingus::worldmap {
@@ -32,13 +32,13 @@ public:
   void draw_hover(DrawingContext& gc) override;
 
   void update(float delta) override;
-   void on_click() override;
+  void on_click() override;
 
   bool is_finished() const override;
   bool is_accessible() const override;
   void unlock() override;
 
-  PingusLevel get_plf() const { return plf; }
+  LevelInfo const& get_info() const { return info; }
 
 private:
   Sprite green_dot_sur;
@@ -47,7 +47,8 @@ private:
   Sprite highlight_green_dot_sur;
   Sprite highlight_red_dot_sur;
 
-  PingusLevel plf;
+  /** The level is only loaded once the dot gets clicked */
+  LevelInfo info;
 
 private:
   LevelDot(LevelDot const&);
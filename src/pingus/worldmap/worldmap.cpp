@@ -21,6 +21,7 @@
 #include "engine/sound/sound.hpp"
 #include "pingus/gettext.h"
 #include "pingus/globals.hpp"
+#include "pingus/level_index.hpp"
 #include "pingus/stat_manager.hpp"
 #include "pingus/worldmap/drawable_factory.hpp"
 #include "pingus/worldmap/level_dot.hpp"
@@ -58,6 +59,10 @@ Worldmap::Worldmap(Pathname const& filename) :
   ReaderMapping const& path_graph_reader = worldmap.get_graph();
   path_graph.reset(new PathGraph(this, path_graph_reader));
 
+  // the level dots got their heads from the index, store the ones
+  // that had to be parsed
+  LevelIndex::flush();
+
   default_node = path_graph->lookup_node(worldmap.get_default_node());
   final_node   = path_graph->lookup_node(worldmap.get_final_node());
 
@@ -18,7 +18,7 @@
 
 namespace pingus {
 
-World* WorldObj::world;
+thread_local World* WorldObj::world;
 
 void
 WorldObj::set_world(World* arg_world)
@@ -55,6 +55,12 @@ WorldObj::update()
   // do nothing
 }
 
+void
+WorldObj::sync_state(SavestateStream& stream)
+{
+  // stateless by default
+}
+
 void
 WorldObj::draw_smallmap(SmallMap* smallmap)
 {
@@ -25,6 +25,7 @@
 
 namespace pingus {
 
+class SavestateStream;
 class SceneContext;
 class SmallMap;
 class World;
@@ -37,14 +38,15 @@ class World;
 class WorldObj
 {
 protected:
-  /** The World all WorldObjects live in. */
-  static World*  world;
+  /** The World all WorldObjects live in. The pointer is kept per
+      thread, so that multiple Worlds can be updated in parallel. */
+  static thread_local World*  world;
 
 public:
-  /** Set the world pointer for all world objects */
+  /** Set the world pointer for all world objects of the calling thread */
   static void   set_world(World*);
 
-  /** Return the current active world */
+  /** Return the current active world of the calling thread */
   static World* get_world() { return world; }
 
 private:
@@ -89,6 +91,11 @@ public:
    * delta = 1.0 means that one second of realtime has passed. */
   virtual void update();
 
+  /** Store or restore everything that update() changes, all other
+      members are expected to be the same in every World created from
+      the same level */
+  virtual void sync_state(SavestateStream& stream);
+
   /** Returns true if the object covers the whole screen */
   virtual bool is_solid_background() const;
 };
@@ -21,6 +21,7 @@
 #include "engine/display/scene_context.hpp"
 #include "pingus/pingu.hpp"
 #include "pingus/pingu_holder.hpp"
+#include "pingus/savestate.hpp"
 #include "pingus/world.hpp"
 
 namespace pingus::worldobjs {
@@ -81,19 +82,29 @@ ConveyorBelt::update()
   right_sur.update();
 
   PinguHolder* holder = world->get_pingus();
-  for (PinguIter pingu = holder->begin(); pingu != holder->end(); ++pingu)
+  for (Pingu* pingu : holder->query_rect(pos.x(), pos.y() - 2,
+                                         pos.x() + 15 * static_cast<float>(width + 2), pos.y() + 10))
   {
-    if (   (*pingu)->get_pos().x() > pos.x()
-           && (*pingu)->get_pos().x() < pos.x() + 15 * static_cast<float>(width + 2)
-           && (*pingu)->get_pos().y() > pos.y() - 2
-           && (*pingu)->get_pos().y() < pos.y() + 10)
+    if (   pingu->get_pos().x() > pos.x()
+           && pingu->get_pos().x() < pos.x() + 15 * static_cast<float>(width + 2)
+           && pingu->get_pos().y() > pos.y() - 2
+           && pingu->get_pos().y() < pos.y() + 10)
     {
-      (*pingu)->set_pos(Vector2f((*pingu)->get_pos().x() - speed * 0.025f,
-                                 (*pingu)->get_pos().y()));
+      pingu->set_pos(Vector2f(pingu->get_pos().x() - speed * 0.025f,
+                              pingu->get_pos().y()));
     }
   }
 }
 
+void
+ConveyorBelt::sync_state(SavestateStream& stream)
+{
+  stream.sync(counter);
+  stream.sync(left_sur);
+  stream.sync(right_sur);
+  stream.sync(middle_sur);
+}
+
 float
 ConveyorBelt::z_index() const
 {
@@ -22,6 +22,7 @@
 #include "pingus/components/smallmap.hpp"
 #include "pingus/pingu.hpp"
 #include "pingus/pingu_holder.hpp"
+#include "pingus/savestate.hpp"
 #include "pingus/world.hpp"
 
 namespace pingus::worldobjs {
@@ -144,6 +145,14 @@ Entrance::update()
   }
 }
 
+void
+Entrance::sync_state(SavestateStream& stream)
+{
+  stream.sync(last_release);
+  stream.sync(last_direction);
+  stream.sync(surface);
+}
+
 void
 Entrance::draw (SceneContext& gc)
 {
@@ -54,6 +54,7 @@ public:
   virtual void   create_pingu();
 
   void   update() override;
+  void   sync_state(SavestateStream& stream) override;
 
   void   draw (SceneContext& gc) override;
 
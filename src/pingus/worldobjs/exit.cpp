@@ -23,6 +23,7 @@
 #include "pingus/components/smallmap.hpp"
 #include "pingus/pingu.hpp"
 #include "pingus/pingu_holder.hpp"
+#include "pingus/savestate.hpp"
 #include "pingus/world.hpp"
 
 namespace pingus::worldobjs {
@@ -82,28 +83,36 @@ Exit::update()
 
   PinguHolder* holder = world->get_pingus();
 
-  for (PinguIter pingu = holder->begin(); pingu != holder->end(); ++pingu)
+  for (Pingu* pingu : holder->query_rect(pos.x() - 1, pos.y() - 5,
+                                         pos.x() + 1, pos.y() + 5))
   {
     // Make sure this particular exit is allowed for this pingu
-    if ((*pingu)->get_owner()  == owner_id)
+    if (pingu->get_owner()  == owner_id)
     {
       // Now, make sure the pingu is within range
-      if (   (*pingu)->get_pos().x() > pos.x() - 1 && (*pingu)->get_pos().x() < pos.x() + 1
-             && (*pingu)->get_pos().y() > pos.y() - 5 && (*pingu)->get_pos().y() < pos.y() + 5)
+      if (   pingu->get_pos().x() > pos.x() - 1 && pingu->get_pos().x() < pos.x() + 1
+             && pingu->get_pos().y() > pos.y() - 5 && pingu->get_pos().y() < pos.y() + 5)
       {
         // Now, make sure the pingu isn't already exiting, gone, or dead
-        if (   (*pingu)->get_status() != Pingu::PS_EXITED
-               && (*pingu)->get_status() != Pingu::PS_DEAD
-               && (*pingu)->get_action() != ActionName::EXITER)
+        if (   pingu->get_status() != Pingu::PS_EXITED
+               && pingu->get_status() != Pingu::PS_DEAD
+               && pingu->get_action() != ActionName::EXITER)
         {
           // Pingu actually exits
-          (*pingu)->set_action(ActionName::EXITER);
+          pingu->set_action(ActionName::EXITER);
         }
       }
     }
   }
 }
 
+void
+Exit::sync_state(SavestateStream& stream)
+{
+  stream.sync(sprite);
+  stream.sync(flag);
+}
+
 float
 Exit::z_index() const
 {
@@ -45,6 +45,7 @@ public:
   void  draw_smallmap(SmallMap* smallmap) override;
 
   void  update() override;
+  void  sync_state(SavestateStream& stream) override;
 
   float z_index() const override;
   void set_z_index(float z_index) override { m_z_index = z_index; }
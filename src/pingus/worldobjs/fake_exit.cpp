@@ -20,6 +20,7 @@
 #include "pingus/components/smallmap.hpp"
 #include "pingus/pingu.hpp"
 #include "pingus/pingu_holder.hpp"
+#include "pingus/savestate.hpp"
 #include "pingus/world.hpp"
 
 namespace pingus::worldobjs {
@@ -50,20 +51,28 @@ FakeExit::draw (SceneContext& gc)
 void
 FakeExit::update()
 {
+  if (surface.is_finished())
+    smashing = false;
+
   PinguHolder* holder = world->get_pingus();
-  for (PinguIter pingu = holder->begin(); pingu != holder->end(); ++pingu)
-    catch_pingu(*pingu);
+  for (Pingu* pingu : holder->query_rect(pos.x() - 7, pos.y() - 56,
+                                         pos.x() + 8, pos.y()))
+    catch_pingu(pingu);
 
   if (smashing)
     surface.update();
 }
 
 void
-FakeExit::catch_pingu (Pingu* pingu)
+FakeExit::sync_state(SavestateStream& stream)
 {
-  if (surface.is_finished())
-    smashing = false;
+  stream.sync(surface);
+  stream.sync(smashing);
+}
 
+void
+FakeExit::catch_pingu (Pingu* pingu)
+{
   if (   pingu->get_pos().x() > pos.x() - 7  && pingu->get_pos().x() < pos.x() + 8
          && pingu->get_pos().y() > pos.y() - 56 && pingu->get_pos().y() < pos.y())
   {
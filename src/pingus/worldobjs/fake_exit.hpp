@@ -48,6 +48,7 @@ public:
   void draw (SceneContext& gc) override;
 
   void update() override;
+  void sync_state(SavestateStream& stream) override;
 
   /** Draws an exit symbol on to the small map. */
   void draw_smallmap(SmallMap* smallmap) override;
@@ -19,6 +19,7 @@
 #include "engine/display/scene_context.hpp"
 #include "pingus/pingu.hpp"
 #include "pingus/pingu_holder.hpp"
+#include "pingus/savestate.hpp"
 #include "pingus/world.hpp"
 
 namespace pingus::worldobjs {
@@ -67,8 +68,9 @@ Guillotine::update()
     killing = false;
 
   PinguHolder* holder = world->get_pingus();
-  for (PinguIter pingu = holder->begin(); pingu != holder->end(); ++pingu)
-    catch_pingu(*pingu);
+  for (Pingu* pingu : holder->query_rect(pos.x() + 38, pos.y() + 90,
+                                         pos.x() + 42, pos.y() + 98))
+    catch_pingu(pingu);
 
   if (killing) {
     // Update both sprites so they finish at the same time.
@@ -82,6 +84,16 @@ Guillotine::update()
   }
 }
 
+void
+Guillotine::sync_state(SavestateStream& stream)
+{
+  stream.sync(sprite_kill_right);
+  stream.sync(sprite_kill_left);
+  stream.sync(sprite_idle);
+  stream.sync(direction);
+  stream.sync(killing);
+}
+
 void
 Guillotine::catch_pingu (Pingu* pingu)
 {
@@ -45,6 +45,7 @@ public:
   Vector2f get_pos() const override { return pos; }
 
   void update() override;
+  void sync_state(SavestateStream& stream) override;
   void draw(SceneContext& gc) override;
 protected:
   void catch_pingu(Pingu*);
@@ -19,6 +19,7 @@
 #include "engine/display/scene_context.hpp"
 #include "pingus/pingu.hpp"
 #include "pingus/pingu_holder.hpp"
+#include "pingus/savestate.hpp"
 #include "pingus/world.hpp"
 
 namespace pingus::worldobjs {
@@ -58,9 +59,9 @@ Hammer::update()
     {
       PinguHolder* holder = world->get_pingus();
 
-      for (PinguIter pingu_it = holder->begin(); pingu_it != holder->end(); ++pingu_it)
+      for (Pingu* pingu : holder->query_rect(pos.x() + 55, pos.y() + 146,
+                                             pos.x() + 77, pos.y() + 185))
       {
-        Pingu* pingu = *pingu_it;
         if (pingu->get_action() != ActionName::SPLASHED)
         {
           if (pingu->get_x() > pos.x() + 55  && pingu->get_x() < pos.x() + 77
@@ -83,6 +84,14 @@ Hammer::update()
   }
 }
 
+void
+Hammer::sync_state(SavestateStream& stream)
+{
+  stream.sync(sprite);
+  stream.sync(m_down);
+  stream.sync(m_count);
+}
+
 } // namespace pingus::worldobjs
 
 /* EOF */
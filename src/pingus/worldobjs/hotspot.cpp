@@ -18,6 +18,7 @@
 
 #include "engine/display/scene_context.hpp"
 #include "pingus/res_descriptor.hpp"
+#include "pingus/savestate.hpp"
 
 namespace pingus::worldobjs {
 
@@ -47,6 +48,12 @@ Hotspot::update()
   sprite.update();
 }
 
+void
+Hotspot::sync_state(SavestateStream& stream)
+{
+  stream.sync(sprite);
+}
+
 void
 Hotspot::draw (SceneContext& gc)
 {
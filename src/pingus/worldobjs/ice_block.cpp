@@ -21,6 +21,7 @@
 #include "engine/display/scene_context.hpp"
 #include "pingus/pingu.hpp"
 #include "pingus/pingu_holder.hpp"
+#include "pingus/savestate.hpp"
 #include "pingus/world.hpp"
 
 namespace pingus::worldobjs {
@@ -72,10 +73,12 @@ IceBlock::update()
 
   PinguHolder* holder = world->get_pingus();
 
-  for (PinguIter pingu = holder->begin(); pingu != holder->end(); ++pingu)
+  for (Pingu* pingu : holder->query_rect(pos.x(), pos.y() - 4,
+                                         pos.x() + static_cast<float>(block_sur.get_width()),
+                                         pos.y() + static_cast<float>(block_sur.get_height())))
   {
-    if ((*pingu)->get_x() > pos.x()     && (*pingu)->get_x() < pos.x() + static_cast<float>(block_sur.get_width()) &&
-        (*pingu)->get_y() > pos.y() - 4 && (*pingu)->get_y() < pos.y() + static_cast<float>(block_sur.get_height()))
+    if (pingu->get_x() > pos.x()     && pingu->get_x() < pos.x() + static_cast<float>(block_sur.get_width()) &&
+        pingu->get_y() > pos.y() - 4 && pingu->get_y() < pos.y() + static_cast<float>(block_sur.get_height()))
     {
       last_contact = world->get_time();
     }
@@ -97,6 +100,15 @@ IceBlock::update()
   }
 }
 
+void
+IceBlock::sync_state(SavestateStream& stream)
+{
+  stream.sync(thickness);
+  stream.sync(is_finished);
+  stream.sync(last_contact);
+  stream.sync(block_sur);
+}
+
 } // namespace pingus::worldobjs
 
 /* EOF */
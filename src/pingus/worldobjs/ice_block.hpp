@@ -50,6 +50,7 @@ public:
   void on_startup() override;
   void draw (SceneContext& gc) override;
   void update() override;
+  void sync_state(SavestateStream& stream) override;
 
 private:
   IceBlock (IceBlock const&);
@@ -19,6 +19,7 @@
 #include "engine/display/scene_context.hpp"
 #include "pingus/pingu.hpp"
 #include "pingus/pingu_holder.hpp"
+#include "pingus/savestate.hpp"
 #include "pingus/world.hpp"
 
 namespace pingus::worldobjs {
@@ -50,8 +51,9 @@ LaserExit::update()
 {
 
   PinguHolder* holder = world->get_pingus();
-  for (PinguIter pingu = holder->begin(); pingu != holder->end(); ++pingu){
-    catch_pingu(*pingu);
+  for (Pingu* pingu : holder->query_rect(pos.x() + 34, pos.y() + 43,
+                                         pos.x() + 44, pos.y() + 63)) {
+    catch_pingu(pingu);
   }
 
   if (killing) {
@@ -64,6 +66,13 @@ LaserExit::update()
   }
 }
 
+void
+LaserExit::sync_state(SavestateStream& stream)
+{
+  stream.sync(surface);
+  stream.sync(killing);
+}
+
 void
 LaserExit::catch_pingu (Pingu* pingu)
 {
@@ -18,6 +18,7 @@
 
 #include "engine/display/scene_context.hpp"
 #include "pingus/collision_map.hpp"
+#include "pingus/savestate.hpp"
 #include "pingus/world.hpp"
 
 namespace pingus::worldobjs {
@@ -51,13 +52,24 @@ Liquid::z_index() const
 void
 Liquid::on_startup()
 {
+  if (width <= 0)
+    return;
+
   CollisionMask mask("liquids/water_cmap");
 
-  for(int i=0; i < width; ++i)
-    world->get_colmap()->put(mask,
-                             static_cast<int>(pos.x() + static_cast<float>(i)),
-                             static_cast<int>(pos.y()),
-                             Groundtype::GP_WATER);
+  // Stamping the mask at every x in [0, width) stretches each of its
+  // spans by width - 1 pixels, so fill the stretched spans directly
+  int const x_pos = static_cast<int>(pos.x());
+  int const y_pos = static_cast<int>(pos.y());
+  for (int y = 0; y < mask.get_height(); ++y)
+  {
+    for (CollisionMask::Span const& span : mask.get_spans(y))
+    {
+      world->get_colmap()->fill_rect(Rect(x_pos + span.x, y_pos + y,
+                                          x_pos + span.x + span.len + width - 1, y_pos + y + 1),
+                                     Groundtype::GP_WATER);
+    }
+  }
 }
 
 void
@@ -77,6 +89,12 @@ Liquid::update()
   sur.update(0.033f);
 }
 
+void
+Liquid::sync_state(SavestateStream& stream)
+{
+  stream.sync(sur);
+}
+
 } // namespace pingus::worldobjs
 
 /* EOF */
@@ -47,6 +47,7 @@ public:
   void  on_startup() override;
   void  draw(SceneContext& gc) override;
   void  update() override;
+  void  sync_state(SavestateStream& stream) override;
 
 private:
   Liquid (Liquid const&) = delete;
@@ -21,6 +21,7 @@
 #include "engine/display/scene_context.hpp"
 #include "engine/sound/sound.hpp"
 #include "pingus/particles/rain_particle_holder.hpp"
+#include "pingus/savestate.hpp"
 #include "pingus/world.hpp"
 
 namespace pingus::worldobjs {
@@ -54,7 +55,7 @@ RainGenerator::draw (SceneContext& gc)
 void
 RainGenerator::update()
 {
-  if (waiter_count < 0.0f && rand() % 150 == 0)
+  if (waiter_count < 0.0f && world->get_random().rand(150) == 0)
   {
     log_info("Doing thunder");
     do_thunder = true;
@@ -69,7 +70,15 @@ RainGenerator::update()
   waiter_count -= 20.0f * 0.025f;
 
   for (int i=0; i < 16; ++i)
-    world->get_rain_particle_holder()->add_particle(rand() % (world->get_width() * 2), -32);
+    world->get_rain_particle_holder()->add_particle(world->get_random().rand(world->get_width() * 2), -32);
+}
+
+void
+RainGenerator::sync_state(SavestateStream& stream)
+{
+  stream.sync(do_thunder);
+  stream.sync(thunder_count);
+  stream.sync(waiter_count);
 }
 
 } // namespace pingus::worldobjs
@@ -33,6 +33,7 @@ public:
   ~RainGenerator() override;
 
   void update() override;
+  void sync_state(SavestateStream& stream) override;
   void draw (SceneContext& gc) override;
   float z_index() const override { return 1000; }
   void set_z_index(float z_index) override {}
@@ -17,6 +17,7 @@
 #include "pingus/worldobjs/smasher.hpp"
 
 #include <assert.h>
+#include <limits>
 
 #include <logmich/log.hpp>
 
@@ -25,6 +26,7 @@
 #include "pingus/particles/smoke_particle_holder.hpp"
 #include "pingus/pingu.hpp"
 #include "pingus/pingu_holder.hpp"
+#include "pingus/savestate.hpp"
 #include "pingus/world.hpp"
 
 namespace pingus::worldobjs {
@@ -53,9 +55,11 @@ void
 Smasher::update()
 {
   PinguHolder* holder = world->get_pingus();
-  for (PinguIter pingu = holder->begin(); pingu != holder->end(); ++pingu)
+  // the smasher catches pingus at any height, only the x range matters
+  for (Pingu* pingu : holder->query_rect(pos.x() + 65, std::numeric_limits<float>::lowest(),
+                                         pos.x() + 210, std::numeric_limits<float>::max()))
   {
-    catch_pingu(*pingu);
+    catch_pingu(pingu);
   }
 
   if (smashing)
@@ -71,22 +75,25 @@ Smasher::update()
         --count;
         pingus::sound::PingusSound::play_sound("tenton");
 
+        Random& random = world->get_random();
         for(int i=0; i < 20; ++i)
         {
-          world->get_smoke_particle_holder()->
-            add_particle(pos.x() + 20 + float(rand() % 260),
-                         pos.y() + 180, Math::frand()-0.5f, Math::frand()-0.5f);
+          float const x     = pos.x() + 20 + float(random.rand(260));
+          float const vel_x = random.frand() - 0.5f;
+          float const vel_y = random.frand() - 0.5f;
+          world->get_smoke_particle_holder()->add_particle(x, pos.y() + 180, vel_x, vel_y);
         }
 
-        for (PinguIter pingu = holder->begin(); pingu != holder->end(); ++pingu)
+        for (Pingu* pingu : holder->query_rect(pos.x() + 30, pos.y() + 90,
+                                               pos.x() + 250, pos.y() + 190))
         {
-          if ((*pingu)->is_inside(pos.x() + 30,
+          if (pingu->is_inside(pos.x() + 30,
                                   pos.y() + 90,
                                   pos.x() + 250,
                                   pos.y() + 190))
           {
-            if ((*pingu)->get_action() != ActionName::SPLASHED)
-              (*pingu)->set_action(ActionName::SPLASHED);
+            if (pingu->get_action() != ActionName::SPLASHED)
+              pingu->set_action(ActionName::SPLASHED);
           }
         }
       }
@@ -108,6 +115,15 @@ Smasher::update()
   }
 }
 
+void
+Smasher::sync_state(SavestateStream& stream)
+{
+  stream.sync(sprite);
+  stream.sync(smashing);
+  stream.sync(downwards);
+  stream.sync(count);
+}
+
 void
 Smasher::on_startup()
 {
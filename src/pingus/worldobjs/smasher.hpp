@@ -44,6 +44,7 @@ public:
   void draw (SceneContext& gc) override;
   void on_startup() override;
   void update() override;
+  void sync_state(SavestateStream& stream) override;
 
 protected:
   void catch_pingu (Pingu* pingu);
@@ -19,6 +19,7 @@
 #include "engine/display/scene_context.hpp"
 #include "pingus/pingu.hpp"
 #include "pingus/pingu_holder.hpp"
+#include "pingus/savestate.hpp"
 #include "pingus/world.hpp"
 
 namespace pingus::worldobjs {
@@ -56,13 +57,21 @@ Spike::update()
     surface.update();
 
   PinguHolder* holder = world->get_pingus();
-  for (PinguIter pingu = holder->begin(); pingu != holder->end(); ++pingu)
-    catch_pingu(*pingu);
+  for (Pingu* pingu : holder->query_rect(pos.x() + 16 - 12, pos.y(),
+                                         pos.x() + 16 + 12, pos.y() + 32))
+    catch_pingu(pingu);
 
   if (surface.get_current_frame() == surface.get_frame_count() - 1)
     killing = false;
 }
 
+void
+Spike::sync_state(SavestateStream& stream)
+{
+  stream.sync(surface);
+  stream.sync(killing);
+}
+
 void
 Spike::catch_pingu (Pingu* pingu)
 {
@@ -41,6 +41,7 @@ public:
 
   void draw (SceneContext& gc) override;
   void update() override;
+  void sync_state(SavestateStream& stream) override;
 
 protected:
   void catch_pingu (Pingu*);
@@ -16,6 +16,7 @@
 
 #include "pingus/worldobjs/starfield_background.hpp"
 
+#include "pingus/savestate.hpp"
 #include "pingus/worldobjs/starfield_background_stars.hpp"
 
 namespace pingus::worldobjs {
@@ -56,6 +57,15 @@ StarfieldBackground::update()
   }
 }
 
+void
+StarfieldBackground::sync_state(SavestateStream& stream)
+{
+  for (StarfieldBackgroundStars* star : stars)
+  {
+    star->sync_state(stream);
+  }
+}
+
 void
 StarfieldBackground::draw (SceneContext& gc)
 {
@@ -18,6 +18,7 @@
 
 #include "engine/display/scene_context.hpp"
 #include "pingus/globals.hpp"
+#include "pingus/savestate.hpp"
 #include "pingus/world.hpp"
 
 namespace pingus::worldobjs {
@@ -42,10 +43,11 @@ StarfieldBackgroundStars::StarfieldBackgroundStars (Type type) :
       break;
   }
 
-  x_pos = float(rand() % WorldObj::get_world()->get_width());
-  y_pos = float(rand() % WorldObj::get_world()->get_height());
+  Random& random = WorldObj::get_world()->get_random();
+  x_pos = float(random.rand(WorldObj::get_world()->get_width()));
+  y_pos = float(random.rand(WorldObj::get_world()->get_height()));
 
-  x_add = static_cast<float>(rand() % 5) + 1.0f;
+  x_add = static_cast<float>(random.rand(5)) + 1.0f;
   y_add = 0.0f;
 }
 
@@ -58,10 +60,17 @@ StarfieldBackgroundStars::update()
   if (x_pos > static_cast<float>(WorldObj::get_world()->get_width()))
   {
     x_pos = float(-globals::tile_size);
-    y_pos = float(rand() % WorldObj::get_world()->get_height());
+    y_pos = float(WorldObj::get_world()->get_random().rand(WorldObj::get_world()->get_height()));
   }
 }
 
+void
+StarfieldBackgroundStars::sync_state(SavestateStream& stream)
+{
+  stream.sync(x_pos);
+  stream.sync(y_pos);
+}
+
 void
 StarfieldBackgroundStars::draw (SceneContext& gc)
 {
@@ -51,6 +51,7 @@ public:
 
   void init();
   void update();
+  void sync_state(SavestateStream& stream);
   void draw (SceneContext& gc);
 
 private:
@@ -19,6 +19,7 @@
 #include "engine/display/scene_context.hpp"
 #include "pingus/globals.hpp"
 #include "pingus/resource.hpp"
+#include "pingus/savestate.hpp"
 #include "pingus/world.hpp"
 
 namespace pingus::worldobjs {
@@ -158,6 +159,14 @@ SurfaceBackground::update()
   }
 }
 
+void
+SurfaceBackground::sync_state(SavestateStream& stream)
+{
+  stream.sync(scroll_ox);
+  stream.sync(scroll_oy);
+  stream.sync(bg_sprite);
+}
+
 void
 SurfaceBackground::draw (SceneContext& gc)
 {
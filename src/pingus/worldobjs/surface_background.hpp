@@ -73,6 +73,7 @@ public:
   Vector2f get_pos() const override { return Vector2f(); }
 
   void update() override;
+  void sync_state(SavestateStream& stream) override;
   void draw(SceneContext& gc) override;
 
   bool is_solid_background() const override { return true; }
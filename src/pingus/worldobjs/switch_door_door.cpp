@@ -20,6 +20,7 @@
 #include "pingus/collision_map.hpp"
 #include "pingus/pingu.hpp"
 #include "pingus/pingu_holder.hpp"
+#include "pingus/savestate.hpp"
 #include "pingus/world.hpp"
 
 namespace pingus::worldobjs {
@@ -97,6 +98,13 @@ SwitchDoorDoor::update()
   }
 }
 
+void
+SwitchDoorDoor::sync_state(SavestateStream& stream)
+{
+  stream.sync(is_opening);
+  stream.sync(current_door_height);
+}
+
 void
 SwitchDoorDoor::open_door()
 {
@@ -22,6 +22,7 @@
 #include "pingus/collision_map.hpp"
 #include "pingus/pingu.hpp"
 #include "pingus/pingu_holder.hpp"
+#include "pingus/savestate.hpp"
 #include "pingus/world.hpp"
 #include "pingus/worldobjs/switch_door_door.hpp"
 
@@ -71,12 +72,14 @@ SwitchDoorSwitch::update()
       // Check if a pingu is passing the switch
       PinguHolder* holder = world->get_pingus();
 
-      for (PinguIter pingu = holder->begin(); pingu != holder->end(); ++pingu)
+      for (Pingu* pingu : holder->query_rect(switch_pos.x(), switch_pos.y(),
+                                             switch_pos.x() + static_cast<float>(switch_sur.get_width()),
+                                             switch_pos.y() + static_cast<float>(switch_sur.get_height())))
       {
-        if ((*pingu)->get_pos().x() > switch_pos.x() &&
-            (*pingu)->get_pos().x() < switch_pos.x() + static_cast<float>(switch_sur.get_width()) &&
-            (*pingu)->get_pos().y() > switch_pos.y() &&
-            (*pingu)->get_pos().y() < switch_pos.y() + static_cast<float>(switch_sur.get_height()))
+        if (pingu->get_pos().x() > switch_pos.x() &&
+            pingu->get_pos().x() < switch_pos.x() + static_cast<float>(switch_sur.get_width()) &&
+            pingu->get_pos().y() > switch_pos.y() &&
+            pingu->get_pos().y() < switch_pos.y() + static_cast<float>(switch_sur.get_height()))
         {
           is_triggered = true;
           m_door->open_door();
@@ -87,6 +90,13 @@ SwitchDoorSwitch::update()
   }
 }
 
+void
+SwitchDoorSwitch::sync_state(SavestateStream& stream)
+{
+  stream.sync(switch_sur);
+  stream.sync(is_triggered);
+}
+
 } // namespace pingus::worldobjs
 
 /* EOF */
@@ -44,6 +44,7 @@ public:
   void on_startup() override;
   void draw (SceneContext& gc) override;
   void update() override;
+  void sync_state(SavestateStream& stream) override;
 
   /// The switch and the door should stay above the pingus
   float z_index() const override { return 100; }
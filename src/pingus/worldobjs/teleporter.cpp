@@ -21,6 +21,7 @@
 #include "engine/display/scene_context.hpp"
 #include "pingus/pingu.hpp"
 #include "pingus/pingu_holder.hpp"
+#include "pingus/savestate.hpp"
 #include "pingus/world.hpp"
 #include "pingus/worldobjs/teleporter_target.hpp"
 
@@ -74,12 +75,13 @@ Teleporter::update()
   if (target)
   {
     PinguHolder* holder = world->get_pingus();
-    for (PinguIter pingu = holder->begin(); pingu != holder->end(); ++pingu)
+    for (Pingu* pingu : holder->query_rect(pos.x() - 3, pos.y() - 52,
+                                           pos.x() + 3, pos.y()))
     {
-      if (   (*pingu)->get_x() > pos.x() - 3  && (*pingu)->get_x() < pos.x() + 3
-             && (*pingu)->get_y() > pos.y() - 52 && (*pingu)->get_y() < pos.y())
+      if (   pingu->get_x() > pos.x() - 3  && pingu->get_x() < pos.x() + 3
+             && pingu->get_y() > pos.y() - 52 && pingu->get_y() < pos.y())
       {
-        (*pingu)->set_pos(target->get_pos().x(), target->get_pos().y());
+        pingu->set_pos(target->get_pos().x(), target->get_pos().y());
         target->teleporter_used();
         sprite.restart();
       }
@@ -87,6 +89,12 @@ Teleporter::update()
   }
 }
 
+void
+Teleporter::sync_state(SavestateStream& stream)
+{
+  stream.sync(sprite);
+}
+
 } // namespace pingus::worldobjs
 
 /* EOF */
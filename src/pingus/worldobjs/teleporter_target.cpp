@@ -17,6 +17,7 @@
 #include "pingus/worldobjs/teleporter_target.hpp"
 
 #include "engine/display/scene_context.hpp"
+#include "pingus/savestate.hpp"
 
 namespace pingus::worldobjs {
 
@@ -48,6 +49,12 @@ TeleporterTarget::update()
   sprite.update();
 }
 
+void
+TeleporterTarget::sync_state(SavestateStream& stream)
+{
+  stream.sync(sprite);
+}
+
 void
 TeleporterTarget::teleporter_used()
 {
@@ -34,6 +34,7 @@ public:
 
   void  draw (SceneContext& gc) override;
   void  update() override;
+  void  sync_state(SavestateStream& stream) override;
   float z_index() const override;
   void set_z_index(float z_index) override { m_z_index = z_index; }
   void set_pos(Vector2f const& p) override { pos = p; }
@@ -0,0 +1,174 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "util/archive.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <string.h>
+
+#include "util/raise_exception.hpp"
+#include "util/varint.hpp"
+
+namespace pingus {
+
+namespace {
+
+char const magic[] = "PINGPACK";
+size_t const magic_size = sizeof(magic) - 1;
+uint8_t const version = 1;
+
+uint64_t read_varint(uint8_t const* data, size_t size, size_t& pos)
+{
+  uint64_t value;
+  if (!get_varint(data, size, pos, value))
+  {
+    if (pos >= size)
+      raise_exception(std::runtime_error, "archive index truncated");
+    else
+      raise_exception(std::runtime_error, "invalid varint in archive index");
+  }
+  return value;
+}
+
+} // namespace
+
+Archive::Archive(std::string const& filename) :
+  m_file(filename),
+  m_entries()
+{
+  uint8_t const* data = m_file.data();
+  size_t const size = m_file.size();
+
+  if (size < magic_size + 1 || memcmp(data, magic, magic_size) != 0)
+  {
+    raise_exception(std::runtime_error, filename << ": not a pingus archive");
+  }
+
+  if (data[magic_size] != version)
+  {
+    raise_exception(std::runtime_error, filename << ": unsupported archive version "
+                    << static_cast<int>(data[magic_size]));
+  }
+
+  size_t pos = magic_size + 1;
+  uint64_t const count = read_varint(data, size, pos);
+
+  struct Item
+  {
+    std::string path;
+    uint64_t offset;
+    uint64_t size;
+  };
+  std::vector<Item> items;
+  for (uint64_t i = 0; i < count; ++i)
+  {
+    uint64_t const length = read_varint(data, size, pos);
+    if (length > size - pos)
+    {
+      raise_exception(std::runtime_error, filename << ": archive index truncated");
+    }
+
+    Item item;
+    item.path.assign(reinterpret_cast<char const*>(data + pos), static_cast<size_t>(length));
+    pos += static_cast<size_t>(length);
+    item.offset = read_varint(data, size, pos);
+    item.size = read_varint(data, size, pos);
+    items.push_back(std::move(item));
+  }
+
+  // the data starts right after the index
+  size_t const data_size = size - pos;
+  for (Item const& item : items)
+  {
+    if (item.offset > data_size || item.size > data_size - item.offset)
+    {
+      raise_exception(std::runtime_error, filename << ": '" << item.path << "' is out of bounds");
+    }
+
+    m_entries[item.path] = Entry{ pos + static_cast<size_t>(item.offset), static_cast<size_t>(item.size) };
+  }
+}
+
+bool
+Archive::find(std::string const& path, std::string_view& data_out) const
+{
+  auto it = m_entries.find(path);
+  if (it == m_entries.end())
+  {
+    return false;
+  }
+  else
+  {
+    data_out = std::string_view(reinterpret_cast<char const*>(m_file.data()) + it->second.offset,
+                                it->second.size);
+    return true;
+  }
+}
+
+std::vector<std::string>
+Archive::get_paths() const
+{
+  std::vector<std::string> paths;
+  paths.reserve(m_entries.size());
+  for (auto const& entry : m_entries)
+  {
+    paths.push_back(entry.first);
+  }
+  return paths;
+}
+
+void
+Archive::write(std::string const& filename, std::vector<File> const& files)
+{
+  std::string index;
+  index.append(magic, magic_size);
+  index += static_cast<char>(version);
+  put_varint(index, files.size());
+
+  std::string content;
+  for (File const& file : files)
+  {
+    std::ifstream in(file.filename, std::ios::binary);
+    if (!in)
+    {
+      raise_exception(std::runtime_error, "couldn't read " << file.filename);
+    }
+
+    std::ostringstream buffer;
+    buffer << in.rdbuf();
+    std::string const data = buffer.str();
+
+    put_varint(index, file.path.size());
+    index += file.path;
+    put_varint(index, content.size());
+    put_varint(index, data.size());
+
+    content += data;
+  }
+
+  std::ofstream out(filename, std::ios::binary);
+  out.write(index.data(), static_cast<std::streamsize>(index.size()));
+  out.write(content.data(), static_cast<std::streamsize>(content.size()));
+  if (!out)
+  {
+    raise_exception(std::runtime_error, "couldn't write " << filename);
+  }
+}
+
+} // namespace pingus
+
+/* EOF */
@@ -0,0 +1,91 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_PINGUS_UTIL_ARCHIVE_HPP
+#define HEADER_PINGUS_UTIL_ARCHIVE_HPP
+
+#include <stdint.h>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "util/mapped_file.hpp"
+
+namespace pingus {
+
+/** A read-only pack of many small files in a single memory mapped
+    file, so that loading them costs one open instead of one per
+    file. Archives are written by extra/pingus-pack, all numbers are
+    varints:
+
+    magic    "PINGPACK"
+    version  uint8
+    count    number of files
+    index    count times the path (length + bytes), the offset of the
+             content from the start of the data and its size
+    data     the content of all files
+
+    @brief Packed file archive */
+class Archive
+{
+public:
+  /** A file to be written into an archive */
+  struct File
+  {
+    /** The path under which it can be found in the archive */
+    std::string path;
+
+    /** The file to read the content from */
+    std::string filename;
+  };
+
+private:
+  struct Entry
+  {
+    size_t offset;
+    size_t size;
+  };
+
+  MappedFile m_file;
+  std::unordered_map<std::string, Entry> m_entries;
+
+public:
+  /** Throws std::runtime_error if the file can't be opened or isn't
+      a valid archive */
+  explicit Archive(std::string const& filename);
+
+  /** @return true if path is in the archive, data_out then views its
+      content, which stays valid as long as the archive exists */
+  bool find(std::string const& path, std::string_view& data_out) const;
+
+  /** @return the paths of all files in the archive */
+  std::vector<std::string> get_paths() const;
+
+  /** Write files into an archive at filename, throws
+      std::runtime_error if a file can't be read or written */
+  static void write(std::string const& filename, std::vector<File> const& files);
+
+private:
+  Archive(Archive const&);
+  Archive& operator=(Archive const&);
+};
+
+} // namespace pingus
+
+#endif
+
+/* EOF */
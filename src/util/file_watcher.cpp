@@ -0,0 +1,268 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "util/file_watcher.hpp"
+
+#include <vector>
+
+#ifdef __linux__
+#  include <poll.h>
+#  include <sys/inotify.h>
+#  include <unistd.h>
+#endif
+
+#include <logmich/log.hpp>
+
+namespace pingus {
+
+FileWatcher::FileWatcher(Callback callback, Mode mode, std::chrono::milliseconds interval) :
+  m_callback(std::move(callback)),
+  m_interval(interval),
+  m_mutex(),
+  m_cond(),
+  m_quit(false),
+  m_fd(-1),
+  m_directories(),
+  m_polled(),
+  m_thread()
+{
+#ifdef __linux__
+  if (mode == AUTO)
+  {
+    m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_fd < 0)
+    {
+      log_warn("FileWatcher: inotify not available, falling back to polling");
+    }
+  }
+#else
+  (void) mode;
+#endif
+
+  if (m_fd >= 0)
+  {
+    m_thread = std::thread(&FileWatcher::run_inotify, this);
+  }
+  else
+  {
+    m_thread = std::thread(&FileWatcher::run_polling, this);
+  }
+}
+
+FileWatcher::~FileWatcher()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_quit = true;
+  }
+  m_cond.notify_all();
+  m_thread.join();
+
+#ifdef __linux__
+  if (m_fd >= 0)
+  {
+    close(m_fd);
+  }
+#endif
+}
+
+void
+FileWatcher::watch(std::string const& filename)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if (m_fd < 0)
+  {
+    if (m_polled.find(filename) == m_polled.end())
+    {
+      m_polled[filename] = get_state(filename);
+    }
+    return;
+  }
+
+#ifdef __linux__
+  std::filesystem::path const path(filename);
+  std::string const dirname = path.has_parent_path() ? path.parent_path().string() : ".";
+
+  auto it = m_directories.find(dirname);
+  if (it == m_directories.end())
+  {
+    int const wd = inotify_add_watch(m_fd, dirname.c_str(),
+                                     IN_CLOSE_WRITE | IN_MODIFY | IN_MOVED_TO | IN_MOVED_FROM |
+                                     IN_CREATE | IN_DELETE | IN_DELETE_SELF | IN_MOVE_SELF);
+    if (wd < 0)
+    {
+      log_warn("FileWatcher: couldn't watch '{}'", dirname);
+      return;
+    }
+
+    // adding the same directory under a different name returns the
+    // existing descriptor
+    for (auto& dir : m_directories)
+    {
+      if (dir.second.wd == wd)
+      {
+        dir.second.files[path.filename().string()] = filename;
+        return;
+      }
+    }
+
+    it = m_directories.emplace(dirname, Directory{wd, {}}).first;
+  }
+
+  it->second.files[path.filename().string()] = filename;
+#endif
+}
+
+void
+FileWatcher::unwatch(std::string const& filename)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if (m_fd < 0)
+  {
+    m_polled.erase(filename);
+    return;
+  }
+
+#ifdef __linux__
+  for (auto it = m_directories.begin(); it != m_directories.end(); ++it)
+  {
+    auto file = it->second.files.find(std::filesystem::path(filename).filename().string());
+    if (file != it->second.files.end() && file->second == filename)
+    {
+      it->second.files.erase(file);
+      if (it->second.files.empty())
+      {
+        inotify_rm_watch(m_fd, it->second.wd);
+        m_directories.erase(it);
+      }
+      return;
+    }
+  }
+#endif
+}
+
+void
+FileWatcher::run_inotify()
+{
+#ifdef __linux__
+  int const timeout = static_cast<int>(m_interval.count());
+
+  while (!m_quit)
+  {
+    pollfd pfd = { m_fd, POLLIN, 0 };
+    if (poll(&pfd, 1, timeout) <= 0)
+      continue;
+
+    alignas(inotify_event) char buffer[4096];
+    ssize_t const len = read(m_fd, buffer, sizeof(buffer));
+    if (len <= 0)
+      continue;
+
+    std::vector<std::string> changed;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+
+      for (ssize_t pos = 0; pos < len;)
+      {
+        inotify_event const* event = reinterpret_cast<inotify_event const*>(buffer + pos);
+        pos += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+        if (event->mask & IN_Q_OVERFLOW)
+        {
+          changed.emplace_back();
+          continue;
+        }
+
+        for (auto const& dir : m_directories)
+        {
+          if (dir.second.wd != event->wd)
+            continue;
+
+          if (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF))
+          {
+            for (auto const& file : dir.second.files)
+              changed.push_back(file.second);
+          }
+          else if (event->len > 0)
+          {
+            auto file = dir.second.files.find(event->name);
+            if (file != dir.second.files.end())
+              changed.push_back(file->second);
+          }
+        }
+      }
+    }
+
+    // the callback is free to call watch() and unwatch()
+    for (std::string const& filename : changed)
+    {
+      m_callback(filename);
+    }
+  }
+#endif
+}
+
+void
+FileWatcher::run_polling()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (!m_quit)
+  {
+    m_cond.wait_for(lock, m_interval);
+    if (m_quit)
+      break;
+
+    std::vector<std::string> changed;
+    for (auto& it : m_polled)
+    {
+      FileState const state = get_state(it.first);
+      if (state.exists != it.second.exists ||
+          state.mtime != it.second.mtime ||
+          state.size != it.second.size)
+      {
+        it.second = state;
+        changed.push_back(it.first);
+      }
+    }
+
+    lock.unlock();
+    for (std::string const& filename : changed)
+    {
+      m_callback(filename);
+    }
+    lock.lock();
+  }
+}
+
+FileWatcher::FileState
+FileWatcher::get_state(std::string const& filename)
+{
+  std::error_code ec;
+  FileState state{ false, {}, 0 };
+  state.mtime = std::filesystem::last_write_time(filename, ec);
+  if (!ec)
+  {
+    state.size = std::filesystem::file_size(filename, ec);
+    state.exists = !ec;
+  }
+  return state;
+}
+
+} // namespace pingus
+
+/* EOF */
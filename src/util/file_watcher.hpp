@@ -0,0 +1,111 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_PINGUS_UTIL_FILE_WATCHER_HPP
+#define HEADER_PINGUS_UTIL_FILE_WATCHER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace pingus {
+
+/** Reports changes to a set of files from a background thread, so
+    that users of the files don't have to stat them on every access.
+    inotify is used where available, watching the directories of the
+    files so that files replaced by a rename are noticed as well,
+    elsewhere the files are polled. */
+class FileWatcher
+{
+public:
+  /** Called from the watcher thread with the filename as it was
+      passed to watch(), an empty filename means that changes might
+      have been missed and all files have to be treated as changed */
+  using Callback = std::function<void (std::string const& filename)>;
+
+  enum Mode { AUTO, POLLING };
+
+private:
+  struct FileState
+  {
+    bool exists;
+    std::filesystem::file_time_type mtime;
+    uintmax_t size;
+  };
+
+  struct Directory
+  {
+    int wd;
+
+    /** Watched files in the directory, by their name within it */
+    std::map<std::string, std::string> files;
+  };
+
+  Callback m_callback;
+  std::chrono::milliseconds m_interval;
+
+  std::mutex m_mutex;
+  std::condition_variable m_cond;
+  std::atomic<bool> m_quit;
+
+  /** The inotify descriptor, -1 when polling */
+  int m_fd;
+
+  /** Watched directories with inotify, by path */
+  std::map<std::string, Directory> m_directories;
+
+  /** Watched files with their last seen state when polling */
+  std::map<std::string, FileState> m_polled;
+
+  std::thread m_thread;
+
+public:
+  /** @param interval  how often files are polled, with inotify how
+                       long shutting down can take */
+  FileWatcher(Callback callback, Mode mode = AUTO,
+              std::chrono::milliseconds interval = std::chrono::milliseconds(1000));
+  ~FileWatcher();
+
+  /** Start watching filename, watching it twice has no effect */
+  void watch(std::string const& filename);
+
+  /** Stop watching filename */
+  void unwatch(std::string const& filename);
+
+  /** @return true if the files get polled instead of using inotify */
+  bool is_polling() const { return m_fd < 0; }
+
+private:
+  void run_inotify();
+  void run_polling();
+
+  static FileState get_state(std::string const& filename);
+
+private:
+  FileWatcher(FileWatcher const&);
+  FileWatcher& operator=(FileWatcher const&);
+};
+
+} // namespace pingus
+
+#endif
+
+/* EOF */
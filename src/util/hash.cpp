@@ -0,0 +1,146 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "util/hash.hpp"
+
+#include <string.h>
+
+namespace pingus {
+
+namespace {
+
+uint64_t const prime1 = 0x9E3779B185EBCA87ull;
+uint64_t const prime2 = 0xC2B2AE3D27D4EB4Full;
+uint64_t const prime3 = 0x165667B19E3779F9ull;
+uint64_t const prime4 = 0x85EBCA77C2B2AE63ull;
+uint64_t const prime5 = 0x27D4EB2F165667C5ull;
+
+uint64_t rotl(uint64_t x, int r)
+{
+  return (x << r) | (x >> (64 - r));
+}
+
+// the format is defined as little endian
+uint64_t read64(uint8_t const* p)
+{
+  uint64_t v = 0;
+  for (int i = 7; i >= 0; --i)
+    v = (v << 8) | p[i];
+  return v;
+}
+
+uint32_t read32(uint8_t const* p)
+{
+  return static_cast<uint32_t>(p[0]) |
+    static_cast<uint32_t>(p[1]) << 8 |
+    static_cast<uint32_t>(p[2]) << 16 |
+    static_cast<uint32_t>(p[3]) << 24;
+}
+
+uint64_t round(uint64_t acc, uint64_t input)
+{
+  acc += input * prime2;
+  acc = rotl(acc, 31);
+  return acc * prime1;
+}
+
+uint64_t merge_round(uint64_t acc, uint64_t val)
+{
+  acc ^= round(0, val);
+  return acc * prime1 + prime4;
+}
+
+} // namespace
+
+uint64_t hash64(void const* data, size_t size, uint64_t seed)
+{
+  uint8_t const* p = static_cast<uint8_t const*>(data);
+  uint8_t const* const end = p + size;
+  uint64_t h;
+
+  if (size >= 32)
+  {
+    uint64_t v1 = seed + prime1 + prime2;
+    uint64_t v2 = seed + prime2;
+    uint64_t v3 = seed;
+    uint64_t v4 = seed - prime1;
+
+    uint8_t const* const limit = end - 32;
+    do
+    {
+      v1 = round(v1, read64(p));
+      v2 = round(v2, read64(p + 8));
+      v3 = round(v3, read64(p + 16));
+      v4 = round(v4, read64(p + 24));
+      p += 32;
+    }
+    while (p <= limit);
+
+    h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+    h = merge_round(h, v1);
+    h = merge_round(h, v2);
+    h = merge_round(h, v3);
+    h = merge_round(h, v4);
+  }
+  else
+  {
+    h = seed + prime5;
+  }
+
+  h += static_cast<uint64_t>(size);
+
+  for (; p + 8 <= end; p += 8)
+  {
+    h ^= round(0, read64(p));
+    h = rotl(h, 27) * prime1 + prime4;
+  }
+
+  if (p + 4 <= end)
+  {
+    h ^= static_cast<uint64_t>(read32(p)) * prime1;
+    h = rotl(h, 23) * prime2 + prime3;
+    p += 4;
+  }
+
+  for (; p < end; ++p)
+  {
+    h ^= (*p) * prime5;
+    h = rotl(h, 11) * prime1;
+  }
+
+  h ^= h >> 33;
+  h *= prime2;
+  h ^= h >> 29;
+  h *= prime3;
+  h ^= h >> 32;
+
+  return h;
+}
+
+std::string hash_to_string(uint64_t hash)
+{
+  char const digits[] = "0123456789abcdef";
+  std::string str(16, '0');
+  for (int i = 15; i >= 0; --i, hash >>= 4)
+  {
+    str[static_cast<size_t>(i)] = digits[hash & 0xf];
+  }
+  return str;
+}
+
+} // namespace pingus
+
+/* EOF */
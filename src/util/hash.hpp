@@ -0,0 +1,37 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_PINGUS_UTIL_HASH_HPP
+#define HEADER_PINGUS_UTIL_HASH_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+namespace pingus {
+
+/** Fast non-cryptographic 64-bit hash of the given bytes, produces
+    the same values as XXH64 from the xxHash library */
+uint64_t hash64(void const* data, size_t size, uint64_t seed = 0);
+
+/** @return hash as 16 lowercase hex digits */
+std::string hash_to_string(uint64_t hash);
+
+} // namespace pingus
+
+#endif
+
+/* EOF */
@@ -0,0 +1,130 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "util/mapped_file.hpp"
+
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#ifndef _WIN32
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+#include "util/raise_exception.hpp"
+
+namespace pingus {
+
+MappedFile::MappedFile() :
+  m_data(nullptr),
+  m_size(0),
+  m_buffer(),
+  m_mapped(false)
+{
+}
+
+MappedFile::MappedFile(std::string const& filename) :
+  m_data(nullptr),
+  m_size(0),
+  m_buffer(),
+  m_mapped(false)
+{
+#ifndef _WIN32
+  int const fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    raise_exception(std::runtime_error, "couldn't open " << filename);
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) == 0 && st.st_size > 0)
+  {
+    void* const addr = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr != MAP_FAILED)
+    {
+      m_data = static_cast<uint8_t const*>(addr);
+      m_size = static_cast<size_t>(st.st_size);
+      m_mapped = true;
+    }
+  }
+  ::close(fd);
+
+  if (m_mapped)
+    return;
+#endif
+
+  // empty files can't be mapped, and some platforms can't map at all
+  std::ifstream in(filename, std::ios::binary);
+  if (!in)
+  {
+    raise_exception(std::runtime_error, "couldn't open " << filename);
+  }
+
+  m_buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  m_data = m_buffer.data();
+  m_size = m_buffer.size();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept :
+  m_data(std::exchange(other.m_data, nullptr)),
+  m_size(std::exchange(other.m_size, 0)),
+  m_buffer(std::move(other.m_buffer)),
+  m_mapped(std::exchange(other.m_mapped, false))
+{
+}
+
+MappedFile&
+MappedFile::operator=(MappedFile&& other) noexcept
+{
+  if (this != &other)
+  {
+    close();
+    m_data = std::exchange(other.m_data, nullptr);
+    m_size = std::exchange(other.m_size, 0);
+    m_buffer = std::move(other.m_buffer);
+    m_mapped = std::exchange(other.m_mapped, false);
+  }
+  return *this;
+}
+
+MappedFile::~MappedFile()
+{
+  close();
+}
+
+void
+MappedFile::close()
+{
+#ifndef _WIN32
+  if (m_mapped)
+  {
+    munmap(const_cast<uint8_t*>(m_data), m_size);
+  }
+#endif
+
+  m_data = nullptr;
+  m_size = 0;
+  m_buffer.clear();
+  m_mapped = false;
+}
+
+} // namespace pingus
+
+/* EOF */
@@ -0,0 +1,65 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_PINGUS_UTIL_MAPPED_FILE_HPP
+#define HEADER_PINGUS_UTIL_MAPPED_FILE_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace pingus {
+
+/** Read-only view of a whole file. The file is memory mapped where
+    the platform allows it, so only the parts that get accessed are
+    read from disk, elsewhere it is read into memory in one go. */
+class MappedFile
+{
+private:
+  uint8_t const* m_data;
+  size_t m_size;
+
+  /** Holds the content when the file couldn't be mapped */
+  std::vector<uint8_t> m_buffer;
+
+  bool m_mapped;
+
+public:
+  MappedFile();
+
+  /** Throws std::runtime_error if the file can't be opened */
+  explicit MappedFile(std::string const& filename);
+
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile& operator=(MappedFile&& other) noexcept;
+  ~MappedFile();
+
+  uint8_t const* data() const { return m_data; }
+  size_t size() const { return m_size; }
+
+private:
+  void close();
+
+  MappedFile(MappedFile const&);
+  MappedFile& operator=(MappedFile const&);
+};
+
+} // namespace pingus
+
+#endif
+
+/* EOF */
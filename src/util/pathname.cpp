@@ -19,7 +19,6 @@
 #include <assert.h>
 #include <algorithm>
 #include <ostream>
-#include <set>
 
 #include <logmich/log.hpp>
 
@@ -106,7 +105,14 @@ Pathname::empty() const
 bool
 Pathname::exist() const
 {
-  return System::exist(get_sys_path());
+  if (type == DATA_PATH)
+  {
+    return g_path_manager.exist(pathname);
+  }
+  else
+  {
+    return System::exist(get_sys_path());
+  }
 }
 
 uint64_t
@@ -115,6 +121,12 @@ Pathname::mtime() const
   return System::get_mtime(get_sys_path());
 }
 
+bool
+Pathname::find_in_archive(std::string_view& data_out) const
+{
+  return type == DATA_PATH && g_path_manager.find_in_archive(pathname, data_out);
+}
+
 std::string
 Pathname::str() const
 {
@@ -150,32 +162,12 @@ Pathname::opendir(std::string const& pattern) const
       return std::vector<Pathname>();
 
     case Pathname::DATA_PATH: {
-      // collect all paths
-      std::vector<std::string> paths;
-      {
-        paths.push_back(g_path_manager.get_path());
-        auto lst = g_path_manager.get_paths();
-        paths.insert(paths.end(), lst.begin(), lst.end());
-      }
-
-      std::set<Pathname> result;
-      for(auto p = paths.begin(); p != paths.end(); ++p)
+      std::vector<Pathname> result;
+      for (std::string const& name : g_path_manager.opendir(pathname))
       {
-        std::string path = Pathname::join(*p, pathname);
-        try
-        {
-          System::Directory lst = System::opendir(path);
-          for(auto it = lst.begin(); it != lst.end(); ++it)
-          {
-            result.insert(Pathname(Pathname::join(pathname, it->name), Pathname::DATA_PATH));
-          }
-        }
-        catch(std::exception const& err)
-        {
-          log_info("{}", err.what());
-        }
+        result.push_back(Pathname(Pathname::join(pathname, name), Pathname::DATA_PATH));
       }
-      return std::vector<Pathname>(result.begin(), result.end());
+      return result;
     }
 
     case Pathname::SYSTEM_PATH: {
@@ -208,28 +200,9 @@ Pathname::opendir_recursive(std::vector<Pathname>& result) const
       break;
 
     case Pathname::DATA_PATH: {
-      // collect all paths
-      std::vector<std::string> paths;
+      for (std::string const& path : g_path_manager.opendir_recursive(pathname))
       {
-        paths.push_back(g_path_manager.get_path());
-        auto lst = g_path_manager.get_paths();
-        paths.insert(paths.end(), lst.begin(), lst.end());
-
-        // normalize all paths
-        std::transform(paths.begin(), paths.end(),
-                       paths.begin(), System::normalize_path);
-      }
-
-      for(auto p = paths.begin(); p != paths.end(); ++p)
-      {
-        std::string path = Pathname::join(*p, pathname);
-
-        auto lst = System::opendir_recursive(path);
-        for(auto it = lst.begin(); it != lst.end(); ++it)
-        {
-          Pathname sub_path(it->substr(p->size()+1), Pathname::DATA_PATH);
-          result.push_back(sub_path);
-        }
+        result.push_back(Pathname(path, Pathname::DATA_PATH));
       }
       break;
     }
@@ -19,6 +19,7 @@
 
 #include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <sstream>
 
@@ -82,6 +83,11 @@ public:
 
   uint64_t mtime() const;
 
+  /** Return true if the file is served from the resource archive of
+      the datadir instead of a loose file, data_out then views its
+      content */
+  bool find_in_archive(std::string_view& data_out) const;
+
   bool operator<(Pathname const& rhs) const;
   bool operator==(Pathname const& rhs) const;
 };
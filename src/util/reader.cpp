@@ -16,11 +16,31 @@
 
 #include "reader.hpp"
 
+#include <sstream>
+
 #include "math/color.hpp"
 #include "math/vector2f.hpp"
 #include "pingus/res_descriptor.hpp"
 #include "util/pathname.hpp"
 
+namespace pingus {
+
+ReaderDocument read_document(Pathname const& pathname)
+{
+  std::string_view data;
+  if (pathname.find_in_archive(data))
+  {
+    std::istringstream in{std::string(data)};
+    return ReaderDocument::from_stream(in, pathname.get_raw_path());
+  }
+  else
+  {
+    return ReaderDocument::from_file(pathname.get_sys_path());
+  }
+}
+
+} // namespace pingus
+
 using namespace pingus;
 
 namespace prio {
@@ -35,6 +35,10 @@ class InVector2fZ;
 class Pathname;
 class ResDescriptor;
 
+/** Read the document at pathname, from the resource archive when the
+    file is in there */
+ReaderDocument read_document(Pathname const& pathname);
+
 } // namespace pingus
 
 namespace prio {
@@ -17,11 +17,14 @@
 #include "util/system.hpp"
 
 #include <algorithm>
+#include <chrono>
 #include <filesystem>
 #include <fstream>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
+#include <unordered_map>
 #include <stdlib.h>
 #include <string.h>
 
@@ -53,11 +56,152 @@
 #include <logmich/log.hpp>
 
 #include "pingus/globals.hpp"
+#include "util/hash.hpp"
+#include "util/mapped_file.hpp"
 #include "util/pathname.hpp"
 #include "util/raise_exception.hpp"
 
 namespace pingus {
 
+namespace {
+
+/** A checksum is valid as long as the stamp of the file didn't change */
+struct ChecksumEntry
+{
+  System::FileStamp stamp;
+  std::string checksum;
+};
+
+/** Checksums by filename, stored in the cachedir across runs. The
+    file starts with a version line, followed by one "size mtime ctime
+    inode checksum filename" line per file, later lines replace earlier
+    ones. New entries are appended, the file gets rewritten without
+    the replaced lines when they make up most of it. */
+class ChecksumCache
+{
+private:
+  static char const* const header;
+
+  std::mutex m_mutex;
+  std::unordered_map<std::string, ChecksumEntry> m_entries;
+
+  /** The file the entries were loaded from, empty if none */
+  std::string m_filename;
+
+  /** Number of entry lines in m_filename */
+  size_t m_lines;
+
+public:
+  ChecksumCache() : m_mutex(), m_entries(), m_filename(), m_lines(0) {}
+
+  bool lookup(std::string const& filename, System::FileStamp const& stamp, std::string& checksum)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    load();
+
+    auto it = m_entries.find(filename);
+    if (it != m_entries.end() && it->second.stamp == stamp)
+    {
+      checksum = it->second.checksum;
+      return true;
+    }
+    else
+    {
+      return false;
+    }
+  }
+
+  void store(std::string const& filename, ChecksumEntry const& entry)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    load();
+
+    m_entries[filename] = entry;
+
+    if (!m_filename.empty())
+    {
+      if (m_lines >= 2 * m_entries.size() + 64)
+      {
+        compact();
+      }
+      else
+      {
+        std::ofstream out(m_filename, std::ios::app);
+        write_entry(out, filename, entry);
+        m_lines += 1;
+      }
+    }
+  }
+
+private:
+  static void write_entry(std::ostream& out, std::string const& filename, ChecksumEntry const& entry)
+  {
+    out << entry.stamp.size << ' ' << entry.stamp.mtime << ' ' << entry.stamp.ctime << ' '
+        << entry.stamp.inode << ' ' << entry.checksum << ' ' << filename << '\n';
+  }
+
+  /** Load the entries once the userdir is known */
+  void load()
+  {
+    if (System::get_userdir().empty())
+      return;
+
+    std::string const filename = System::get_cachedir() + "checksums";
+    if (filename == m_filename)
+      return;
+
+    m_filename = filename;
+    m_lines = 0;
+
+    std::ifstream in(m_filename);
+    std::string line;
+    if (std::getline(in, line) && line == header)
+    {
+      ChecksumEntry entry;
+      std::string path;
+      while (in >> entry.stamp.size >> entry.stamp.mtime >> entry.stamp.ctime >> entry.stamp.inode >>
+             entry.checksum && in.get() == ' ' && std::getline(in, path))
+      {
+        m_entries[path] = entry;
+        m_lines += 1;
+      }
+    }
+    else
+    {
+      // missing or from an older version
+      compact();
+    }
+  }
+
+  /** Replace the file with the current entries */
+  void compact()
+  {
+    std::ostringstream out;
+    out << header << '\n';
+    for (auto const& it : m_entries)
+    {
+      write_entry(out, it.first, it.second);
+    }
+
+    try
+    {
+      System::create_dir(System::get_cachedir());
+      System::write_file(m_filename, out.str());
+      m_lines = m_entries.size();
+    }
+    catch(std::exception const& err)
+    {
+      log_warn("couldn't write checksum cache: {}", err.what());
+    }
+  }
+};
+
+char const* const ChecksumCache::header = "pingus-checksums 2";
+
+ChecksumCache g_checksum_cache;
+
+} // namespace
+
 std::string System::userdir;
 std::string System::default_email;
 std::string System::default_username;
@@ -382,7 +526,10 @@ System::init_directories()
 void
 System::set_userdir(std::string const& u)
 {
-  userdir = u + "/";
+  if (u.empty() || u.back() == '/')
+    userdir = u;
+  else
+    userdir = u + "/";
 }
 
 std::string
@@ -496,39 +643,65 @@ System::checksum(Pathname const& pathname)
 /** Read file and create a checksum and return it */
 std::string
 System::checksum(std::string const& filename)
-{ // FIXME: Replace sys with SHA1 or MD5 or so
-  FILE* in;
-  size_t bytes_read;
-  char buffer[4096];
-  long int checksum = 0;
-
-  in = fopen(filename.c_str(), "r");
-
-  if (!in)
+{
+  FileStamp stamp;
+  if (!get_stamp(filename, stamp))
   {
     log_error("System::checksum: Couldn't open file: {}", filename);
     return "";
   }
 
-  do
+  std::string checksum;
+  if (g_checksum_cache.lookup(filename, stamp, checksum))
+    return checksum;
+
+  try
+  {
+    MappedFile file(filename);
+    checksum = hash_to_string(hash64(file.data(), file.size()));
+  }
+  catch(std::exception const& err)
   {
-    bytes_read = fread(buffer, sizeof (char), 4096, in);
+    log_error("System::checksum: {}", err.what());
+    return "";
+  }
 
-    if (bytes_read != 4096 && !feof(in))
-    {
-      raise_exception(std::runtime_error, "System:checksum: file read error");
-    }
+  g_checksum_cache.store(filename, ChecksumEntry{stamp, checksum});
+  return checksum;
+}
 
-    for (size_t i=0; i < bytes_read; ++i)
-      checksum = checksum * 17 + buffer[i];
-  }
-  while (bytes_read != 0);
+bool
+System::get_stamp(std::string const& filename, FileStamp& stamp)
+{
+  std::error_code ec;
+  uint64_t const size = std::filesystem::file_size(filename, ec);
+  if (ec)
+    return false;
+
+  auto const mtime = std::filesystem::last_write_time(filename, ec);
+  if (ec)
+    return false;
 
-  fclose (in);
+  stamp = FileStamp();
+  stamp.size = size;
+  stamp.mtime = std::chrono::duration_cast<std::chrono::nanoseconds>(mtime.time_since_epoch()).count();
+
+#ifndef WIN32
+  // replacing a file with an older copy of the same size keeps mtime
+  // and size, but not the inode or ctime
+  struct stat stat_buf;
+  if (stat(filename.c_str(), &stat_buf) == 0)
+  {
+    stamp.inode = static_cast<uint64_t>(stat_buf.st_ino);
+#  ifdef __APPLE__
+    stamp.ctime = static_cast<int64_t>(stat_buf.st_ctimespec.tv_sec) * 1000000000 + stat_buf.st_ctimespec.tv_nsec;
+#  else
+    stamp.ctime = static_cast<int64_t>(stat_buf.st_ctim.tv_sec) * 1000000000 + stat_buf.st_ctim.tv_nsec;
+#  endif
+  }
+#endif
 
-  std::ostringstream str;
-  str << checksum;
-  return str.str();
+  return true;
 }
 
 uint64_t
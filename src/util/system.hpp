@@ -81,7 +81,10 @@ public:
 
   static std::string find_userdir();
 
-  /** Sets the directory to save users data to */
+  /** Sets the directory to save users data to, a missing trailing
+      slash gets added, so the result of get_userdir() can be passed
+      back in, an empty string makes init_directories() pick the
+      default again */
   static void set_userdir(std::string const&);
 
   /** Returns the directory where Pingus can store its user specific
@@ -104,6 +107,22 @@ public:
   /** Return the modification time of a file */
   static uint64_t get_mtime(std::string const& filename);
 
+  /** Identifies one version of a file, any write to the file or
+      replacing it changes the stamp. The times have nanosecond
+      resolution, so two writes within one second are told apart. */
+  struct FileStamp
+  {
+    uint64_t size = 0;
+    int64_t mtime = 0;
+    int64_t ctime = 0;
+    uint64_t inode = 0;
+
+    bool operator==(FileStamp const& other) const = default;
+  };
+
+  /** @return false if the file doesn't exist */
+  static bool get_stamp(std::string const& filename, FileStamp& stamp);
+
   /** Removes all '..', double slashes and such from a pathname and
       makes it absolute */
   static std::string realpath(std::string const& pathname);
@@ -111,9 +130,9 @@ public:
   /** Removes all '..', double slashes and such from a pathname */
   static std::string normalize_path(std::string const& pathname);
 
-  /** Read a file and generate a checksum and return it. The checksum
-      generation is very primitiv and should probably be replaced by CRC
-      or md5. */
+  /** Read a file and generate a checksum and return it, a 64-bit
+      hash in hex. The checksums are cached in the cachedir by
+      filename and FileStamp, so unchanged files aren't read again. */
   static std::string checksum (std::string const& filename);
   static std::string checksum (Pathname const& pathname);
 
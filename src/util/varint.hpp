@@ -0,0 +1,62 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_PINGUS_UTIL_VARINT_HPP
+#define HEADER_PINGUS_UTIL_VARINT_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+namespace pingus {
+
+/** Append value as LEB128 varint, seven bits per byte starting with
+    the lowest, the high bit of a byte tells that more follow */
+inline void put_varint(std::string& out, uint64_t value)
+{
+  while (value >= 0x80)
+  {
+    out += static_cast<char>((value & 0x7f) | 0x80);
+    value >>= 7;
+  }
+  out += static_cast<char>(value);
+}
+
+/** Read a varint from data at pos and advance pos past it
+
+    @return false if data ends within the varint or it is longer than
+    64 bits, pos is size in the first case */
+inline bool get_varint(uint8_t const* data, size_t size, size_t& pos, uint64_t& value)
+{
+  value = 0;
+  for (int shift = 0; shift < 64; shift += 7)
+  {
+    if (pos >= size)
+      return false;
+
+    uint8_t const byte = data[pos++];
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if (!(byte & 0x80))
+      return true;
+  }
+  return false;
+}
+
+} // namespace pingus
+
+#endif
+
+/* EOF */
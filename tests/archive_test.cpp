@@ -0,0 +1,71 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+#include "util/archive.hpp"
+
+using namespace pingus;
+
+TEST(ArchiveTest, round_trip)
+{
+  std::filesystem::path const dir = std::filesystem::temp_directory_path() / "archive_test";
+  std::filesystem::create_directories(dir);
+
+  std::string const big(100000, 'x');
+  std::ofstream((dir / "a").string(), std::ios::binary) << "first";
+  std::ofstream((dir / "b").string(), std::ios::binary) << big;
+  std::ofstream((dir / "c").string(), std::ios::binary);
+
+  std::string const filename = (dir / "test.pack").string();
+  Archive::write(filename, {
+      { "images/a.png", (dir / "a").string() },
+      { "images/sub/b.sprite", (dir / "b").string() },
+      { "empty", (dir / "c").string() }
+    });
+
+  Archive archive(filename);
+  EXPECT_EQ(3u, archive.get_paths().size());
+
+  std::string_view data;
+  ASSERT_TRUE(archive.find("images/a.png", data));
+  EXPECT_EQ("first", data);
+  ASSERT_TRUE(archive.find("images/sub/b.sprite", data));
+  EXPECT_EQ(big, data);
+  ASSERT_TRUE(archive.find("empty", data));
+  EXPECT_TRUE(data.empty());
+  EXPECT_FALSE(archive.find("images/missing.png", data));
+}
+
+TEST(ArchiveTest, invalid)
+{
+  std::filesystem::path const dir = std::filesystem::temp_directory_path() / "archive_test";
+  std::filesystem::create_directories(dir);
+  std::string const filename = (dir / "invalid.pack").string();
+
+  std::ofstream(filename, std::ios::binary) << "not an archive";
+  EXPECT_THROW(Archive archive(filename), std::runtime_error);
+
+  // index pointing past the end of the file
+  std::ofstream(filename, std::ios::binary) << "PINGPACK" << '\x01' << '\x01'
+                                            << '\x01' << 'a' << '\x00' << '\x10';
+  EXPECT_THROW(Archive archive(filename), std::runtime_error);
+}
+
+/* EOF */
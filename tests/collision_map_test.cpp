@@ -0,0 +1,392 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "headless.hpp"
+#include "math/random.hpp"
+#include "pingus/collision_map.hpp"
+#include "pingus/collision_mask.hpp"
+
+using namespace pingus;
+
+namespace {
+
+Groundtype::GPType const types[] = {
+  Groundtype::GP_NOTHING,
+  Groundtype::GP_SOLID,
+  Groundtype::GP_GROUND,
+  Groundtype::GP_BRIDGE,
+  Groundtype::GP_WATER
+};
+
+/** Compare the column index against plain getpixel() calls */
+void check_columns(CollisionMap const& colmap)
+{
+  for (int x = -1; x <= colmap.get_width(); ++x)
+  {
+    if (x >= 0 && x < colmap.get_width())
+    {
+      int y = 0;
+      for (CollisionMap::ColumnSpan const& span : colmap.get_column_spans(x))
+      {
+        ASSERT_LE(y, span.y);
+        for (; y < span.y; ++y)
+        {
+          ASSERT_EQ(Groundtype::GP_NOTHING, colmap.getpixel(x, y));
+        }
+        for (; y < span.y + span.len; ++y)
+        {
+          ASSERT_EQ(span.type, colmap.getpixel(x, y));
+        }
+      }
+      for (; y < colmap.get_height(); ++y)
+      {
+        ASSERT_EQ(Groundtype::GP_NOTHING, colmap.getpixel(x, y));
+      }
+    }
+
+    int const y1 = -2;
+    int const y2 = colmap.get_height() + 2;
+    std::vector<uint8_t> column(static_cast<size_t>(y2 - y1));
+    colmap.get_column(x, y1, y2, column.data());
+    for (int y = y1; y < y2; ++y)
+    {
+      ASSERT_EQ(colmap.getpixel(x, y), column[static_cast<size_t>(y - y1)]);
+    }
+
+    for (int start = y1; start < y2; start += 3)
+    {
+      for (int end = start; end < y2; end += 5)
+      {
+        int expected = end;
+        bool clear = true;
+        bool clear_bridge = true;
+        for (int y = end - 1; y >= start; --y)
+        {
+          int const pixel = colmap.getpixel(x, y);
+          if (pixel != Groundtype::GP_NOTHING)
+          {
+            expected = y;
+            clear = false;
+            if (pixel != Groundtype::GP_BRIDGE)
+              clear_bridge = false;
+          }
+        }
+
+        ASSERT_EQ(expected, colmap.find_nonempty(x, start, end));
+        ASSERT_EQ(clear, colmap.is_clear(x, start, end));
+        ASSERT_EQ(clear_bridge, colmap.is_clear(x, start, end, Groundtype::GP_BRIDGE));
+      }
+    }
+  }
+}
+
+/** Per pixel version of CollisionMap::put() with a mask, to check the
+    span based one against */
+void reference_put(std::vector<uint8_t>& pixels, int width, int height,
+                   CollisionMask const& mask, int x_pos, int y_pos, Groundtype::GPType type)
+{
+  if (type == Groundtype::GP_TRANSPARENT)
+    return;
+
+  for (int y = 0; y < mask.get_height(); ++y)
+  {
+    for (int x = 0; x < mask.get_width(); ++x)
+    {
+      int const tx = x_pos + x;
+      int const ty = y_pos + y;
+      if (mask.get_data()[y * mask.get_width() + x] &&
+          tx >= 0 && tx < width && ty >= 0 && ty < height)
+      {
+        uint8_t& pixel = pixels[static_cast<size_t>(ty * width + tx)];
+        if (type != Groundtype::GP_BRIDGE || pixel == Groundtype::GP_NOTHING)
+          pixel = static_cast<uint8_t>(type);
+      }
+    }
+  }
+}
+
+/** Per pixel version of CollisionMap::remove() with a mask */
+void reference_remove(std::vector<uint8_t>& pixels, int width, int height,
+                      CollisionMask const& mask, int x_pos, int y_pos)
+{
+  for (int y = 0; y < mask.get_height(); ++y)
+  {
+    for (int x = 0; x < mask.get_width(); ++x)
+    {
+      int const tx = x_pos + x;
+      int const ty = y_pos + y;
+      if (mask.get_data()[y * mask.get_width() + x] &&
+          tx >= 0 && tx < width && ty >= 0 && ty < height)
+      {
+        uint8_t& pixel = pixels[static_cast<size_t>(ty * width + tx)];
+        if (pixel != Groundtype::GP_SOLID)
+          pixel = Groundtype::GP_NOTHING;
+      }
+    }
+  }
+}
+
+std::vector<uint8_t> get_pixels(CollisionMap& colmap)
+{
+  return std::vector<uint8_t>(colmap.get_data(),
+                              colmap.get_data() + colmap.get_width() * colmap.get_height());
+}
+
+} // namespace
+
+TEST(CollisionMapTest, column_index_follows_edits)
+{
+  CollisionMap colmap(37, 53);
+  check_columns(colmap);
+
+  Random random(42);
+  for (int i = 0; i < 200; ++i)
+  {
+    Groundtype::GPType const type = types[random.rand(static_cast<int>(std::size(types)))];
+    if (random.rand(4) == 0)
+    {
+      colmap.put(random.rand(41) - 2, random.rand(57) - 2, type);
+    }
+    else
+    {
+      int const x = random.rand(45) - 4;
+      int const y = random.rand(61) - 4;
+      colmap.fill_rect(Rect(x, y, x + random.rand(12), y + random.rand(20)), type);
+    }
+    check_columns(colmap);
+  }
+}
+
+TEST(CollisionMapTest, journal_undo)
+{
+  CollisionMap colmap(29, 41);
+  colmap.fill_rect(Rect(0, 30, 29, 41), Groundtype::GP_GROUND);
+  colmap.start_journal();
+
+  Random random(7);
+  std::vector<std::vector<CollisionMap::ColumnDelta> > deltas;
+  std::vector<std::vector<uint8_t> > states;
+  for (int step = 0; step < 10; ++step)
+  {
+    states.emplace_back(colmap.get_data(), colmap.get_data() + 29 * 41);
+    for (int i = 0; i < 5; ++i)
+    {
+      Groundtype::GPType const type = types[random.rand(static_cast<int>(std::size(types)))];
+      int const x = random.rand(33) - 2;
+      int const y = random.rand(45) - 2;
+      colmap.fill_rect(Rect(x, y, x + random.rand(8), y + random.rand(8)), type);
+    }
+    deltas.push_back(colmap.take_journal());
+  }
+
+  for (size_t i = deltas.size(); i-- > 0;)
+  {
+    colmap.undo(deltas[i]);
+    ASSERT_EQ(states[i], std::vector<uint8_t>(colmap.get_data(), colmap.get_data() + 29 * 41));
+    check_columns(colmap);
+  }
+}
+
+TEST(CollisionMapTest, hash_follows_content)
+{
+  CollisionMap a(31, 17);
+  CollisionMap b(31, 17);
+  EXPECT_EQ(a.get_hash(), b.get_hash());
+
+  a.fill_rect(Rect(2, 3, 20, 10), Groundtype::GP_GROUND);
+  EXPECT_NE(a.get_hash(), b.get_hash());
+
+  // same content through different edits
+  b.fill_rect(Rect(2, 3, 20, 6), Groundtype::GP_GROUND);
+  b.fill_rect(Rect(0, 6, 25, 10), Groundtype::GP_SOLID);
+  b.fill_rect(Rect(0, 6, 2, 10), Groundtype::GP_NOTHING);
+  b.fill_rect(Rect(20, 6, 25, 10), Groundtype::GP_NOTHING);
+  b.fill_rect(Rect(2, 6, 20, 10), Groundtype::GP_GROUND);
+  EXPECT_EQ(a.get_hash(), b.get_hash());
+
+  uint64_t const hash = a.get_hash();
+  a.start_journal();
+  a.put(5, 15, Groundtype::GP_BRIDGE);
+  EXPECT_NE(hash, a.get_hash());
+  a.undo(a.take_journal());
+  EXPECT_EQ(hash, a.get_hash());
+}
+
+TEST(CollisionMapTest, batch_changes)
+{
+  CollisionMap colmap(40, 30);
+  colmap.take_changes();
+  unsigned const serial = colmap.get_serial();
+
+  colmap.begin_batch();
+  colmap.fill_rect(Rect(2, 2, 6, 6), Groundtype::GP_GROUND);
+  colmap.fill_rect(Rect(5, 5, 9, 9), Groundtype::GP_SOLID);
+  colmap.put(30, 20, Groundtype::GP_BRIDGE);
+  EXPECT_EQ(serial, colmap.get_serial());
+  colmap.end_batch();
+  EXPECT_EQ(serial + 1, colmap.get_serial());
+
+  // an empty batch doesn't change anything
+  colmap.begin_batch();
+  colmap.end_batch();
+  EXPECT_EQ(serial + 1, colmap.get_serial());
+
+  std::vector<Rect> changes = colmap.take_changes();
+  ASSERT_EQ(2u, changes.size());
+  EXPECT_EQ(2, changes[0].left());
+  EXPECT_EQ(2, changes[0].top());
+  EXPECT_EQ(9, changes[0].right());
+  EXPECT_EQ(9, changes[0].bottom());
+  EXPECT_EQ(30, changes[1].left());
+  EXPECT_EQ(20, changes[1].top());
+  EXPECT_EQ(31, changes[1].right());
+  EXPECT_EQ(21, changes[1].bottom());
+  EXPECT_TRUE(colmap.take_changes().empty());
+
+  // outside of a batch every edit counts
+  colmap.fill_rect(Rect(0, 0, 1, 1), Groundtype::GP_GROUND);
+  colmap.fill_rect(Rect(0, 0, 1, 1), Groundtype::GP_NOTHING);
+  EXPECT_EQ(serial + 3, colmap.get_serial());
+}
+
+TEST(CollisionMapTest, mask_edits_match_reference)
+{
+  init_headless();
+
+  // 34 pixels wide rows end in a tail shorter than the 16 bytes the
+  // SSE2 kernels handle at once, the bomber is a multiple of 16
+  CollisionMask const masks[] = {
+    CollisionMask("pingus/common/bash_radius_gfx", "pingus/common/bash_radius"),
+    CollisionMask("pingus/common/digger_radius_gfx", "pingus/common/digger_radius"),
+    CollisionMask("other/bomber_radius_gfx", "other/bomber_radius")
+  };
+
+  int const width  = 150;
+  int const height = 110;
+  CollisionMap colmap(width, height);
+
+  Random random(11);
+  for (int i = 0; i < 60; ++i)
+  {
+    int const x = random.rand(width);
+    int const y = random.rand(height);
+    colmap.fill_rect(Rect(x, y, x + random.rand(40), y + random.rand(30)),
+                     types[random.rand(static_cast<int>(std::size(types)))]);
+  }
+  std::vector<uint8_t> expected = get_pixels(colmap);
+
+  // across all four edges, from fully outside to fully inside
+  int const xs[] = { -70, -40, -33, -17, -1, 0, 1, 45, width - 64, width - 34, width - 20, width - 1, width };
+  int const ys[] = { -70, -40, -21, -9, -1, 0, 1, 38, height - 64, height - 22, height - 13, height - 1, height };
+
+  Groundtype::GPType const put_types[] = {
+    Groundtype::GP_GROUND,
+    Groundtype::GP_SOLID,
+    Groundtype::GP_BRIDGE,
+    Groundtype::GP_TRANSPARENT
+  };
+
+  for (CollisionMask const& mask : masks)
+  {
+    for (int x : xs)
+    {
+      for (int y : ys)
+      {
+        if (random.rand(3) == 0)
+        {
+          colmap.remove(mask, x, y);
+          reference_remove(expected, width, height, mask, x, y);
+        }
+        else
+        {
+          Groundtype::GPType const type = put_types[random.rand(static_cast<int>(std::size(put_types)))];
+          colmap.put(mask, x, y, type);
+          reference_put(expected, width, height, mask, x, y, type);
+        }
+        ASSERT_EQ(expected, get_pixels(colmap)) << "at " << x << ", " << y;
+      }
+    }
+  }
+  check_columns(colmap);
+}
+
+TEST(CollisionMapTest, bridge_fills_and_remove_keeps_solid)
+{
+  init_headless();
+
+  CollisionMask const mask("pingus/common/bash_radius_gfx", "pingus/common/bash_radius");
+  int const w = mask.get_width();
+  int const h = mask.get_height();
+
+  // the mask over three stripes of solid, ground and nothing
+  CollisionMap colmap(w, h);
+  colmap.fill_rect(Rect(0, 0, w / 3, h), Groundtype::GP_SOLID);
+  colmap.fill_rect(Rect(w / 3, 0, 2 * w / 3, h), Groundtype::GP_GROUND);
+  std::vector<uint8_t> const before = get_pixels(colmap);
+
+  colmap.put(mask, 0, 0, Groundtype::GP_BRIDGE);
+  for (int y = 0; y < h; ++y)
+  {
+    for (int x = 0; x < w; ++x)
+    {
+      int const was = before[static_cast<size_t>(y * w + x)];
+      if (mask.get_data()[y * w + x] && was == Groundtype::GP_NOTHING)
+        ASSERT_EQ(Groundtype::GP_BRIDGE, colmap.getpixel(x, y));
+      else
+        ASSERT_EQ(was, colmap.getpixel(x, y));
+    }
+  }
+
+  colmap.remove(mask, 0, 0);
+  for (int y = 0; y < h; ++y)
+  {
+    for (int x = 0; x < w; ++x)
+    {
+      int const was = before[static_cast<size_t>(y * w + x)];
+      if (!mask.get_data()[y * w + x] || was == Groundtype::GP_SOLID)
+        ASSERT_EQ(was, colmap.getpixel(x, y));
+      else
+        ASSERT_EQ(Groundtype::GP_NOTHING, colmap.getpixel(x, y));
+    }
+  }
+  check_columns(colmap);
+}
+
+TEST(CollisionMapTest, raycast)
+{
+  CollisionMap colmap(20, 20);
+  colmap.fill_rect(Rect(5, 10, 15, 12), Groundtype::GP_GROUND);
+
+  CollisionMap::RayHit hit = colmap.raycast(glm::vec2(7.5f, 2.5f), glm::vec2(0.0f, 1.0f), 20);
+  EXPECT_EQ(8, hit.steps);
+  EXPECT_EQ(Groundtype::GP_GROUND, hit.type);
+  EXPECT_EQ(10.5f, hit.pos.y);
+
+  hit = colmap.raycast(glm::vec2(7.5f, 2.5f), glm::vec2(0.0f, 1.0f), 5);
+  EXPECT_EQ(5, hit.steps);
+  EXPECT_EQ(Groundtype::GP_NOTHING, hit.type);
+  EXPECT_EQ(7.5f, hit.pos.y);
+
+  hit = colmap.raycast(glm::vec2(2.0f, 5.0f), glm::vec2(-1.0f, 0.0f), 10);
+  EXPECT_EQ(3, hit.steps);
+  EXPECT_EQ(Groundtype::GP_OUTOFSCREEN, hit.type);
+}
+
+/* EOF */
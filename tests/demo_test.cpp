@@ -0,0 +1,164 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <stdio.h>
+
+#include "pingus/demo_writer.hpp"
+#include "pingus/pingus_demo.hpp"
+#include "util/pathname.hpp"
+
+using namespace pingus;
+
+namespace {
+
+std::vector<ServerEvent> make_events()
+{
+  return {
+    ServerEvent::make_pingu_action_event(12, 0, Vector2f(100.5f, 200.25f), ActionName::BASHER),
+    ServerEvent::make_pingu_action_event(12, 3, Vector2f(-1.0f, 0.1f), ActionName::WALKER),
+    ServerEvent::make_pingu_action_event(5000, 70000, Vector2f(3.0f, 4.0f), ActionName::ANGEL),
+    ServerEvent::make_checkpoint_event(5100, 0x0123456789abcdefull),
+    ServerEvent::make_armageddon_event(6000),
+    ServerEvent::make_finish_event(6100),
+    ServerEvent::make_end_event(6100)
+  };
+}
+
+void check_round_trip(DemoWriter::Format format)
+{
+  std::string const filename = (std::filesystem::temp_directory_path() /
+                                (format == DemoWriter::BINARY ? "demo_test.bin" : "demo_test.txt")).string();
+  std::vector<ServerEvent> const events = make_events();
+
+  {
+    DemoWriter writer(filename, format, "test/level", "abc123", 0xdeadbeef);
+    ASSERT_TRUE(writer.is_open());
+    for (ServerEvent const& event : events)
+      writer.write(event);
+  }
+
+  PingusDemo demo(Pathname(filename, Pathname::SYSTEM_PATH));
+  EXPECT_EQ(format == DemoWriter::BINARY, demo.is_binary());
+  EXPECT_EQ("test/level", demo.get_levelname());
+  EXPECT_EQ("abc123", demo.get_checksum());
+  EXPECT_EQ(0xdeadbeefu, demo.get_seed());
+
+  for (int pass = 0; pass < 2; ++pass)
+  {
+    ServerEvent event;
+    for (ServerEvent const& expected : events)
+    {
+      ASSERT_TRUE(demo.read_event(event));
+      EXPECT_EQ(expected.type, event.type);
+      EXPECT_EQ(expected.time_stamp, event.time_stamp);
+      if (expected.type == ServerEvent::PINGU_ACTION_EVENT)
+      {
+        EXPECT_EQ(expected.pingu_id, event.pingu_id);
+        EXPECT_EQ(expected.pingu_action, event.pingu_action);
+        EXPECT_EQ(expected.pos.x(), event.pos.x());
+        EXPECT_EQ(expected.pos.y(), event.pos.y());
+      }
+      EXPECT_EQ(expected.state_hash, event.state_hash);
+    }
+    EXPECT_FALSE(demo.read_event(event));
+    demo.reset();
+  }
+
+  remove(filename.c_str());
+}
+
+} // namespace
+
+TEST(DemoTest, binary_round_trip)
+{
+  check_round_trip(DemoWriter::BINARY);
+}
+
+TEST(DemoTest, text_round_trip)
+{
+  check_round_trip(DemoWriter::TEXT);
+}
+
+TEST(DemoTest, truncate_drops_later_events)
+{
+  std::string const filename = (std::filesystem::temp_directory_path() / "demo_test_rewound.bin").string();
+  std::vector<ServerEvent> const events = make_events();
+
+  {
+    DemoWriter writer(filename, DemoWriter::BINARY, "test/level", "abc123", 0);
+    ASSERT_TRUE(writer.is_open());
+    for (ServerEvent const& event : events)
+    {
+      writer.write(event);
+      // have some of the events on disk and some in the buffer
+      if (event.time_stamp == 5000)
+        writer.flush();
+    }
+
+    // one cut inside the buffer, one inside the file
+    writer.truncate(6000);
+    writer.write(ServerEvent::make_armageddon_event(6050));
+    writer.truncate(20);
+    writer.write(ServerEvent::make_armageddon_event(30));
+    writer.write(ServerEvent::make_finish_event(40));
+  }
+
+  PingusDemo demo(Pathname(filename, Pathname::SYSTEM_PATH));
+  std::vector<ServerEvent> const result = demo.get_events();
+  ASSERT_EQ(4u, result.size());
+  EXPECT_EQ(12, result[0].time_stamp);
+  EXPECT_EQ(12, result[1].time_stamp);
+  EXPECT_EQ(ServerEvent::ARMAGEDDON_EVENT, result[2].type);
+  EXPECT_EQ(30, result[2].time_stamp);
+  EXPECT_EQ(ServerEvent::FINISH_EVENT, result[3].type);
+  EXPECT_EQ(40, result[3].time_stamp);
+
+  remove(filename.c_str());
+}
+
+TEST(DemoTest, truncated_binary_demo_ends_early)
+{
+  std::string const filename = (std::filesystem::temp_directory_path() / "demo_test_truncated.bin").string();
+  std::vector<ServerEvent> const events = make_events();
+
+  {
+    DemoWriter writer(filename, DemoWriter::BINARY, "test/level", "abc123", 0);
+    ASSERT_TRUE(writer.is_open());
+    for (ServerEvent const& event : events)
+      writer.write(event);
+  }
+
+  // cut into the hash of the checkpoint, it is followed by three
+  // events of five bytes in total
+  std::filesystem::resize_file(filename, std::filesystem::file_size(filename) - 8);
+
+  PingusDemo demo(Pathname(filename, Pathname::SYSTEM_PATH));
+  ServerEvent event;
+  for (int i = 0; i < 3; ++i)
+  {
+    ASSERT_TRUE(demo.read_event(event));
+    EXPECT_EQ(events[static_cast<size_t>(i)].time_stamp, event.time_stamp);
+  }
+  EXPECT_FALSE(demo.read_event(event));
+  EXPECT_FALSE(demo.read_event(event));
+
+  remove(filename.c_str());
+}
+
+/* EOF */
@@ -0,0 +1,103 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <set>
+
+#include "util/file_watcher.hpp"
+
+using namespace pingus;
+
+namespace {
+
+class ChangeLog
+{
+private:
+  std::mutex m_mutex;
+  std::condition_variable m_cond;
+  std::set<std::string> m_changed;
+
+public:
+  ChangeLog() : m_mutex(), m_cond(), m_changed() {}
+
+  void add(std::string const& filename)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_changed.insert(filename);
+    m_cond.notify_all();
+  }
+
+  bool wait_for(std::string const& filename)
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_cond.wait_for(lock, std::chrono::seconds(5),
+                           [&]{ return m_changed.count(filename) != 0; });
+  }
+
+  bool contains(std::string const& filename)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_changed.count(filename) != 0;
+  }
+};
+
+void check_watcher(FileWatcher::Mode mode)
+{
+  std::filesystem::path const dir = std::filesystem::temp_directory_path() / "file_watcher_test";
+  std::filesystem::create_directories(dir);
+  std::string const watched = (dir / "watched.txt").string();
+  std::string const unwatched = (dir / "unwatched.txt").string();
+  std::ofstream(watched) << "a";
+  std::ofstream(unwatched) << "a";
+
+  ChangeLog log;
+  FileWatcher watcher([&log](std::string const& filename) { log.add(filename); },
+                      mode, std::chrono::milliseconds(20));
+  EXPECT_EQ(mode == FileWatcher::POLLING, watcher.is_polling());
+
+  watcher.watch(watched);
+  watcher.watch(unwatched);
+  watcher.unwatch(unwatched);
+
+  std::ofstream(unwatched) << "changed";
+  std::ofstream(watched) << "changed";
+  EXPECT_TRUE(log.wait_for(watched));
+  EXPECT_FALSE(log.contains(unwatched));
+
+  // replaced by a rename, as editors do
+  std::string const tmp = (dir / "tmp.txt").string();
+  std::ofstream(tmp) << "replaced";
+  watcher.watch(unwatched);
+  std::filesystem::rename(tmp, unwatched);
+  EXPECT_TRUE(log.wait_for(unwatched));
+}
+
+} // namespace
+
+TEST(FileWatcherTest, automatic)
+{
+  check_watcher(FileWatcher::AUTO);
+}
+
+TEST(FileWatcherTest, polling)
+{
+  check_watcher(FileWatcher::POLLING);
+}
+
+/* EOF */
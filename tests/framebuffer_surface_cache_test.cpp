@@ -0,0 +1,115 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include "engine/display/framebuffer_surface_cache.hpp"
+#include "headless.hpp"
+#include "util/pathname.hpp"
+
+using namespace pingus;
+
+namespace {
+
+Pathname image(std::string const& name)
+{
+  return Pathname("images/pingus/common/" + name + ".png", Pathname::DATA_PATH);
+}
+
+} // namespace
+
+TEST(FramebufferSurfaceCacheTest, hit_returns_the_same_surface)
+{
+  init_headless();
+  FramebufferSurfaceCache cache;
+
+  FramebufferSurface const first  = cache.get(image("bash_radius"), ResourceModifier::ROT0);
+  FramebufferSurface const second = cache.get(image("bash_radius"), ResourceModifier::ROT0);
+  EXPECT_TRUE(first == second);
+
+  FramebufferSurfaceCache::Stats const stats = cache.get_stats();
+  EXPECT_EQ(1, stats.hits);
+  EXPECT_EQ(1, stats.misses);
+  EXPECT_EQ(0, stats.evictions);
+  EXPECT_EQ(1u, stats.size);
+}
+
+TEST(FramebufferSurfaceCacheTest, modifiers_are_separate_entries)
+{
+  init_headless();
+  FramebufferSurfaceCache cache;
+
+  // 34x22, so the rotation shows in the size
+  FramebufferSurface const plain   = cache.get(image("digger_radius"), ResourceModifier::ROT0);
+  FramebufferSurface const rotated = cache.get(image("digger_radius"), ResourceModifier::ROT90);
+  EXPECT_FALSE(plain == rotated);
+  EXPECT_EQ(34, plain.get_width());
+  EXPECT_EQ(22, rotated.get_width());
+  EXPECT_EQ(34, rotated.get_height());
+
+  EXPECT_TRUE(rotated == cache.get(image("digger_radius"), ResourceModifier::ROT90));
+
+  FramebufferSurfaceCache::Stats const stats = cache.get_stats();
+  EXPECT_EQ(1, stats.hits);
+  EXPECT_EQ(2, stats.misses);
+  EXPECT_EQ(2u, stats.size);
+}
+
+TEST(FramebufferSurfaceCacheTest, unused_are_evicted_least_recently_used_first)
+{
+  init_headless();
+  FramebufferSurfaceCache cache(1);
+
+  // stays in use for the whole test, so it is never evicted
+  FramebufferSurface const held = cache.get(image("bash_radius"), ResourceModifier::ROT0);
+
+  cache.get(image("bomber_radius"), ResourceModifier::ROT0);
+  cache.get(image("digger_radius"), ResourceModifier::ROT0);
+  EXPECT_EQ(0, cache.get_stats().evictions);
+
+  // bomber is used more recently than digger now
+  cache.get(image("bomber_radius"), ResourceModifier::ROT0);
+  cache.get(image("miner_radius"), ResourceModifier::ROT0);
+  EXPECT_EQ(1, cache.get_stats().evictions);
+  EXPECT_EQ(3u, cache.get_stats().size);
+
+  // digger is gone, bomber goes next
+  FramebufferSurfaceCache::Stats before = cache.get_stats();
+  cache.get(image("digger_radius"), ResourceModifier::ROT0);
+  FramebufferSurfaceCache::Stats after = cache.get_stats();
+  EXPECT_EQ(1, after.misses - before.misses);
+  EXPECT_EQ(2, after.evictions);
+
+  before = after;
+  cache.get(image("miner_radius"), ResourceModifier::ROT0);
+  EXPECT_TRUE(held == cache.get(image("bash_radius"), ResourceModifier::ROT0));
+  after = cache.get_stats();
+  EXPECT_EQ(2, after.hits - before.hits);
+  EXPECT_EQ(0, after.misses - before.misses);
+
+  EXPECT_EQ(3, after.hits);
+  EXPECT_EQ(5, after.misses);
+  EXPECT_EQ(2, after.evictions);
+  EXPECT_EQ(3u, after.size);
+
+  // only the held surface survives a cleanup
+  cache.cleanup();
+  after = cache.get_stats();
+  EXPECT_EQ(4, after.evictions);
+  EXPECT_EQ(1u, after.size);
+}
+
+/* EOF */
@@ -0,0 +1,54 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "util/hash.hpp"
+
+using namespace pingus;
+
+TEST(HashTest, xxh64_reference_values)
+{
+  EXPECT_EQ(0xef46db3751d8e999ull, hash64("", 0));
+  EXPECT_EQ(0xd24ec4f1a98c6e5bull, hash64("a", 1));
+  EXPECT_EQ(0x44bc2cf5ad770999ull, hash64("abc", 3));
+}
+
+TEST(HashTest, every_byte_counts)
+{
+  std::string data(1000, 'x');
+  uint64_t const hash = hash64(data.data(), data.size());
+
+  for (size_t i : { size_t(0), size_t(31), size_t(32), size_t(500), size_t(999) })
+  {
+    std::string changed = data;
+    changed[i] = 'y';
+    EXPECT_NE(hash, hash64(changed.data(), changed.size())) << i;
+  }
+
+  EXPECT_NE(hash, hash64(data.data(), data.size() - 1));
+  EXPECT_NE(hash, hash64(data.data(), data.size(), 1));
+}
+
+TEST(HashTest, hash_to_string)
+{
+  EXPECT_EQ("0000000000000000", hash_to_string(0));
+  EXPECT_EQ("ef46db3751d8e999", hash_to_string(0xef46db3751d8e999ull));
+}
+
+/* EOF */
@@ -0,0 +1,58 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_PINGUS_TESTS_HEADLESS_HPP
+#define HEADER_PINGUS_TESTS_HEADLESS_HPP
+
+#include <memory>
+#include <mutex>
+
+#include "engine/display/display.hpp"
+#include "engine/display/framebuffer_type.hpp"
+#include "engine/sound/sound.hpp"
+#include "engine/sound/sound_dummy.hpp"
+#include "pingus/globals.hpp"
+#include "pingus/path_manager.hpp"
+#include "pingus/resource.hpp"
+#include "pingus/worldobj_factory.hpp"
+
+namespace pingus {
+
+/** Point the datadir to data/, open a NullFramebuffer and mute the
+    sound, once per process, for tests that need sprites or run levels
+    but no window, the same setup as pingus-sim */
+inline void init_headless()
+{
+  static std::once_flag s_once;
+  std::call_once(s_once, [] {
+    globals::sound_enabled = false;
+    globals::music_enabled = false;
+
+    g_path_manager.set_path("data");
+    Resource::init();
+
+    Display::create_window(FramebufferType::NULL_FRAMEBUFFER, geom::isize(640, 480), false, false);
+    pingus::sound::PingusSound::init(std::make_unique<pingus::sound::PingusSoundDummy>());
+
+    WorldObjFactory::instance();
+  });
+}
+
+} // namespace pingus
+
+#endif
+
+/* EOF */
@@ -0,0 +1,143 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+
+#include "pingus/level_index.hpp"
+#include "temp_dir.hpp"
+#include "util/pathname.hpp"
+#include "util/system.hpp"
+
+using namespace pingus;
+
+namespace {
+
+class LevelIndexTest : public TempDirTest
+{
+protected:
+  Pathname m_level;
+
+  LevelIndexTest() :
+    TempDirTest("level_index_test"),
+    m_level()
+  {}
+
+  void SetUp() override
+  {
+    TempDirTest::SetUp();
+    use_as_userdir();
+    LevelIndex::clear();
+
+    write_level("First");
+  }
+
+  void TearDown() override
+  {
+    LevelIndex::clear();
+    TempDirTest::TearDown();
+  }
+
+  void write_level(std::string const& levelname)
+  {
+    m_level = TempDirTest::write_level("level.pingus", level_text(levelname));
+  }
+};
+
+} // namespace
+
+TEST_F(LevelIndexTest, reads_the_head)
+{
+  LevelInfo info = LevelIndex::get("test/level", m_level);
+
+  EXPECT_EQ("test/level", info.resname);
+  EXPECT_EQ("First", info.levelname);
+  EXPECT_EQ("Save them", info.description);
+  EXPECT_EQ("Someone", info.author);
+  EXPECT_EQ(800, info.size.width());
+  EXPECT_EQ(600, info.size.height());
+  EXPECT_EQ(1000, info.time);
+  EXPECT_EQ(20, info.number_of_pingus);
+  EXPECT_EQ(10, info.number_to_save);
+  EXPECT_EQ(5, info.actions["basher"]);
+  EXPECT_EQ(3, info.actions["digger"]);
+  EXPECT_EQ(16u, info.checksum.size());
+  EXPECT_EQ(std::filesystem::file_size(m_level.get_sys_path()), info.file_size);
+  EXPECT_EQ(System::get_cachedir() + "thumbnails/" + info.checksum + ".png", info.thumbnail);
+}
+
+TEST_F(LevelIndexTest, survives_restart)
+{
+  LevelIndex::Stats const before = LevelIndex::get_stats();
+  LevelInfo const parsed = LevelIndex::get("test/level", m_level);
+  LevelIndex::flush();
+  EXPECT_TRUE(System::exist(LevelIndex::get_filename()));
+
+  // as if the game got started again
+  LevelIndex::clear();
+  LevelInfo const indexed = LevelIndex::get("test/level", m_level);
+
+  LevelIndex::Stats const after = LevelIndex::get_stats();
+  EXPECT_EQ(1, after.misses - before.misses);
+  EXPECT_EQ(1, after.hits - before.hits);
+
+  EXPECT_EQ(parsed.levelname, indexed.levelname);
+  EXPECT_EQ(parsed.size, indexed.size);
+  EXPECT_EQ(parsed.actions, indexed.actions);
+  EXPECT_EQ(parsed.checksum, indexed.checksum);
+  EXPECT_EQ(parsed.thumbnail, indexed.thumbnail);
+}
+
+TEST_F(LevelIndexTest, changed_level_gets_parsed_again)
+{
+  LevelIndex::get("test/level", m_level);
+  LevelIndex::flush();
+  LevelIndex::clear();
+
+  write_level("Second");
+
+  LevelIndex::Stats const before = LevelIndex::get_stats();
+  EXPECT_EQ("Second", LevelIndex::get("test/level", m_level).levelname);
+  EXPECT_EQ(1, LevelIndex::get_stats().misses - before.misses);
+}
+
+TEST_F(LevelIndexTest, broken_index_is_rebuilt)
+{
+  LevelIndex::get("test/level", m_level);
+  LevelIndex::flush();
+  LevelIndex::clear();
+
+  std::string const filename = LevelIndex::get_filename();
+  std::filesystem::resize_file(filename, std::filesystem::file_size(filename) - 3);
+
+  EXPECT_EQ("First", LevelIndex::get("test/level", m_level).levelname);
+  LevelIndex::flush();
+  LevelIndex::clear();
+
+  LevelIndex::Stats const before = LevelIndex::get_stats();
+  EXPECT_EQ("First", LevelIndex::get("test/level", m_level).levelname);
+  EXPECT_EQ(1, LevelIndex::get_stats().hits - before.hits);
+}
+
+TEST_F(LevelIndexTest, missing_level_throws)
+{
+  EXPECT_THROW(LevelIndex::get("test/missing",
+                               Pathname((m_dir / "missing.pingus").string(), Pathname::SYSTEM_PATH)),
+               std::runtime_error);
+}
+
+/* EOF */
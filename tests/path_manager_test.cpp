@@ -0,0 +1,143 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+#include "pingus/path_manager.hpp"
+#include "util/archive.hpp"
+
+using namespace pingus;
+
+namespace {
+
+void create_file(std::filesystem::path const& path)
+{
+  std::filesystem::create_directories(path.parent_path());
+  std::ofstream(path) << path.string();
+}
+
+} // namespace
+
+TEST(PathManagerTest, overlays)
+{
+  std::filesystem::path const root = std::filesystem::temp_directory_path() / "path_manager_test";
+  std::filesystem::remove_all(root);
+  std::string const data = (root / "data").string();
+  std::string const addon = (root / "addon").string();
+
+  create_file(root / "data/images/a.png");
+  create_file(root / "data/images/b.png");
+  create_file(root / "data/images/sub/c.png");
+  create_file(root / "addon/images/b.png");
+  create_file(root / "addon/images/d.png");
+
+  PathManager path_manager;
+  path_manager.set_path(data);
+  path_manager.add_overlay_path(addon);
+
+  EXPECT_EQ(data + "/images/a.png", path_manager.complete("images/a.png"));
+  EXPECT_EQ(addon + "/images/b.png", path_manager.complete("images/b.png"));
+  EXPECT_EQ(addon + "/images/d.png", path_manager.complete("images/./sub/../d.png"));
+  EXPECT_EQ(data + "/images/missing.png", path_manager.complete("images/missing.png"));
+
+  EXPECT_TRUE(path_manager.exist("images/sub/c.png"));
+  EXPECT_TRUE(path_manager.exist("images/sub/"));
+  EXPECT_FALSE(path_manager.exist("images/missing.png"));
+
+  std::vector<std::string> const expected_dir = { "a.png", "b.png", "d.png", "sub" };
+  EXPECT_EQ(expected_dir, path_manager.opendir("images"));
+
+  std::vector<std::string> lst = path_manager.opendir_recursive("images/");
+  std::sort(lst.begin(), lst.end());
+  std::vector<std::string> const expected_files = { "images/a.png", "images/b.png", "images/d.png", "images/sub/c.png" };
+  EXPECT_EQ(expected_files, lst);
+
+  // new files are only seen after a refresh
+  create_file(root / "addon/images/a.png");
+  EXPECT_EQ(data + "/images/a.png", path_manager.complete("images/a.png"));
+  path_manager.refresh();
+  EXPECT_EQ(addon + "/images/a.png", path_manager.complete("images/a.png"));
+}
+
+TEST(PathManagerTest, archive)
+{
+  std::filesystem::path const root = std::filesystem::temp_directory_path() / "path_manager_archive_test";
+  std::filesystem::remove_all(root);
+  std::string const data = (root / "data").string();
+  std::string const addon = (root / "addon").string();
+
+  create_file(root / "data/images/loose.png");
+  create_file(root / "data/images/packed.png");
+  create_file(root / "addon/images/overlay.png");
+  create_file(root / "src/packed.png");
+  create_file(root / "src/overlay.png");
+  create_file(root / "src/only.png");
+
+  Archive::write((root / "data" / PathManager::archive_name).string(), {
+      { "images/packed.png", (root / "src/packed.png").string() },
+      { "images/overlay.png", (root / "src/overlay.png").string() },
+      { "images/sub/only.png", (root / "src/only.png").string() }
+    });
+
+  PathManager path_manager;
+  path_manager.set_path(data);
+  path_manager.add_overlay_path(addon);
+
+  std::string_view content;
+  EXPECT_FALSE(path_manager.find_in_archive("images/loose.png", content));
+  EXPECT_FALSE(path_manager.find_in_archive("images/overlay.png", content));
+  ASSERT_TRUE(path_manager.find_in_archive("images/packed.png", content));
+  EXPECT_EQ((root / "src/packed.png").string(), content);
+  EXPECT_TRUE(path_manager.find_in_archive("images/sub/only.png", content));
+
+  EXPECT_TRUE(path_manager.exist("images/sub"));
+  std::vector<std::string> const expected = { "loose.png", "overlay.png", "packed.png", "sub" };
+  EXPECT_EQ(expected, path_manager.opendir("images"));
+}
+
+TEST(PathManagerTest, archive_is_shadowed_by_newer_files)
+{
+  std::filesystem::path const root = std::filesystem::temp_directory_path() / "path_manager_stale_archive_test";
+  std::filesystem::remove_all(root);
+
+  create_file(root / "data/images/edited.png");
+  create_file(root / "data/images/unchanged.png");
+  create_file(root / "src/edited.png");
+  create_file(root / "src/unchanged.png");
+
+  std::filesystem::path const archive = root / "data" / PathManager::archive_name;
+  Archive::write(archive.string(), {
+      { "images/edited.png", (root / "src/edited.png").string() },
+      { "images/unchanged.png", (root / "src/unchanged.png").string() }
+    });
+
+  auto const archive_mtime = std::filesystem::last_write_time(archive);
+  std::filesystem::last_write_time(root / "data/images/unchanged.png", archive_mtime - std::chrono::seconds(10));
+  std::filesystem::last_write_time(root / "data/images/edited.png", archive_mtime + std::chrono::seconds(10));
+
+  PathManager path_manager;
+  path_manager.set_path((root / "data").string());
+
+  std::string_view content;
+  EXPECT_FALSE(path_manager.find_in_archive("images/edited.png", content));
+  EXPECT_EQ((root / "data/images/edited.png").string(), path_manager.complete("images/edited.png"));
+  EXPECT_TRUE(path_manager.find_in_archive("images/unchanged.png", content));
+}
+
+/* EOF */
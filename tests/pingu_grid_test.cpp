@@ -0,0 +1,152 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "headless.hpp"
+#include "pingus/pingu.hpp"
+#include "pingus/pingu_holder.hpp"
+#include "pingus/pingus_level.hpp"
+#include "util/pathname.hpp"
+
+using namespace pingus;
+
+namespace {
+
+/** A 640x480 level, which is a grid of 10x8 cells */
+PingusLevel make_level()
+{
+  std::string const filename = (std::filesystem::temp_directory_path() / "pingu_grid_test.pingus").string();
+  {
+    std::ofstream out(filename, std::ios::binary);
+    out << "(pingus-level\n"
+        << "  (version 3)\n"
+        << "  (head\n"
+        << "    (levelname \"grid\")\n"
+        << "    (levelsize 640 480)\n"
+        << "    (number-of-pingus 20))\n"
+        << "  (objects))\n";
+  }
+  return PingusLevel(Pathname(filename, Pathname::SYSTEM_PATH));
+}
+
+bool contains(std::vector<Pingu*> const& pingus, Pingu const* pingu)
+{
+  return std::find(pingus.begin(), pingus.end(), pingu) != pingus.end();
+}
+
+} // namespace
+
+TEST(PinguGridTest, moves_across_cells)
+{
+  init_headless();
+  PinguHolder holder(make_level());
+  Pingu* pingu = holder.create_pingu(Vector2f(10, 10), 0);
+  ASSERT_TRUE(pingu);
+
+  EXPECT_TRUE(contains(holder.query_rect(0, 0, 63, 63), pingu));
+
+  pingu->set_x(100);
+  EXPECT_FALSE(contains(holder.query_rect(0, 0, 63, 63), pingu));
+  EXPECT_TRUE(contains(holder.query_rect(64, 0, 127, 63), pingu));
+
+  pingu->set_y(300);
+  EXPECT_FALSE(contains(holder.query_rect(64, 0, 127, 63), pingu));
+  EXPECT_TRUE(contains(holder.query_rect(64, 256, 127, 319), pingu));
+
+  pingu->set_pos(Vector2f(10, 10));
+  EXPECT_TRUE(contains(holder.query_rect(0, 0, 63, 63), pingu));
+  EXPECT_EQ(1u, holder.query_rect(0, 0, 640, 480).size());
+}
+
+TEST(PinguGridTest, inclusive_edges)
+{
+  init_headless();
+  PinguHolder holder(make_level());
+  Pingu* pingu = holder.create_pingu(Vector2f(64, 64), 0);
+  ASSERT_TRUE(pingu);
+
+  // the pingu sits on the corner of four cells
+  EXPECT_TRUE(contains(holder.query_rect(0, 0, 64, 64), pingu));
+  EXPECT_TRUE(contains(holder.query_rect(64, 64, 100, 100), pingu));
+  EXPECT_TRUE(contains(holder.query_rect(64, 0, 64, 64), pingu));
+  EXPECT_FALSE(contains(holder.query_rect(0, 0, 63.5f, 63.5f), pingu));
+  EXPECT_FALSE(contains(holder.query_rect(64.5f, 64.5f, 100, 100), pingu));
+
+  EXPECT_TRUE(contains(holder.query_radius(Vector2f(64, 74), 10), pingu));
+  EXPECT_TRUE(contains(holder.query_radius(Vector2f(54, 64), 10), pingu));
+  EXPECT_FALSE(contains(holder.query_radius(Vector2f(64, 74.5f), 10), pingu));
+}
+
+TEST(PinguGridTest, negative_coordinates)
+{
+  init_headless();
+  PinguHolder holder(make_level());
+  Pingu* left  = holder.create_pingu(Vector2f(-20, -5), 0);
+  Pingu* right = holder.create_pingu(Vector2f(700, 500), 0);
+  ASSERT_TRUE(left && right);
+
+  // both end up in the border cells, but are still filtered exactly
+  EXPECT_TRUE(contains(holder.query_rect(-30, -10, -10, 0), left));
+  EXPECT_FALSE(contains(holder.query_rect(0, 0, 10, 10), left));
+  EXPECT_FALSE(contains(holder.query_rect(-30, -10, -25, 0), left));
+
+  EXPECT_TRUE(contains(holder.query_rect(650, 490, 800, 600), right));
+  EXPECT_FALSE(contains(holder.query_rect(600, 400, 640, 480), right));
+
+  left->set_pos(Vector2f(-200, 10));
+  EXPECT_TRUE(contains(holder.query_rect(-1000, 0, 0, 20), left));
+  EXPECT_FALSE(contains(holder.query_rect(-30, -10, -10, 0), left));
+}
+
+TEST(PinguGridTest, order_matches_update_order)
+{
+  init_headless();
+  PinguHolder holder(make_level());
+
+  // later pingus are further to the left, so cell order and update
+  // order differ
+  for (int i = 0; i < 10; ++i)
+  {
+    ASSERT_TRUE(holder.create_pingu(Vector2f(static_cast<float>(600 - 60 * i),
+                                             static_cast<float>(40 * i)), 0));
+  }
+
+  std::vector<Pingu*> const active(holder.get_active().begin(), holder.get_active().end());
+  EXPECT_EQ(active, holder.query_rect(-100, -100, 1000, 1000));
+
+  // moving pingus shuffles the cells, but not the result
+  for (Pingu* pingu : active)
+  {
+    pingu->set_pos(Vector2f(640 - pingu->get_x(), 480 - pingu->get_y()));
+  }
+  EXPECT_EQ(active, holder.query_rect(-100, -100, 1000, 1000));
+
+  std::vector<Pingu*> expected;
+  for (Pingu* pingu : active)
+  {
+    if (pingu->get_x() >= 100 && pingu->get_x() <= 400)
+      expected.push_back(pingu);
+  }
+  EXPECT_EQ(expected, holder.query_rect(100, -100, 400, 1000));
+}
+
+/* EOF */
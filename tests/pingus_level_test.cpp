@@ -0,0 +1,87 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include "pingus/pingus_level.hpp"
+#include "temp_dir.hpp"
+#include "util/pathname.hpp"
+#include "util/system.hpp"
+
+using namespace pingus;
+
+namespace {
+
+char const* tricky_level =
+  "; (objects) in a comment\n"
+  "(pingus-level\n"
+  "  (version 3)\n"
+  "  (head\n"
+  "    (levelname \"Level (with parens\")\n"
+  "    (description \"\\\"quoted\\\")\")\n"
+  "    (levelsize 800 600)\n"
+  "    (time 1000)\n"
+  "    (number-of-pingus 20)\n"
+  "    (number-to-save 10)\n"
+  "    (actions (basher 5) (digger 3)))\n"
+  "  (objects\n"
+  "    (exit (pos 100 200 0) (owner-id 0)) ; a comment )\n"
+  "    (entrance (pos 300 100 0) (type \"generic\"))))\n";
+
+class PingusLevelTest : public TempDirTest
+{
+protected:
+  PingusLevelTest() :
+    TempDirTest("pingus_level_test")
+  {}
+};
+
+} // namespace
+
+TEST_F(PingusLevelTest, objects_are_loaded_on_demand)
+{
+  PingusLevel plf(write_level("level.pingus", tricky_level));
+
+  EXPECT_EQ("Level (with parens", plf.get_levelname());
+  EXPECT_EQ("\"quoted\")", plf.get_description());
+  EXPECT_EQ(1000, plf.get_time());
+  EXPECT_EQ(20, plf.get_number_of_pingus());
+  EXPECT_EQ(10, plf.get_number_to_save());
+  EXPECT_EQ(2u, plf.get_actions().size());
+  EXPECT_EQ(16u, plf.get_checksum().size());
+
+  auto const& objects = plf.get_objects().get_objects();
+  ASSERT_EQ(2u, objects.size());
+  EXPECT_EQ("exit", objects[0].get_name());
+  EXPECT_EQ("entrance", objects[1].get_name());
+}
+
+TEST_F(PingusLevelTest, objects_match_the_head)
+{
+  Pathname const filename = write_level("level.pingus", tricky_level);
+  PingusLevel plf(filename);
+  EXPECT_EQ(System::checksum(filename.get_sys_path()), plf.get_checksum());
+
+  // the copy outlives the file it was loaded from
+  write_level("level.pingus", "(pingus-level (head) (objects))\n");
+
+  auto const& objects = plf.get_objects().get_objects();
+  ASSERT_EQ(2u, objects.size());
+  EXPECT_EQ("exit", objects[0].get_name());
+  EXPECT_EQ("entrance", objects[1].get_name());
+}
+
+/* EOF */
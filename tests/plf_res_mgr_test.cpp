@@ -0,0 +1,149 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "pingus/plf_res_mgr.hpp"
+#include "temp_dir.hpp"
+#include "util/pathname.hpp"
+
+using namespace pingus;
+
+namespace {
+
+class PLFResMgrTest : public TempDirTest
+{
+protected:
+  PLFResMgrTest() :
+    TempDirTest("plf_res_mgr_test")
+  {}
+
+  void SetUp() override
+  {
+    TempDirTest::SetUp();
+    PLFResMgr::clear();
+    PLFResMgr::set_max_file_bytes(16 * 1024 * 1024);
+  }
+
+  void TearDown() override
+  {
+    PLFResMgr::clear();
+    PLFResMgr::set_max_file_bytes(16 * 1024 * 1024);
+    TempDirTest::TearDown();
+  }
+
+  /** Write a level of the same size for every name, so that the
+      budget can be given in levels */
+  Pathname write_level(std::string const& name, char levelname = 'A')
+  {
+    return TempDirTest::write_level(name + ".pingus", level_text(std::string(1, levelname)));
+  }
+
+  PingusLevel load(std::string const& name)
+  {
+    return PLFResMgr::load_plf_from_filename(Pathname((m_dir / (name + ".pingus")).string(),
+                                                      Pathname::SYSTEM_PATH));
+  }
+};
+
+} // namespace
+
+TEST_F(PLFResMgrTest, second_load_hits)
+{
+  write_level("a");
+
+  PLFResMgr::Stats const before = PLFResMgr::get_stats();
+  PingusLevel const first = load("a");
+  PingusLevel const second = load("a");
+  PLFResMgr::Stats const after = PLFResMgr::get_stats();
+
+  EXPECT_EQ(1, after.misses - before.misses);
+  EXPECT_EQ(1, after.hits - before.hits);
+  EXPECT_EQ(1u, after.size);
+  EXPECT_EQ(first.get_file_size(), after.file_bytes);
+  EXPECT_EQ("plf_res_mgr_test/a", second.get_resname());
+}
+
+TEST_F(PLFResMgrTest, least_recently_used_is_evicted)
+{
+  write_level("a");
+  write_level("b");
+  write_level("c");
+
+  size_t const level_size = load("a").get_file_size();
+  PLFResMgr::set_max_file_bytes(2 * level_size);
+
+  load("b");
+  load("a"); // b is the least recently used now
+  PLFResMgr::Stats const before = PLFResMgr::get_stats();
+  load("c");
+  PLFResMgr::Stats after = PLFResMgr::get_stats();
+
+  EXPECT_EQ(1, after.evictions - before.evictions);
+  EXPECT_EQ(2u, after.size);
+  EXPECT_EQ(2 * level_size, after.file_bytes);
+
+  load("a");
+  load("c");
+  EXPECT_EQ(2, PLFResMgr::get_stats().hits - after.hits);
+
+  after = PLFResMgr::get_stats();
+  load("b");
+  EXPECT_EQ(1, PLFResMgr::get_stats().misses - after.misses);
+}
+
+TEST_F(PLFResMgrTest, smaller_budget_evicts_right_away)
+{
+  write_level("a");
+  write_level("b");
+
+  size_t const level_size = load("a").get_file_size();
+  load("b");
+
+  PLFResMgr::set_max_file_bytes(level_size);
+  PLFResMgr::Stats const stats = PLFResMgr::get_stats();
+  EXPECT_EQ(1u, stats.size);
+  EXPECT_EQ(level_size, stats.file_bytes);
+
+  // the most recently used level stays even when it is over budget
+  PLFResMgr::set_max_file_bytes(0);
+  EXPECT_EQ(1u, PLFResMgr::get_stats().size);
+}
+
+TEST_F(PLFResMgrTest, changed_file_is_loaded_again)
+{
+  write_level("a", 'A');
+  EXPECT_EQ("A", load("a").get_levelname());
+
+  PLFResMgr::Stats const before = PLFResMgr::get_stats();
+  write_level("a", 'B');
+
+  auto const deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (PLFResMgr::get_stats().invalidations == before.invalidations &&
+         std::chrono::steady_clock::now() < deadline)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  EXPECT_LT(before.invalidations, PLFResMgr::get_stats().invalidations);
+  EXPECT_EQ("B", load("a").get_levelname());
+  EXPECT_EQ(1u, PLFResMgr::get_stats().size);
+}
+
+/* EOF */
@@ -0,0 +1,59 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include "math/random.hpp"
+
+using namespace pingus;
+
+TEST(RandomTest, same_seed_same_sequence)
+{
+  Random a(1234);
+  Random b(1234);
+  for (int i = 0; i < 1000; ++i)
+  {
+    EXPECT_EQ(a.next(), b.next());
+  }
+
+  b.set_seed(1234);
+  Random c(1234);
+  EXPECT_EQ(c.next(), b.next());
+}
+
+TEST(RandomTest, different_seed_different_sequence)
+{
+  Random a(1);
+  Random b(2);
+  EXPECT_NE(a.next(), b.next());
+}
+
+TEST(RandomTest, ranges)
+{
+  Random random(42);
+  for (int i = 0; i < 10000; ++i)
+  {
+    int const v = random.rand(7);
+    EXPECT_GE(v, 0);
+    EXPECT_LT(v, 7);
+
+    float const f = random.frand();
+    EXPECT_GE(f, 0.0f);
+    EXPECT_LT(f, 1.0f);
+  }
+}
+
+/* EOF */
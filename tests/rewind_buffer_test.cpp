@@ -0,0 +1,198 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <map>
+#include <vector>
+
+#include "headless.hpp"
+#include "pingus/pingu.hpp"
+#include "pingus/pingu_holder.hpp"
+#include "pingus/pingus_demo.hpp"
+#include "pingus/pingus_level.hpp"
+#include "pingus/rewind_buffer.hpp"
+#include "pingus/server.hpp"
+#include "pingus/world.hpp"
+#include "temp_dir.hpp"
+#include "util/pathname.hpp"
+
+using namespace pingus;
+
+namespace {
+
+PingusLevel load_level()
+{
+  init_headless();
+  return PingusLevel(Pathname("levels/tutorial/digger-tutorial2-grumbel.pingus", Pathname::DATA_PATH));
+}
+
+/** Run the server up to time and remember the state hash of each
+    tick, with dig set every pingu is told to dig now and then, to
+    change the terrain */
+void run(Server& server, RewindBuffer* buffer, int time, bool dig,
+         std::map<int, uint64_t>* hashes = nullptr)
+{
+  while (server.get_time() < time)
+  {
+    if (dig && server.get_time() % 50 == 0)
+    {
+      std::vector<Pingu*> const active(server.get_world()->get_pingus()->get_active().begin(),
+                                       server.get_world()->get_pingus()->get_active().end());
+      for (Pingu* pingu : active)
+      {
+        server.send_pingu_action_event(pingu, ActionName::DIGGER);
+      }
+    }
+
+    server.update();
+    if (buffer)
+      buffer->update();
+
+    if (hashes)
+      (*hashes)[server.get_time()] = server.get_world()->get_state_hash();
+  }
+}
+
+class RewindDemoTest : public TempDirTest
+{
+protected:
+  RewindDemoTest() :
+    TempDirTest("rewind_buffer_test")
+  {}
+
+  void SetUp() override
+  {
+    TempDirTest::SetUp();
+    use_as_userdir();
+    std::filesystem::create_directories(m_dir / "demos");
+  }
+};
+
+} // namespace
+
+TEST(RewindBufferTest, rewind_restores_state)
+{
+  PingusLevel const plf = load_level();
+  Server server(plf, false, 0);
+  RewindBuffer buffer(server, 64 * 1024 * 1024, 10);
+
+  std::map<int, uint64_t> hashes;
+  run(server, &buffer, 800, true, &hashes);
+  EXPECT_EQ(0, buffer.get_oldest_time());
+
+  // goes back to the snapshot at or before the target
+  ASSERT_TRUE(buffer.rewind(195));
+  EXPECT_EQ(600, server.get_time());
+  EXPECT_EQ(hashes[600], server.get_world()->get_state_hash());
+
+  ASSERT_TRUE(buffer.rewind(333));
+  EXPECT_EQ(260, server.get_time());
+  EXPECT_EQ(hashes[260], server.get_world()->get_state_hash());
+
+  // the game continues the same way as the first time
+  std::map<int, uint64_t> replayed;
+  run(server, &buffer, 700, true, &replayed);
+  EXPECT_EQ(hashes[700], replayed[700]);
+
+  // further back than the history reaches
+  ASSERT_TRUE(buffer.rewind(100000));
+  EXPECT_EQ(0, server.get_time());
+  EXPECT_FALSE(buffer.rewind(100000));
+}
+
+TEST(RewindBufferTest, budget_drops_oldest)
+{
+  PingusLevel const plf = load_level();
+
+  // the states only grow while more pingus get released, so the
+  // last one is the largest
+  Server reference(plf, false, 0);
+  run(reference, nullptr, 600, false);
+  size_t const budget = 5 * reference.save_state(false).get_data().size();
+
+  Server server(plf, false, 0);
+
+  // no room for more than the latest snapshot
+  {
+    RewindBuffer buffer(server, 1, 10);
+    run(server, &buffer, 100, false);
+    EXPECT_EQ(100, buffer.get_oldest_time());
+    EXPECT_FALSE(buffer.rewind(50));
+    EXPECT_EQ(100, server.get_time());
+  }
+
+  RewindBuffer buffer(server, budget, 10);
+  run(server, &buffer, 600, false);
+
+  EXPECT_LE(buffer.get_size(), budget);
+  EXPECT_GT(buffer.get_oldest_time(), 100);
+  EXPECT_LT(buffer.get_oldest_time(), 600);
+
+  // rewinding frees the snapshots after the target
+  size_t const size = buffer.get_size();
+  ASSERT_TRUE(buffer.rewind(20));
+  EXPECT_EQ(580, server.get_time());
+  EXPECT_LT(buffer.get_size(), size);
+}
+
+TEST_F(RewindDemoTest, recording_goes_on_after_rewind)
+{
+  PingusLevel const plf = load_level();
+
+  uint64_t hash = 0;
+  {
+    Server server(plf, true, 0);
+    RewindBuffer buffer(server, 64 * 1024 * 1024, 10);
+    run(server, &buffer, 500, true);
+
+    // the diggers sent after 350 must not be in the demo, as the game
+    // goes on differently
+    ASSERT_TRUE(buffer.rewind(150));
+    ASSERT_EQ(350, server.get_time());
+    run(server, &buffer, 700, false);
+
+    hash = server.get_world()->get_state_hash();
+  }
+
+  std::vector<std::filesystem::path> demos;
+  for (auto const& entry : std::filesystem::directory_iterator(m_dir / "demos"))
+  {
+    demos.push_back(entry.path());
+  }
+  ASSERT_EQ(1u, demos.size());
+
+  PingusDemo demo(Pathname(demos[0].string(), Pathname::SYSTEM_PATH));
+  Server replay(plf, false, demo.get_seed());
+
+  ServerEvent event;
+  bool has_event = demo.read_event(event);
+  while (replay.get_time() < 700)
+  {
+    while (has_event && event.time_stamp == replay.get_time())
+    {
+      event.send(&replay);
+      has_event = demo.read_event(event);
+    }
+    replay.update();
+  }
+
+  EXPECT_EQ(-1, replay.get_first_desync());
+  EXPECT_EQ(hash, replay.get_world()->get_state_hash());
+}
+
+/* EOF */
@@ -0,0 +1,154 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+#include "pingus/collision_map.hpp"
+#include "pingus/savestate.hpp"
+
+using namespace pingus;
+
+TEST(SavestateTest, round_trip)
+{
+  Savestate state;
+  {
+    int i = -17;
+    float f = 2.5f;
+    bool b = true;
+    std::string str = "pingu";
+    Vector2f vec(3.0f, -4.0f);
+    std::vector<int> values = { 1, 2, 3 };
+
+    SavestateStream stream = SavestateStream::writer(state);
+    EXPECT_FALSE(stream.is_reading());
+    stream.sync(i);
+    stream.sync(f);
+    stream.sync(b);
+    stream.sync(str);
+    stream.sync(vec);
+    stream.sync_size(values);
+    for (int& value : values)
+      stream.sync(value);
+  }
+
+  int i = 0;
+  float f = 0.0f;
+  bool b = false;
+  std::string str;
+  Vector2f vec;
+  std::vector<int> values;
+
+  SavestateStream stream = SavestateStream::reader(state);
+  EXPECT_TRUE(stream.is_reading());
+  stream.sync(i);
+  stream.sync(f);
+  stream.sync(b);
+  stream.sync(str);
+  stream.sync(vec);
+  stream.sync_size(values);
+  for (int& value : values)
+    stream.sync(value);
+  EXPECT_TRUE(stream.at_end());
+
+  EXPECT_EQ(-17, i);
+  EXPECT_EQ(2.5f, f);
+  EXPECT_TRUE(b);
+  EXPECT_EQ("pingu", str);
+  EXPECT_EQ(3.0f, vec.x());
+  EXPECT_EQ(-4.0f, vec.y());
+  EXPECT_EQ((std::vector<int>{ 1, 2, 3 }), values);
+
+  int past_end = 0;
+  EXPECT_THROW(stream.sync(past_end), std::runtime_error);
+}
+
+TEST(SavestateTest, rejects_broken_sizes)
+{
+  Savestate state;
+  {
+    uint64_t size = 1000000;
+    SavestateStream stream = SavestateStream::writer(state);
+    stream.sync(size);
+  }
+
+  std::vector<int> values;
+  SavestateStream stream = SavestateStream::reader(state);
+  EXPECT_THROW(stream.sync_size(values), std::runtime_error);
+  EXPECT_TRUE(values.empty());
+}
+
+TEST(SavestateTest, collision_map)
+{
+  CollisionMap colmap(23, 31);
+  colmap.fill_rect(Rect(2, 5, 20, 9), Groundtype::GP_GROUND);
+  colmap.fill_rect(Rect(4, 12, 7, 30), Groundtype::GP_SOLID);
+  colmap.put(11, 20, Groundtype::GP_BRIDGE);
+
+  Savestate state;
+  {
+    SavestateStream stream = SavestateStream::writer(state);
+    colmap.sync_state(stream);
+  }
+
+  CollisionMap restored(23, 31);
+  restored.fill_rect(Rect(0, 0, 23, 3), Groundtype::GP_WATER);
+  {
+    SavestateStream stream = SavestateStream::reader(state);
+    restored.sync_state(stream);
+    EXPECT_TRUE(stream.at_end());
+  }
+
+  for (int y = 0; y < colmap.get_height(); ++y)
+  {
+    for (int x = 0; x < colmap.get_width(); ++x)
+    {
+      ASSERT_EQ(colmap.getpixel(x, y), restored.getpixel(x, y));
+    }
+  }
+}
+
+TEST(SavestateTest, reads_from_memory)
+{
+  CollisionMap colmap(17, 9);
+  colmap.fill_rect(Rect(3, 2, 15, 8), Groundtype::GP_GROUND);
+
+  Savestate state;
+  {
+    SavestateStream stream = SavestateStream::writer(state);
+    colmap.sync_state(stream);
+  }
+
+  // as if the state had been written into a file and mapped again
+  std::vector<uint8_t> const data = state.get_data();
+
+  CollisionMap restored(17, 9);
+  {
+    SavestateStream stream = SavestateStream::reader(data.data(), data.size());
+    EXPECT_TRUE(stream.is_reading());
+    restored.sync_state(stream);
+    EXPECT_TRUE(stream.at_end());
+  }
+  EXPECT_EQ(colmap.get_hash(), restored.get_hash());
+
+  CollisionMap truncated(17, 9);
+  SavestateStream stream = SavestateStream::reader(data.data(), data.size() - 1);
+  EXPECT_THROW(truncated.sync_state(stream), std::runtime_error);
+}
+
+/* EOF */
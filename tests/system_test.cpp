@@ -16,6 +16,10 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
 #include "util/system.hpp"
 
 using namespace pingus;
@@ -36,4 +40,30 @@ TEST(SystemTest, normalize_path)
   EXPECT_EQ("../foo/bar", System::normalize_path("../foo/bar/"));
 }
 
+TEST(SystemTest, stamp_tells_quick_writes_apart)
+{
+  std::string const filename = (std::filesystem::temp_directory_path() / "system_test_stamp.txt").string();
+  std::ofstream(filename) << "first";
+
+  System::FileStamp first;
+  ASSERT_TRUE(System::get_stamp(filename, first));
+  EXPECT_EQ(5u, first.size);
+
+  // same size, well within the same second
+  std::ofstream(filename) << "other";
+  std::filesystem::last_write_time(filename, std::filesystem::last_write_time(filename) +
+                                   std::chrono::nanoseconds(1000));
+
+  System::FileStamp second;
+  ASSERT_TRUE(System::get_stamp(filename, second));
+  EXPECT_FALSE(first == second);
+
+  System::FileStamp again;
+  ASSERT_TRUE(System::get_stamp(filename, again));
+  EXPECT_TRUE(second == again);
+
+  std::filesystem::remove(filename);
+  EXPECT_FALSE(System::get_stamp(filename, again));
+}
+
 /* EOF */
@@ -0,0 +1,110 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_PINGUS_TESTS_TEMP_DIR_HPP
+#define HEADER_PINGUS_TESTS_TEMP_DIR_HPP
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "util/pathname.hpp"
+#include "util/system.hpp"
+
+namespace pingus {
+
+/** @return a small level with a complete head and a single exit */
+inline std::string level_text(std::string const& levelname)
+{
+  return
+    "(pingus-level\n"
+    "  (version 3)\n"
+    "  (head\n"
+    "    (levelname \"" + levelname + "\")\n"
+    "    (description \"Save them\")\n"
+    "    (author \"Someone\")\n"
+    "    (levelsize 800 600)\n"
+    "    (time 1000)\n"
+    "    (number-of-pingus 20)\n"
+    "    (number-to-save 10)\n"
+    "    (actions (basher 5) (digger 3)))\n"
+    "  (objects\n"
+    "    (exit (pos 100 200 0) (owner-id 0))))\n";
+}
+
+/** Base for tests that need a directory of their own, it is created
+    empty below the temp directory before every test. Derived fixtures
+    that override SetUp() or TearDown() have to call the ones here. */
+class TempDirTest : public ::testing::Test
+{
+protected:
+  std::filesystem::path m_dir;
+
+private:
+  bool m_userdir_set;
+  std::string m_old_userdir;
+
+protected:
+  TempDirTest(std::string const& name) :
+    m_dir(std::filesystem::temp_directory_path() / name),
+    m_userdir_set(false),
+    m_old_userdir()
+  {}
+
+  void SetUp() override
+  {
+    std::filesystem::remove_all(m_dir);
+    std::filesystem::create_directories(m_dir);
+  }
+
+  void TearDown() override
+  {
+    if (m_userdir_set)
+    {
+      System::set_userdir(m_old_userdir);
+      m_userdir_set = false;
+    }
+  }
+
+  /** Point the userdir to the directory until the end of the test,
+      so that caches and demos don't end up in the real one */
+  void use_as_userdir()
+  {
+    if (!m_userdir_set)
+    {
+      m_old_userdir = System::get_userdir();
+      m_userdir_set = true;
+    }
+    System::set_userdir(m_dir.string());
+  }
+
+  /** Write text to filename inside the directory */
+  Pathname write_level(std::string const& filename, std::string const& text) const
+  {
+    std::filesystem::path const path = m_dir / filename;
+    std::ofstream out(path, std::ios::binary);
+    out << text;
+    return Pathname(path.string(), Pathname::SYSTEM_PATH);
+  }
+};
+
+} // namespace pingus
+
+#endif
+
+/* EOF */
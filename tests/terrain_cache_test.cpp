@@ -0,0 +1,219 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string.h>
+
+#include "engine/display/sprite_description.hpp"
+#include "headless.hpp"
+#include "pingus/collision_map.hpp"
+#include "pingus/ground_map.hpp"
+#include "pingus/pingus_level.hpp"
+#include "pingus/savestate.hpp"
+#include "pingus/terrain_cache.hpp"
+#include "pingus/world.hpp"
+#include "temp_dir.hpp"
+#include "util/hash.hpp"
+#include "util/pathname.hpp"
+#include "util/system.hpp"
+
+using namespace pingus;
+
+namespace {
+
+/** magic, version and payload hash */
+size_t const header_size = 8 + 4 + 8;
+
+std::string read_file(std::string const& filename)
+{
+  std::ifstream in(filename, std::ios::binary);
+  std::ostringstream out;
+  out << in.rdbuf();
+  return out.str();
+}
+
+void write_file(std::string const& filename, std::string const& content)
+{
+  std::ofstream(filename, std::ios::binary) << content;
+}
+
+/** Correct the payload hash after the payload got changed, so that
+    the file gets past the hash check */
+void rehash(std::string& content)
+{
+  uint64_t const hash = hash64(content.data() + header_size, content.size() - header_size);
+  memcpy(content.data() + 12, &hash, sizeof(hash));
+}
+
+class TerrainCacheTest : public TempDirTest
+{
+protected:
+  PingusLevel m_plf;
+  std::string m_filename;
+
+  TerrainCacheTest() :
+    TempDirTest("terrain_cache_test"),
+    m_plf(),
+    m_filename()
+  {}
+
+  void SetUp() override
+  {
+    init_headless();
+
+    TempDirTest::SetUp();
+    use_as_userdir();
+
+    m_plf = PingusLevel("tutorial/digger-tutorial2-grumbel",
+                        Pathname("levels/tutorial/digger-tutorial2-grumbel.pingus", Pathname::DATA_PATH));
+    m_filename = TerrainCache::get_filename(m_plf);
+    ASSERT_FALSE(m_filename.empty());
+  }
+
+  /** Start the level and @return the hash of its colmap */
+  uint64_t start_level()
+  {
+    World world(m_plf, 0);
+    return world.get_colmap()->get_hash();
+  }
+
+  std::unique_ptr<TerrainCache> find()
+  {
+    return TerrainCache::find(m_plf, m_plf.get_size().width(), m_plf.get_size().height());
+  }
+};
+
+} // namespace
+
+TEST_F(TerrainCacheTest, round_trip)
+{
+  uint64_t const drawn = start_level();
+  ASSERT_TRUE(System::exist(m_filename));
+  std::string const content = read_file(m_filename);
+
+  std::unique_ptr<TerrainCache> baked = find();
+  ASSERT_TRUE(baked);
+
+  GroundMap gfx_map(m_plf.get_size().width(), m_plf.get_size().height());
+  baked->adopt(gfx_map);
+  EXPECT_EQ(drawn, gfx_map.get_colmap()->get_hash());
+
+  // the adopted terrain stores to the same bytes it was read from
+  Savestate state;
+  SavestateStream stream = SavestateStream::writer(state);
+  gfx_map.sync_terrain(stream);
+  std::vector<uint8_t> const& data = state.get_data();
+  ASSERT_LT(data.size(), content.size());
+  EXPECT_EQ(0, memcmp(data.data(), content.data() + content.size() - data.size(), data.size()));
+
+  // starting again takes the terrain from the file
+  EXPECT_EQ(drawn, start_level());
+  EXPECT_EQ(content, read_file(m_filename));
+}
+
+TEST_F(TerrainCacheTest, outdated)
+{
+  start_level();
+  ASSERT_TRUE(find());
+
+  // map size
+  EXPECT_FALSE(TerrainCache::find(m_plf, m_plf.get_size().width() + 1, m_plf.get_size().height()));
+
+  // tile size
+  int const tile_size = globals::tile_size;
+  globals::tile_size = tile_size * 2;
+  EXPECT_FALSE(find());
+  globals::tile_size = tile_size;
+
+  // checksum, the bake of another level
+  PingusLevel const other(Pathname("levels/tutorial/basher-tutorial-grumbel.pingus", Pathname::DATA_PATH));
+  std::filesystem::copy_file(m_filename, TerrainCache::get_filename(other));
+  EXPECT_FALSE(TerrainCache::find(other, other.get_size().width(), other.get_size().height()));
+
+  // resource fingerprint, one of the groundpieces got changed
+  std::string const image = Resource::load_sprite_desc("groundpieces/ground/snow/piece7")->filename.get_sys_path();
+  auto const mtime = std::filesystem::last_write_time(image);
+  std::filesystem::last_write_time(image, mtime + std::chrono::seconds(10));
+  bool const changed_found = static_cast<bool>(find());
+  std::filesystem::last_write_time(image, mtime);
+  EXPECT_FALSE(changed_found);
+  EXPECT_TRUE(find());
+
+  // version
+  std::string content = read_file(m_filename);
+  content[8] = static_cast<char>(content[8] + 1);
+  write_file(m_filename, content);
+  EXPECT_FALSE(find());
+}
+
+TEST_F(TerrainCacheTest, corrupt_payload_is_drawn)
+{
+  uint64_t const drawn = start_level();
+  std::string const content = read_file(m_filename);
+
+  // caught by the payload hash
+  std::string broken = content;
+  broken[broken.size() / 2] = static_cast<char>(broken[broken.size() / 2] ^ 0x55);
+  write_file(m_filename, broken);
+  EXPECT_FALSE(find());
+  EXPECT_EQ(drawn, start_level());
+  EXPECT_EQ(content, read_file(m_filename));
+
+  // past the hash, only noticed when the terrain gets adopted
+  broken = content + "trailing";
+  rehash(broken);
+  write_file(m_filename, broken);
+  ASSERT_TRUE(find());
+  EXPECT_EQ(drawn, start_level());
+  EXPECT_EQ(content, read_file(m_filename));
+}
+
+TEST_F(TerrainCacheTest, outdated_bakes_are_pruned)
+{
+  start_level();
+  std::string const dir = System::get_cachedir() + "terrain/";
+  std::string const name = System::basename(m_filename);
+  std::string const checksum = m_plf.get_checksum();
+  std::string const tail = "-" + std::to_string(globals::tile_size) + ".bake";
+
+  // the key of the level comes first, the checksum second
+  std::string const key = name.substr(0, 16);
+  ASSERT_EQ(key + "-" + checksum + tail, name);
+
+  // an older version of the same level, a bake from before the key
+  // was part of the name and the bake of another level
+  std::string const older  = dir + key + "-0123456789abcdef" + tail;
+  std::string const legacy = dir + checksum + tail;
+  std::string const other  = dir + "fedcba9876543210-0123456789abcdef" + tail;
+  write_file(older, "older");
+  write_file(legacy, "legacy");
+  write_file(other, "other");
+
+  // baking again prunes the outdated ones
+  std::filesystem::remove(m_filename);
+  start_level();
+  EXPECT_TRUE(System::exist(m_filename));
+  EXPECT_FALSE(System::exist(older));
+  EXPECT_FALSE(System::exist(legacy));
+  EXPECT_TRUE(System::exist(other));
+}
+
+/* EOF */
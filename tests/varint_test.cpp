@@ -0,0 +1,65 @@
+// Pingus - A free Lemmings clone
+// Copyright (C) 2026 Ingo Ruhnke <grumbel@gmail.com>
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include "util/varint.hpp"
+
+using namespace pingus;
+
+TEST(VarintTest, round_trip)
+{
+  uint64_t const values[] = { 0, 1, 127, 128, 300, 0xffffffffu, UINT64_MAX };
+
+  std::string data;
+  for (uint64_t value : values)
+  {
+    put_varint(data, value);
+  }
+  EXPECT_EQ(1u + 1 + 1 + 2 + 2 + 5 + 10, data.size());
+
+  size_t pos = 0;
+  for (uint64_t value : values)
+  {
+    uint64_t result;
+    ASSERT_TRUE(get_varint(reinterpret_cast<uint8_t const*>(data.data()), data.size(), pos, result));
+    EXPECT_EQ(value, result);
+  }
+  EXPECT_EQ(data.size(), pos);
+}
+
+TEST(VarintTest, truncated)
+{
+  std::string data;
+  put_varint(data, 300);
+
+  size_t pos = 0;
+  uint64_t result;
+  EXPECT_FALSE(get_varint(reinterpret_cast<uint8_t const*>(data.data()), 1, pos, result));
+  EXPECT_EQ(1u, pos);
+}
+
+TEST(VarintTest, too_long)
+{
+  std::string const data(11, '\x80');
+
+  size_t pos = 0;
+  uint64_t result;
+  EXPECT_FALSE(get_varint(reinterpret_cast<uint8_t const*>(data.data()), data.size(), pos, result));
+  EXPECT_LT(pos, data.size());
+}
+
+/* EOF */